@@ -112,3 +112,27 @@ class TestParquet:
         assert len(gdf) == 20642
         assert gdf.index.values.min() == numpy.datetime64('2018-10-17T22:31:17.349347328')
         assert gdf.index.values.max() == numpy.datetime64('2018-10-17T22:31:19.582347520')
+
+    def test_atl03_row_groups(self, init):
+        resource = "ATL03_20181017222812_02950102_005_01.h5"
+        region = sliderule.toregion(os.path.join(TESTDIR, "data/grandmesa.geojson"))
+        parms = {
+            "poly": region["poly"],
+            "srt": icesat2.SRT_LAND,
+            "cnf": icesat2.CNF_SURFACE_HIGH,
+            "ats": 10.0,
+            "cnt": 10,
+            "len": 40.0,
+            "res": 20.0,
+            "output": { "path": "testfile6.parquet", "format": "parquet", "open_on_complete": True } }
+        gdf_serial = icesat2.atl03sp(parms, resources=[resource])
+        os.remove("testfile6.parquet")
+        parms["output"] = { "path": "testfile7.parquet", "format": "parquet", "open_on_complete": True, "row_group_size": 65536, "row_groups_in_flight": 4 }
+        gdf_parallel = icesat2.atl03sp(parms, resources=[resource])
+        os.remove("testfile7.parquet")
+        assert init
+        assert len(gdf_serial) == 20642
+        assert len(gdf_parallel) == len(gdf_serial)
+        assert (gdf_parallel.index.values == gdf_serial.index.values).all()
+        assert (gdf_parallel["segment_id"].values == gdf_serial["segment_id"].values).all()
+        assert (gdf_parallel["height"].values == gdf_serial["height"].values).all()
@@ -49,6 +49,8 @@ const char* ArrowParms::AS_GEO              = "as_geo";
 const char* ArrowParms::ASSET               = "asset";
 const char* ArrowParms::REGION              = "region";
 const char* ArrowParms::CREDENTIALS         = "credentials";
+const char* ArrowParms::ROW_GROUP_SIZE      = "row_group_size";
+const char* ArrowParms::ROW_GROUPS_IN_FLIGHT= "row_groups_in_flight";
 
 const char* ArrowParms::OBJECT_TYPE = "ArrowParms";
 const char* ArrowParms::LUA_META_NAME = "ArrowParms";
@@ -98,7 +100,9 @@ ArrowParms::ArrowParms (lua_State* L, int index):
     open_on_complete    (false),
     as_geo              (true),
     asset_name          (NULL),
-    region              (NULL)
+    region              (NULL),
+    row_group_size      (0),
+    row_groups_in_flight(1)
 {
     /* Populate Object from Lua */
     try
@@ -132,6 +136,20 @@ ArrowParms::ArrowParms (lua_State* L, int index):
             if(field_provided) mlog(DEBUG, "Setting %s to %d", AS_GEO, (int)as_geo);
             lua_pop(L, 1);
 
+            /* Row Group Size */
+            lua_getfield(L, index, ROW_GROUP_SIZE);
+            row_group_size = LuaObject::getLuaInteger(L, -1, true, row_group_size, &field_provided);
+            if(row_group_size < 0) throw RunTimeException(CRITICAL, RTE_ERROR, "Invalid %s: %ld", ROW_GROUP_SIZE, row_group_size);
+            if(field_provided) mlog(DEBUG, "Setting %s to %ld", ROW_GROUP_SIZE, row_group_size);
+            lua_pop(L, 1);
+
+            /* Row Groups in Flight */
+            lua_getfield(L, index, ROW_GROUPS_IN_FLIGHT);
+            row_groups_in_flight = LuaObject::getLuaInteger(L, -1, true, row_groups_in_flight, &field_provided);
+            if(row_groups_in_flight < 1 || row_groups_in_flight > MAX_ROW_GROUPS_IN_FLIGHT) throw RunTimeException(CRITICAL, RTE_ERROR, "Invalid %s: %d, must be between 1 and %d", ROW_GROUPS_IN_FLIGHT, row_groups_in_flight, MAX_ROW_GROUPS_IN_FLIGHT);
+            if(field_provided) mlog(DEBUG, "Setting %s to %d", ROW_GROUPS_IN_FLIGHT, row_groups_in_flight);
+            lua_pop(L, 1);
+
             /* Asset */
             lua_getfield(L, index, ASSET);
             asset_name = StringLib::duplicate(LuaObject::getLuaString(L, -1, true, NULL, &field_provided));
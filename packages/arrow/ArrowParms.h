@@ -83,6 +83,10 @@ class ArrowParms: public LuaObject
         static const char* ASSET;
         static const char* REGION;
         static const char* CREDENTIALS;
+        static const char* ROW_GROUP_SIZE;
+        static const char* ROW_GROUPS_IN_FLIGHT;
+
+        static const int MAX_ROW_GROUPS_IN_FLIGHT = 16;
 
         static const char* OBJECT_TYPE;
         static const char* LUA_META_NAME;
@@ -98,6 +102,8 @@ class ArrowParms: public LuaObject
         bool            as_geo;                         // whether to create a standard geo-based formatted file
         const char*     asset_name;
         const char*     region;
+        long            row_group_size;                 // size in bytes of each row group (0 uses default)
+        int             row_groups_in_flight;           // row groups built concurrently (1 builds them serially)
 
         #ifdef __aws__
         CredentialStore::Credential credentials;
@@ -34,6 +34,7 @@
  ******************************************************************************/
 
 #include <iostream>
+#include <arrow/array.h>
 #include <arrow/builder.h>
 #include <arrow/table.h>
 #include <arrow/io/file.h>
@@ -410,6 +411,76 @@ struct ParquetBuilder::impl
         /* Append Meta String */
         metadata->Append("pandas", pandasstr.c_str());
     }
+
+    /*----------------------------------------------------------------------------
+    * columnType - arrow type of a column built directly from a buffer, NULL otherwise
+    *----------------------------------------------------------------------------*/
+    static shared_ptr<arrow::DataType> columnType (RecordObject::fieldType_t type)
+    {
+        switch(type)
+        {
+            case RecordObject::INT8:    return arrow::int8();
+            case RecordObject::INT16:   return arrow::int16();
+            case RecordObject::INT32:   return arrow::int32();
+            case RecordObject::INT64:   return arrow::int64();
+            case RecordObject::UINT8:   return arrow::uint8();
+            case RecordObject::UINT16:  return arrow::uint16();
+            case RecordObject::UINT32:  return arrow::uint32();
+            case RecordObject::UINT64:  return arrow::uint64();
+            case RecordObject::FLOAT:   return arrow::float32();
+            case RecordObject::DOUBLE:  return arrow::float64();
+            case RecordObject::TIME8:   return arrow::timestamp(arrow::TimeUnit::NANO);
+            default:                    return NULL;
+        }
+    }
+
+    /*----------------------------------------------------------------------------
+    * allocateColumn
+    *----------------------------------------------------------------------------*/
+    static shared_ptr<arrow::Buffer> allocateColumn (int64_t size)
+    {
+        arrow::Result<std::unique_ptr<arrow::Buffer>> result = arrow::AllocateBuffer(size);
+        if(!result.ok()) throw RunTimeException(CRITICAL, RTE_ERROR, "Failed to allocate column of %ld bytes: %s", (long)size, result.status().ToString().c_str());
+        return shared_ptr<arrow::Buffer>(std::move(result).ValueOrDie());
+    }
+
+    /*----------------------------------------------------------------------------
+    * fillColumn - copies rows of a field into a column buffer starting at row
+    *----------------------------------------------------------------------------*/
+    static void fillColumn (arrow::Buffer* buffer, RecordObject* record, const RecordObject::field_t& field, int stride, int row, int rows)
+    {
+        uint8_t* data = buffer->mutable_data();
+        switch(field.type)
+        {
+            case RecordObject::INT8:    record->getValueColumn(field, stride, rows, reinterpret_cast<int8_t*>(data) + row);     break;
+            case RecordObject::INT16:   record->getValueColumn(field, stride, rows, reinterpret_cast<int16_t*>(data) + row);    break;
+            case RecordObject::INT32:   record->getValueColumn(field, stride, rows, reinterpret_cast<int32_t*>(data) + row);    break;
+            case RecordObject::INT64:   record->getValueColumn(field, stride, rows, reinterpret_cast<int64_t*>(data) + row);    break;
+            case RecordObject::UINT8:   record->getValueColumn(field, stride, rows, reinterpret_cast<uint8_t*>(data) + row);    break;
+            case RecordObject::UINT16:  record->getValueColumn(field, stride, rows, reinterpret_cast<uint16_t*>(data) + row);   break;
+            case RecordObject::UINT32:  record->getValueColumn(field, stride, rows, reinterpret_cast<uint32_t*>(data) + row);   break;
+            case RecordObject::UINT64:  record->getValueColumn(field, stride, rows, reinterpret_cast<uint64_t*>(data) + row);   break;
+            case RecordObject::FLOAT:   record->getValueColumn(field, stride, rows, reinterpret_cast<float*>(data) + row);      break;
+            case RecordObject::DOUBLE:  record->getValueColumn(field, stride, rows, reinterpret_cast<double*>(data) + row);     break;
+            case RecordObject::TIME8:   record->getValueColumn(field, stride, rows, reinterpret_cast<int64_t*>(data) + row);    break;
+            default:                    break;
+        }
+    }
+};
+
+/******************************************************************************
+ * ROW GROUP
+ ******************************************************************************/
+
+struct ParquetBuilder::row_group_t
+{
+    Ordering<batch_t>                   batches;
+    int                                 rows;
+    bool                                built;      // set once columns are built (guarded by rowGroupCond)
+    bool                                valid;      // columns were successfully built
+    vector<shared_ptr<arrow::Array>>    columns;
+
+    row_group_t(void): rows(0), built(false), valid(false) {}
 };
 
 /******************************************************************************
@@ -501,6 +572,7 @@ ParquetBuilder::ParquetBuilder (lua_State* L, ArrowParms* _parms,
     LuaObject(L, OBJECT_TYPE, LUA_META_NAME, LUA_META_TABLE),
     parms(_parms),
     recType(StringLib::duplicate(rec_type)),
+    recTypeId(RecordObject::getRecordTypeId(rec_type)),
     batchRecType(NULL),
     fieldList(LIST_BLOCK_SIZE),
     geoData(geo)
@@ -524,10 +596,19 @@ ParquetBuilder::ParquetBuilder (lua_State* L, ArrowParms* _parms,
     /* Row Based Parameters */
     batchRowSizeBytes = RecordObject::getRecordDataSize(batchRecType);
     rowSizeBytes = RecordObject::getRecordDataSize(rec_type) + batchRowSizeBytes;
-    maxRowsInGroup = ROW_GROUP_SIZE / rowSizeBytes;
+    long row_group_size = (parms->row_group_size > 0) ? parms->row_group_size : ROW_GROUP_SIZE;
+    maxRowsInGroup = MAX(row_group_size / rowSizeBytes, 1);
+
+    /* Row Group Parameters
+     *  records stay referenced until their row group is written,
+     *  so the input queue must hold every row group in flight */
+    rowGroup = new row_group_t;
+    firstInFlight = 0;
+    numInFlight = 0;
+    maxInFlight = parms->row_groups_in_flight;
 
     /* Initialize Queues */
-    int qdepth = maxRowsInGroup * QUEUE_BUFFER_FACTOR;
+    int qdepth = maxRowsInGroup * (QUEUE_BUFFER_FACTOR + maxInFlight - 1);
     outQ = new Publisher(outq_name, Publisher::defaultFree, qdepth);
     inQ = new Subscriber(inq_name, MsgQ::SUBSCRIBER_OF_CONFIDENCE, qdepth);
 
@@ -546,7 +627,12 @@ ParquetBuilder::ParquetBuilder (lua_State* L, ArrowParms* _parms,
     shared_ptr<parquet::WriterProperties> writer_props = writer_props_builder.build();
 
     /* Create Arrow Writer Properties */
-    auto arrow_writer_props = parquet::ArrowWriterProperties::Builder().store_schema()->build();
+    parquet::ArrowWriterProperties::Builder arrow_writer_props_builder;
+    arrow_writer_props_builder.store_schema();
+    #ifndef APACHE_ARROW_10_COMPAT
+    if(maxInFlight > 1) arrow_writer_props_builder.set_use_threads(true); // encode columns of a row group in parallel
+    #endif
+    shared_ptr<parquet::ArrowWriterProperties> arrow_writer_props = arrow_writer_props_builder.build();
 
     /* Build GeoParquet MetaData */
     auto metadata = pimpl->schema->metadata() ? pimpl->schema->metadata()->Copy() : std::make_shared<arrow::KeyValueMetadata>();
@@ -572,6 +658,27 @@ ParquetBuilder::ParquetBuilder (lua_State* L, ArrowParms* _parms,
         else mlog(CRITICAL, "Failed to open parquet writer: %s", result.status().ToString().c_str());
     #endif
 
+    /* Start Row Group Workers */
+    workersActive = true;
+    if(maxInFlight > 1)
+    {
+        rowGroupPub = new Publisher(NULL);
+        rowGroupSub = new Subscriber(*rowGroupPub);
+        numRowGroupWorkers = maxInFlight;
+        rowGroupWorkers = new Thread* [numRowGroupWorkers];
+        for(int i = 0; i < numRowGroupWorkers; i++)
+        {
+            rowGroupWorkers[i] = new Thread(rowGroupThread, this);
+        }
+    }
+    else
+    {
+        rowGroupPub = NULL;
+        rowGroupSub = NULL;
+        numRowGroupWorkers = 0;
+        rowGroupWorkers = NULL;
+    }
+
     /* Start Builder Thread */
     active = true;
     builderPid = new Thread(builderThread, this);
@@ -584,6 +691,15 @@ ParquetBuilder::~ParquetBuilder(void)
 {
     active = false;
     delete builderPid;
+    workersActive = false;
+    for(int i = 0; i < numRowGroupWorkers; i++)
+    {
+        delete rowGroupWorkers[i];
+    }
+    delete [] rowGroupWorkers;
+    delete rowGroupSub;
+    delete rowGroupPub;
+    delete rowGroup;
     parms->releaseLuaObject();
     delete [] fileName;
     delete [] recType;
@@ -604,7 +720,6 @@ ParquetBuilder::~ParquetBuilder(void)
 void* ParquetBuilder::builderThread(void* parm)
 {
     ParquetBuilder* builder = static_cast<ParquetBuilder*>(parm);
-    int row_cnt = 0;
 
     /* Early Exit on No Writer */
     if(!builder->pimpl->parquetWriter)
@@ -629,7 +744,10 @@ void* ParquetBuilder::builderThread(void* parm)
             {
                 /* Get Record and Match to Type being Processed */
                 RecordInterface* record = new RecordInterface((unsigned char*)ref.data, ref.size);
-                if(!StringLib::match(record->getRecordType(), builder->recType))
+                bool is_rec_type = (builder->recTypeId != RecordObject::INVALID_TYPE_ID) ?
+                                   (record->getRecordTypeId() == builder->recTypeId) :
+                                   StringLib::match(record->getRecordType(), builder->recType);
+                if(!is_rec_type)
                 {
                     delete record;
                     builder->outQ->postCopy(ref.data, ref.size);
@@ -657,13 +775,13 @@ void* ParquetBuilder::builderThread(void* parm)
                     .rows = num_rows
                 };
 
-                /* Add Batch to Ordering */
-                builder->recordBatch.add(row_cnt, batch);
-                row_cnt += num_rows;
-                if(row_cnt >= builder->maxRowsInGroup)
+                /* Add Batch to Row Group */
+                row_group_t* group = builder->rowGroup;
+                group->batches.add(group->rows, batch);
+                group->rows += num_rows;
+                if(group->rows >= builder->maxRowsInGroup)
                 {
-                    builder->processRecordBatch(row_cnt);
-                    row_cnt = 0;
+                    builder->submitRowGroup();
                 }
             }
             else
@@ -683,7 +801,12 @@ void* ParquetBuilder::builderThread(void* parm)
     }
 
     /* Process Remaining Records */
-    builder->processRecordBatch(row_cnt);
+    builder->submitRowGroup();
+    while(builder->numInFlight > 0)
+    {
+        builder->commitRowGroup();
+    }
+    builder->workersActive = false;
 
     /* Close Parquet Writer */
     (void)builder->pimpl->parquetWriter->Close();
@@ -723,427 +846,222 @@ void* ParquetBuilder::builderThread(void* parm)
 }
 
 /*----------------------------------------------------------------------------
- * processRecordBatch
+ * rowGroupThread
  *----------------------------------------------------------------------------*/
-void ParquetBuilder::processRecordBatch (int num_rows)
+void* ParquetBuilder::rowGroupThread(void* parm)
 {
-    batch_t batch;
+    ParquetBuilder* builder = static_cast<ParquetBuilder*>(parm);
 
-    /* Start Trace */
-    uint32_t parent_trace_id = EventLib::grabId();
-    uint32_t trace_id = start_trace(INFO, parent_trace_id, "process_batch", "{\"num_rows\": %d}", num_rows);
+    /* Inherit Trace */
+    EventLib::stashId(builder->traceId);
 
-    /* Loop Through Fields in Schema */
-    vector<shared_ptr<arrow::Array>> columns;
-    for(int i = 0; i < fieldIterator->length; i++)
+    /* Build Row Groups */
+    while(builder->workersActive)
     {
-        uint32_t field_trace_id = start_trace(INFO, trace_id, "append_field", "{\"field\": %d}", i);
-        RecordObject::field_t field = (*fieldIterator)[i];
-        shared_ptr<arrow::Array> column;
-
-        /* Loop Through Each Row */
-        switch(field.type)
+        row_group_t* group = NULL;
+        int recv_status = builder->rowGroupSub->receiveCopy(&group, sizeof(group), SYS_TIMEOUT);
+        if(recv_status > 0)
         {
-            case RecordObject::DOUBLE:
-            {
-                arrow::DoubleBuilder builder;
-                (void)builder.Reserve(num_rows);
-                unsigned long key = recordBatch.first(&batch);
-                while(key != (unsigned long)INVALID_KEY)
-                {
-                    if(field.flags & RecordObject::BATCH)
-                    {
-                        int32_t starting_offset = field.offset;
-                        for(int row = 0; row < batch.rows; row++)
-                        {
-                            builder.UnsafeAppend((double)batch.record->getValueReal(field));
-                            field.offset += batchRowSizeBytes * 8;
-                        }
-                        field.offset = starting_offset;
-                    }
-                    else // non-batch field
-                    {
-                        double value = (double)batch.record->getValueReal(field);
-                        for(int row = 0; row < batch.rows; row++)
-                        {
-                            builder.UnsafeAppend(value);
-                        }
-                    }
-                    key = recordBatch.next(&batch);
-                }
-                (void)builder.Finish(&column);
-                break;
-            }
+            builder->buildRowGroup(group);
 
-            case RecordObject::FLOAT:
+            /* Signal Row Group Ready to be Written */
+            builder->rowGroupCond.lock();
             {
-                arrow::FloatBuilder builder;
-                (void)builder.Reserve(num_rows);
-                unsigned long key = recordBatch.first(&batch);
-                while(key != (unsigned long)INVALID_KEY)
-                {
-                    if(field.flags & RecordObject::BATCH)
-                    {
-                        int32_t starting_offset = field.offset;
-                        for(int row = 0; row < batch.rows; row++)
-                        {
-                            builder.UnsafeAppend((float)batch.record->getValueReal(field));
-                            field.offset += batchRowSizeBytes * 8;
-                        }
-                        field.offset = starting_offset;
-                    }
-                    else // non-batch field
-                    {
-                        float value = (float)batch.record->getValueReal(field);
-                        for(int row = 0; row < batch.rows; row++)
-                        {
-                            builder.UnsafeAppend(value);
-                        }
-                    }
-                    key = recordBatch.next(&batch);
-                }
-                (void)builder.Finish(&column);
-                break;
+                group->built = true;
+                builder->rowGroupCond.signal();
             }
+            builder->rowGroupCond.unlock();
+        }
+        else if(recv_status != MsgQ::STATE_TIMEOUT)
+        {
+            mlog(CRITICAL, "Failed to receive row group in %s with error %d", builder->fileName, recv_status);
+            break;
+        }
+    }
 
-            case RecordObject::INT8:
-            {
-                arrow::Int8Builder builder;
-                (void)builder.Reserve(num_rows);
-                unsigned long key = recordBatch.first(&batch);
-                while(key != (unsigned long)INVALID_KEY)
-                {
-                    if(field.flags & RecordObject::BATCH)
-                    {
-                        int32_t starting_offset = field.offset;
-                        for(int row = 0; row < batch.rows; row++)
-                        {
-                            builder.UnsafeAppend((int8_t)batch.record->getValueInteger(field));
-                            field.offset += batchRowSizeBytes * 8;
-                        }
-                        field.offset = starting_offset;
-                    }
-                    else // non-batch field
-                    {
-                        int8_t value = (int8_t)batch.record->getValueInteger(field);
-                        for(int row = 0; row < batch.rows; row++)
-                        {
-                            builder.UnsafeAppend(value);
-                        }
-                    }
-                    key = recordBatch.next(&batch);
-                }
-                (void)builder.Finish(&column);
-                break;
-            }
+    return NULL;
+}
 
-            case RecordObject::INT16:
-            {
-                arrow::Int16Builder builder;
-                (void)builder.Reserve(num_rows);
-                unsigned long key = recordBatch.first(&batch);
-                while(key != (unsigned long)INVALID_KEY)
-                {
-                    if(field.flags & RecordObject::BATCH)
-                    {
-                        int32_t starting_offset = field.offset;
-                        for(int row = 0; row < batch.rows; row++)
-                        {
-                            builder.UnsafeAppend((int16_t)batch.record->getValueInteger(field));
-                            field.offset += batchRowSizeBytes * 8;
-                        }
-                        field.offset = starting_offset;
-                    }
-                    else // non-batch field
-                    {
-                        int16_t value = (int16_t)batch.record->getValueInteger(field);
-                        for(int row = 0; row < batch.rows; row++)
-                        {
-                            builder.UnsafeAppend(value);
-                        }
-                    }
-                    key = recordBatch.next(&batch);
-                }
-                (void)builder.Finish(&column);
-                break;
-            }
+/*----------------------------------------------------------------------------
+ * submitRowGroup
+ *
+ *  hands off the row group being accumulated and starts a new one; when
+ *  row groups are built serially it is built and written immediately,
+ *  otherwise it is built by a worker and written in order by commitRowGroup
+ *----------------------------------------------------------------------------*/
+void ParquetBuilder::submitRowGroup (void)
+{
+    row_group_t* group = rowGroup;
+    rowGroup = new row_group_t;
 
-            case RecordObject::INT32:
-            {
-                arrow::Int32Builder builder;
-                (void)builder.Reserve(num_rows);
-                unsigned long key = recordBatch.first(&batch);
-                while(key != (unsigned long)INVALID_KEY)
-                {
-                    if(field.flags & RecordObject::BATCH)
-                    {
-                        int32_t starting_offset = field.offset;
-                        for(int row = 0; row < batch.rows; row++)
-                        {
-                            builder.UnsafeAppend((int32_t)batch.record->getValueInteger(field));
-                            field.offset += batchRowSizeBytes * 8;
-                        }
-                        field.offset = starting_offset;
-                    }
-                    else // non-batch field
-                    {
-                        int32_t value = (int32_t)batch.record->getValueInteger(field);
-                        for(int row = 0; row < batch.rows; row++)
-                        {
-                            builder.UnsafeAppend(value);
-                        }
-                    }
-                    key = recordBatch.next(&batch);
-                }
-                (void)builder.Finish(&column);
-                break;
-            }
+    /* Serial */
+    if(numRowGroupWorkers == 0)
+    {
+        buildRowGroup(group);
+        writeRowGroup(group);
+        return;
+    }
 
-            case RecordObject::INT64:
-            {
-                arrow::Int64Builder builder;
-                (void)builder.Reserve(num_rows);
-                unsigned long key = recordBatch.first(&batch);
-                while(key != (unsigned long)INVALID_KEY)
-                {
-                    if(field.flags & RecordObject::BATCH)
-                    {
-                        int32_t starting_offset = field.offset;
-                        for(int row = 0; row < batch.rows; row++)
-                        {
-                            builder.UnsafeAppend((int64_t)batch.record->getValueInteger(field));
-                            field.offset += batchRowSizeBytes * 8;
-                        }
-                        field.offset = starting_offset;
-                    }
-                    else // non-batch field
-                    {
-                        int64_t value = (int64_t)batch.record->getValueInteger(field);
-                        for(int row = 0; row < batch.rows; row++)
-                        {
-                            builder.UnsafeAppend(value);
-                        }
-                    }
-                    key = recordBatch.next(&batch);
-                }
-                (void)builder.Finish(&column);
-                break;
-            }
+    /* Drop Empty Row Groups */
+    if(group->rows == 0)
+    {
+        delete group;
+        return;
+    }
 
-            case RecordObject::UINT8:
+    /* Wait for Room */
+    while(numInFlight >= maxInFlight)
+    {
+        commitRowGroup();
+    }
+
+    /* Hand Off to Workers */
+    rowGroupsInFlight[(firstInFlight + numInFlight) % ArrowParms::MAX_ROW_GROUPS_IN_FLIGHT] = group;
+    numInFlight++;
+    int post_status = rowGroupPub->postCopy(&group, sizeof(group), IO_PEND);
+    if(post_status <= 0)
+    {
+        /* Build Locally */
+        mlog(ERROR, "Failed to post row group for %s: %d", fileName, post_status);
+        buildRowGroup(group);
+        rowGroupCond.lock();
+        {
+            group->built = true;
+        }
+        rowGroupCond.unlock();
+    }
+}
+
+/*----------------------------------------------------------------------------
+ * commitRowGroup
+ *
+ *  waits for the oldest row group in flight to be built and writes it
+ *----------------------------------------------------------------------------*/
+void ParquetBuilder::commitRowGroup (void)
+{
+    row_group_t* group = rowGroupsInFlight[firstInFlight];
+
+    /* Wait for Row Group to be Built */
+    rowGroupCond.lock();
+    {
+        while(!group->built)
+        {
+            rowGroupCond.wait(0, SYS_TIMEOUT);
+        }
+    }
+    rowGroupCond.unlock();
+
+    /* Remove from Row Groups in Flight */
+    firstInFlight = (firstInFlight + 1) % ArrowParms::MAX_ROW_GROUPS_IN_FLIGHT;
+    numInFlight--;
+
+    /* Write Row Group */
+    writeRowGroup(group);
+}
+
+/*----------------------------------------------------------------------------
+ * buildRowGroup
+ *----------------------------------------------------------------------------*/
+void ParquetBuilder::buildRowGroup (row_group_t* group)
+{
+    batch_t batch;
+
+    /* Start Trace */
+    uint32_t parent_trace_id = EventLib::grabId();
+    uint32_t trace_id = start_trace(INFO, parent_trace_id, "build_row_group", "{\"num_rows\": %d}", group->rows);
+
+    /* Build Columns */
+    try
+    {
+        /* Allocate Columns */
+        int num_fields = fieldIterator->length;
+        vector<shared_ptr<arrow::Buffer>> buffers(num_fields);
+        vector<unique_ptr<arrow::StringBuilder>> string_builders(num_fields);
+        for(int i = 0; i < num_fields; i++)
+        {
+            const RecordObject::field_t& field = (*fieldIterator)[i];
+            if(field.type == RecordObject::STRING)
             {
-                arrow::UInt8Builder builder;
-                (void)builder.Reserve(num_rows);
-                unsigned long key = recordBatch.first(&batch);
-                while(key != (unsigned long)INVALID_KEY)
-                {
-                    if(field.flags & RecordObject::BATCH)
-                    {
-                        int32_t starting_offset = field.offset;
-                        for(int row = 0; row < batch.rows; row++)
-                        {
-                            builder.UnsafeAppend((uint8_t)batch.record->getValueInteger(field));
-                            field.offset += batchRowSizeBytes * 8;
-                        }
-                        field.offset = starting_offset;
-                    }
-                    else // non-batch field
-                    {
-                        uint8_t value = (uint8_t)batch.record->getValueInteger(field);
-                        for(int row = 0; row < batch.rows; row++)
-                        {
-                            builder.UnsafeAppend(value);
-                        }
-                    }
-                    key = recordBatch.next(&batch);
-                }
-                (void)builder.Finish(&column);
-                break;
+                string_builders[i] = unique_ptr<arrow::StringBuilder>(new arrow::StringBuilder());
+                (void)string_builders[i]->Reserve(group->rows);
             }
-
-            case RecordObject::UINT16:
+            else if(impl::columnType(field.type))
             {
-                arrow::UInt16Builder builder;
-                (void)builder.Reserve(num_rows);
-                unsigned long key = recordBatch.first(&batch);
-                while(key != (unsigned long)INVALID_KEY)
-                {
-                    if(field.flags & RecordObject::BATCH)
-                    {
-                        int32_t starting_offset = field.offset;
-                        for(int row = 0; row < batch.rows; row++)
-                        {
-                            builder.UnsafeAppend((uint16_t)batch.record->getValueInteger(field));
-                            field.offset += batchRowSizeBytes * 8;
-                        }
-                        field.offset = starting_offset;
-                    }
-                    else // non-batch field
-                    {
-                        uint16_t value = (uint16_t)batch.record->getValueInteger(field);
-                        for(int row = 0; row < batch.rows; row++)
-                        {
-                            builder.UnsafeAppend(value);
-                        }
-                    }
-                    key = recordBatch.next(&batch);
-                }
-                (void)builder.Finish(&column);
-                break;
+                buffers[i] = impl::allocateColumn((int64_t)group->rows * RecordObject::FIELD_TYPE_BYTES[field.type]);
             }
+        }
 
-            case RecordObject::UINT32:
+        /* Allocate Geometry Coordinates (if GeoParquet) */
+        vector<double> x_values(geoData.as_geo ? group->rows : 0);
+        vector<double> y_values(geoData.as_geo ? group->rows : 0);
+
+        /* Fill Columns - single pass through batch records */
+        uint32_t fill_trace_id = start_trace(INFO, trace_id, "fill_columns", "{\"num_fields\": %d}", num_fields);
+        int row = 0;
+        unsigned long key = group->batches.first(&batch);
+        while(key != (unsigned long)INVALID_KEY)
+        {
+            for(int i = 0; i < num_fields; i++)
             {
-                arrow::UInt32Builder builder;
-                (void)builder.Reserve(num_rows);
-                unsigned long key = recordBatch.first(&batch);
-                while(key != (unsigned long)INVALID_KEY)
+                RecordObject::field_t field = (*fieldIterator)[i];
+                int stride = (field.flags & RecordObject::BATCH) ? batchRowSizeBytes : 0; // non-batch fields repeat
+                if(buffers[i])
                 {
-                    if(field.flags & RecordObject::BATCH)
-                    {
-                        int32_t starting_offset = field.offset;
-                        for(int row = 0; row < batch.rows; row++)
-                        {
-                            builder.UnsafeAppend((uint32_t)batch.record->getValueInteger(field));
-                            field.offset += batchRowSizeBytes * 8;
-                        }
-                        field.offset = starting_offset;
-                    }
-                    else // non-batch field
-                    {
-                        uint32_t value = (uint32_t)batch.record->getValueInteger(field);
-                        for(int row = 0; row < batch.rows; row++)
-                        {
-                            builder.UnsafeAppend(value);
-                        }
-                    }
-                    key = recordBatch.next(&batch);
+                    impl::fillColumn(buffers[i].get(), batch.record, field, stride, row, batch.rows);
                 }
-                (void)builder.Finish(&column);
-                break;
-            }
-
-            case RecordObject::UINT64:
-            {
-                arrow::UInt64Builder builder;
-                (void)builder.Reserve(num_rows);
-                unsigned long key = recordBatch.first(&batch);
-                while(key != (unsigned long)INVALID_KEY)
+                else if(string_builders[i])
                 {
-                    if(field.flags & RecordObject::BATCH)
-                    {
-                        int32_t starting_offset = field.offset;
-                        for(int row = 0; row < batch.rows; row++)
-                        {
-                            builder.UnsafeAppend((uint64_t)batch.record->getValueInteger(field));
-                            field.offset += batchRowSizeBytes * 8;
-                        }
-                        field.offset = starting_offset;
-                    }
-                    else // non-batch field
+                    for(int r = 0; r < batch.rows; r++)
                     {
-                        uint64_t value = (uint64_t)batch.record->getValueInteger(field);
-                        for(int row = 0; row < batch.rows; row++)
-                        {
-                            builder.UnsafeAppend(value);
-                        }
+                        const char* str = batch.record->getValueText(field);
+                        string_builders[i]->UnsafeAppend(str, StringLib::size(str));
+                        field.offset += stride * 8;
                     }
-                    key = recordBatch.next(&batch);
                 }
-                (void)builder.Finish(&column);
-                break;
             }
 
-            case RecordObject::TIME8:
+            if(geoData.as_geo)
             {
-                arrow::TimestampBuilder builder(arrow::timestamp(arrow::TimeUnit::NANO), arrow::default_memory_pool());
-                (void)builder.Reserve(num_rows);
-                unsigned long key = recordBatch.first(&batch);
-                while(key != (unsigned long)INVALID_KEY)
-                {
-                    if(field.flags & RecordObject::BATCH)
-                    {
-                        int32_t starting_offset = field.offset;
-                        for(int row = 0; row < batch.rows; row++)
-                        {
-                            builder.UnsafeAppend((int64_t)batch.record->getValueInteger(field));
-                            field.offset += batchRowSizeBytes * 8;
-                        }
-                        field.offset = starting_offset;
-                    }
-                    else // non-batch field
-                    {
-                        int64_t value = (int64_t)batch.record->getValueInteger(field);
-                        for(int row = 0; row < batch.rows; row++)
-                        {
-                            builder.UnsafeAppend(value);
-                        }
-                    }
-                    key = recordBatch.next(&batch);
-                }
-                (void)builder.Finish(&column);
-                break;
+                int x_stride = (geoData.x_field.flags & RecordObject::BATCH) ? batchRowSizeBytes : 0;
+                int y_stride = (geoData.y_field.flags & RecordObject::BATCH) ? batchRowSizeBytes : 0;
+                batch.record->getValueColumn(geoData.x_field, x_stride, batch.rows, &x_values[row]);
+                batch.record->getValueColumn(geoData.y_field, y_stride, batch.rows, &y_values[row]);
             }
 
-            case RecordObject::STRING:
+            row += batch.rows;
+            key = group->batches.next(&batch);
+        }
+        stop_trace(INFO, fill_trace_id);
+
+        /* Build Columns */
+        for(int i = 0; i < num_fields; i++)
+        {
+            const RecordObject::field_t& field = (*fieldIterator)[i];
+            shared_ptr<arrow::Array> column;
+            if(buffers[i])
             {
-                arrow::StringBuilder builder;
-                (void)builder.Reserve(num_rows);
-                unsigned long key = recordBatch.first(&batch);
-                while(key != (unsigned long)INVALID_KEY)
-                {
-                    if(field.flags & RecordObject::BATCH)
-                    {
-                        int32_t starting_offset = field.offset;
-                        for(int row = 0; row < batch.rows; row++)
-                        {
-                            const char* str = batch.record->getValueText(field);
-                            builder.UnsafeAppend(str, StringLib::size(str));
-                            field.offset += batchRowSizeBytes * 8;
-                        }
-                        field.offset = starting_offset;
-                    }
-                    else // non-batch field
-                    {
-                        const char* str = batch.record->getValueText(field);
-                        for(int row = 0; row < batch.rows; row++)
-                        {
-                            builder.UnsafeAppend(str, StringLib::size(str));
-                        }
-                    }
-                    key = recordBatch.next(&batch);
-                }
-                (void)builder.Finish(&column);
-                break;
+                shared_ptr<arrow::Buffer> validity; // no nulls
+                shared_ptr<arrow::ArrayData> data = arrow::ArrayData::Make(impl::columnType(field.type), group->rows, {validity, buffers[i]}, 0);
+                column = arrow::MakeArray(data);
             }
-
-            default:
+            else if(string_builders[i])
             {
-                break;
+                (void)string_builders[i]->Finish(&column);
             }
+            group->columns.push_back(column);
         }
 
-        /* Add Column to Columns */
-        columns.push_back(column);
-        stop_trace(INFO, field_trace_id);
-    }
-
-    /* Add Geometry Column (if GeoParquet) */
-    if(geoData.as_geo)
-    {
-        uint32_t geo_trace_id = start_trace(INFO, trace_id, "geo_column", "%s", "{}");
-        RecordObject::field_t x_field = geoData.x_field;
-        RecordObject::field_t y_field = geoData.y_field;
-        shared_ptr<arrow::Array> column;
-        arrow::BinaryBuilder builder;
-        (void)builder.Reserve(num_rows);
-        (void)builder.ReserveData(num_rows * sizeof(wkbpoint_t));
-        unsigned long key = recordBatch.first(&batch);
-        while(key != (unsigned long)INVALID_KEY)
+        /* Add Geometry Column (if GeoParquet) */
+        if(geoData.as_geo)
         {
-            int32_t starting_x_offset = x_field.offset;
-            int32_t starting_y_offset = y_field.offset;
-            for(int row = 0; row < batch.rows; row++)
+            uint32_t geo_trace_id = start_trace(INFO, trace_id, "geo_column", "%s", "{}");
+
+            /* Build WKB Points and Offsets */
+            shared_ptr<arrow::Buffer> offsets = impl::allocateColumn((int64_t)(group->rows + 1) * sizeof(int32_t));
+            shared_ptr<arrow::Buffer> points = impl::allocateColumn((int64_t)group->rows * sizeof(wkbpoint_t));
+            int32_t* offset_data = reinterpret_cast<int32_t*>(offsets->mutable_data());
+            wkbpoint_t* point_data = reinterpret_cast<wkbpoint_t*>(points->mutable_data());
+            for(int r = 0; r < group->rows; r++)
             {
                 wkbpoint_t point = {
                     #ifdef __be__
@@ -1152,42 +1070,84 @@ void ParquetBuilder::processRecordBatch (int num_rows)
                     .byteOrder = 1,
                     #endif
                     .wkbType = 1,
-                    .x = batch.record->getValueReal(x_field),
-                    .y = batch.record->getValueReal(y_field)
+                    .x = x_values[r],
+                    .y = y_values[r]
                 };
-                (void)builder.UnsafeAppend((uint8_t*)&point, sizeof(wkbpoint_t));
-                if(x_field.flags & RecordObject::BATCH) x_field.offset += batchRowSizeBytes * 8;
-                if(x_field.flags & RecordObject::BATCH) y_field.offset += batchRowSizeBytes * 8;
+                memcpy(&point_data[r], &point, sizeof(wkbpoint_t)); // points are packed
+                offset_data[r] = r * sizeof(wkbpoint_t);
             }
-            x_field.offset = starting_x_offset;
-            y_field.offset = starting_y_offset;
-            key = recordBatch.next(&batch);
+            offset_data[group->rows] = group->rows * sizeof(wkbpoint_t);
+
+            /* Add Column */
+            group->columns.push_back(make_shared<arrow::BinaryArray>(group->rows, offsets, points));
+            stop_trace(INFO, geo_trace_id);
         }
-        (void)builder.Finish(&column);
-        columns.push_back(column);
-        stop_trace(INFO, geo_trace_id);
+
+        group->valid = true;
     }
+    catch(const RunTimeException& e)
+    {
+        mlog(e.level(), "Failed to build %d rows for %s: %s", group->rows, fileName, e.what());
+        group->columns.clear();
+    }
+    catch(const std::exception& e)
+    {
+        mlog(CRITICAL, "Failed to build %d rows for %s: %s", group->rows, fileName, e.what());
+        group->columns.clear();
+    }
+    catch(...)
+    {
+        mlog(CRITICAL, "Failed to build %d rows for %s: unknown exception", group->rows, fileName);
+        group->columns.clear();
+    }
+
+    /* Stop Trace */
+    stop_trace(INFO, trace_id);
+}
 
-    /* Build and Write Table */
-    uint32_t write_trace_id = start_trace(INFO, trace_id, "write_table", "%s", "{}");
-    if(pimpl->parquetWriter)
+/*----------------------------------------------------------------------------
+ * writeRowGroup
+ *
+ *  writes the row group to the parquet file, releases its records, and
+ *  frees it; must be called in order from the builder thread
+ *----------------------------------------------------------------------------*/
+void ParquetBuilder::writeRowGroup (row_group_t* group)
+{
+    batch_t batch;
+
+    /* Start Trace */
+    uint32_t parent_trace_id = EventLib::grabId();
+    uint32_t trace_id = start_trace(INFO, parent_trace_id, "write_row_group", "{\"num_rows\": %d}", group->rows);
+
+    /* Write Row Group */
+    if(pimpl->parquetWriter && group->valid)
     {
-        shared_ptr<arrow::Table> table = arrow::Table::Make(pimpl->schema, columns);
-        (void)pimpl->parquetWriter->WriteTable(*table, num_rows);
+        #ifndef APACHE_ARROW_10_COMPAT
+        if(numRowGroupWorkers > 0)
+        {
+            /* Buffered Row Group - columns encoded in parallel */
+            shared_ptr<arrow::RecordBatch> record_batch = arrow::RecordBatch::Make(pimpl->schema, group->rows, group->columns);
+            (void)pimpl->parquetWriter->NewBufferedRowGroup();
+            (void)pimpl->parquetWriter->WriteRecordBatch(*record_batch);
+        }
+        else
+        #endif
+        {
+            /* Table Row Group - only form available to older writers */
+            shared_ptr<arrow::Table> table = arrow::Table::Make(pimpl->schema, group->columns);
+            (void)pimpl->parquetWriter->WriteTable(*table, group->rows);
+        }
     }
-    stop_trace(INFO, write_trace_id);
 
-    /* Clear Record Batch */
-    uint32_t clear_trace_id = start_trace(INFO, trace_id, "clear_batch", "%s", "{}");
-    unsigned long key = recordBatch.first(&batch);
+    /* Release Records */
+    unsigned long key = group->batches.first(&batch);
     while(key != (unsigned long)INVALID_KEY)
     {
         delete batch.record;
         inQ->dereference(batch.ref);
-        key = recordBatch.next(&batch);
+        key = group->batches.next(&batch);
     }
-    recordBatch.clear();
-    stop_trace(INFO, clear_trace_id);
+    delete group;
 
     /* Stop Trace */
     stop_trace(INFO, trace_id);
@@ -134,6 +134,8 @@ class ParquetBuilder: public LuaObject
             int                     rows;
         } batch_t;
 
+        struct row_group_t; // batches of records and the table built from them
+
         /*--------------------------------------------------------------------
          * Data
          *--------------------------------------------------------------------*/
@@ -143,8 +145,19 @@ class ParquetBuilder: public LuaObject
         bool                active;
         Subscriber*         inQ;
         const char*         recType;
+        int                 recTypeId;
         const char*         batchRecType;
-        Ordering<batch_t>   recordBatch;
+        row_group_t*        rowGroup;       // row group being accumulated
+        row_group_t*        rowGroupsInFlight[ArrowParms::MAX_ROW_GROUPS_IN_FLIGHT]; // ring of submitted row groups, in order
+        int                 firstInFlight;
+        int                 numInFlight;
+        int                 maxInFlight;
+        Cond                rowGroupCond;
+        Publisher*          rowGroupPub;
+        Subscriber*         rowGroupSub;
+        Thread**            rowGroupWorkers;
+        int                 numRowGroupWorkers;
+        bool                workersActive;
         field_list_t        fieldList;
         field_iterator_t*   fieldIterator;
         Publisher*          outQ;
@@ -167,7 +180,11 @@ class ParquetBuilder: public LuaObject
                             ~ParquetBuilder         (void);
 
         static void*        builderThread           (void* parm);
-        void                processRecordBatch      (int num_rows);
+        static void*        rowGroupThread          (void* parm);
+        void                submitRowGroup          (void);
+        void                commitRowGroup          (void);
+        void                buildRowGroup           (row_group_t* group);
+        void                writeRowGroup           (row_group_t* group);
         bool                send2S3                 (const char* s3dst);
         bool                send2Client             (void);
 };
@@ -63,14 +63,89 @@ typedef struct {
     long        size;
 } file_data_t;
 
+typedef struct {
+    char*       version;
+    bool        etag;
+} version_data_t;
+
 typedef struct curl_slist* headers_t;
 
+typedef struct {
+    CURL*       handles[S3CurlIODriver::MAX_POOLED_HANDLES];
+    int         num_handles;
+} curl_pool_t;
+
 typedef size_t (*write_cb_t)(void*, size_t, size_t, void*);
 
+/******************************************************************************
+ * LOCAL DATA
+ ******************************************************************************/
+
+static Mutex curlPoolMut;
+static Dictionary<curl_pool_t*> curlPools; // idle handles by host
+
 /******************************************************************************
  * LOCAL FUNCTIONS
  ******************************************************************************/
 
+/*----------------------------------------------------------------------------
+ * acquireHandle
+ *
+ *  idle handles keep their connections to the host open, so a handle taken
+ *  from the pool avoids the TCP and TLS setup of a fresh handle
+ *----------------------------------------------------------------------------*/
+static CURL* acquireHandle (const char* host)
+{
+    CURL* curl = NULL;
+
+    curlPoolMut.lock();
+    {
+        curl_pool_t* pool = NULL;
+        if(curlPools.find(host, &pool) && (pool->num_handles > 0))
+        {
+            curl = pool->handles[--pool->num_handles];
+        }
+    }
+    curlPoolMut.unlock();
+
+    if(!curl) curl = curl_easy_init();
+
+    return curl;
+}
+
+/*----------------------------------------------------------------------------
+ * releaseHandle
+ *
+ *  options are reset so the pooled handle holds no references to the
+ *  request that used it; connections and caches survive the reset
+ *----------------------------------------------------------------------------*/
+static void releaseHandle (const char* host, CURL* curl)
+{
+    bool pooled = false;
+
+    curl_easy_reset(curl);
+
+    curlPoolMut.lock();
+    {
+        curl_pool_t* pool = NULL;
+        if(!curlPools.find(host, &pool))
+        {
+            pool = new curl_pool_t;
+            pool->num_handles = 0;
+            curlPools.add(host, pool);
+        }
+
+        if(pool->num_handles < S3CurlIODriver::MAX_POOLED_HANDLES)
+        {
+            pool->handles[pool->num_handles++] = curl;
+            pooled = true;
+        }
+    }
+    curlPoolMut.unlock();
+
+    if(!pooled) curl_easy_cleanup(curl);
+}
+
 /*----------------------------------------------------------------------------
  * sha256hash
  *----------------------------------------------------------------------------*/
@@ -144,10 +219,41 @@ static size_t curlReadFile(void* buffer, size_t size, size_t nmemb, void *userp)
     return bytes_read;
 }
 
+/*----------------------------------------------------------------------------
+ * curlHeaderVersion
+ *
+ *  keeps the ETag of the object, or its Last-Modified time if there is no ETag
+ *----------------------------------------------------------------------------*/
+static size_t curlHeaderVersion(char* buffer, size_t size, size_t nitems, void *userp)
+{
+    version_data_t* data = (version_data_t*)userp;
+    size_t hdr_size = size * nitems;
+
+    /* Match Header */
+    const char* name = NULL;
+    if(hdr_size > 5 && strncasecmp(buffer, "ETag:", 5) == 0) name = "ETag:";
+    else if(hdr_size > 14 && !data->etag && strncasecmp(buffer, "Last-Modified:", 14) == 0) name = "Last-Modified:";
+
+    /* Copy Trimmed Value */
+    if(name)
+    {
+        size_t start = StringLib::size(name);
+        size_t end = hdr_size;
+        while(start < end && isspace(buffer[start])) start++;
+        while(end > start && isspace(buffer[end - 1])) end--;
+        size_t len = MIN(end - start, (size_t)(Asset::IODriver::MAX_VERSION_SIZE - 1));
+        memcpy(data->version, &buffer[start], len);
+        data->version[len] = '\0';
+        data->etag = (name[0] == 'E');
+    }
+
+    return hdr_size;
+}
+
 /*----------------------------------------------------------------------------
  * buildReadHeadersV2
  *----------------------------------------------------------------------------*/
-static headers_t buildReadHeadersV2 (const char* bucket, const char* key, CredentialStore::Credential* credentials)
+static headers_t buildReadHeadersV2 (const char* bucket, const char* key, CredentialStore::Credential* credentials, const char* method="GET")
 {
     /* Initial HTTP Header List */
     struct curl_slist* headers = NULL;
@@ -166,7 +272,7 @@ static headers_t buildReadHeadersV2 (const char* bucket, const char* key, Creden
         headers = curl_slist_append(headers, securityTokenHeader.c_str());
 
         /* Build Authorization Header */
-        FString stringToSign("GET\n\n\n%s\n%s\n/%s/%s", date.c_str(), securityTokenHeader.c_str(), bucket, key);
+        FString stringToSign("%s\n\n\n%s\n%s\n/%s/%s", method, date.c_str(), securityTokenHeader.c_str(), bucket, key);
         unsigned char hash[EVP_MAX_MD_SIZE];
         unsigned int hash_size = EVP_MAX_MD_SIZE; // set below with actual size
         HMAC(EVP_sha1(), credentials->secretAccessKey, StringLib::size(credentials->secretAccessKey), (unsigned char*)stringToSign.c_str(), stringToSign.size(), hash, &hash_size);
@@ -315,10 +421,10 @@ static headers_t buildWriteHeadersV4 (const char* bucket, const char* key, const
 /*----------------------------------------------------------------------------
  * initializeReadRequest
  *----------------------------------------------------------------------------*/
-static CURL* initializeReadRequest (FString& url, headers_t headers, write_cb_t write_cb, void* write_parm)
+static CURL* initializeReadRequest (const char* host, FString& url, headers_t headers, write_cb_t write_cb, void* write_parm)
 {
     /* Initialize cURL */
-    CURL* curl = curl_easy_init();
+    CURL* curl = acquireHandle(host);
     if(curl)
     {
         /* Set Options */
@@ -382,10 +488,37 @@ const char* S3CurlIODriver::DEFAULT_REGION = "us-west-2";
 const char* S3CurlIODriver::DEFAULT_IDENTITY = "iam-role";
 const char* S3CurlIODriver::CURL_FORMAT = "s3";
 
+int64_t S3CurlIODriver::readaheadSize = S3CurlIODriver::DEFAULT_READAHEAD_SIZE;
+int64_t S3CurlIODriver::coalesceGap = S3CurlIODriver::DEFAULT_COALESCE_GAP;
+bool S3CurlIODriver::asyncReadahead = false;
+
 /******************************************************************************
  * AWS S3 cURL I/O DRIVER CLASS
  ******************************************************************************/
 
+/*----------------------------------------------------------------------------
+ * deinit
+ *----------------------------------------------------------------------------*/
+void S3CurlIODriver::deinit (void)
+{
+    curlPoolMut.lock();
+    {
+        curl_pool_t* pool = NULL;
+        const char* host = curlPools.first(&pool);
+        while(host != NULL)
+        {
+            for(int i = 0; i < pool->num_handles; i++)
+            {
+                curl_easy_cleanup(pool->handles[i]);
+            }
+            delete pool;
+            host = curlPools.next(&pool);
+        }
+        curlPools.clear();
+    }
+    curlPoolMut.unlock();
+}
+
 /*----------------------------------------------------------------------------
  * create
  *----------------------------------------------------------------------------*/
@@ -399,7 +532,230 @@ Asset::IODriver* S3CurlIODriver::create (const Asset* _asset, const char* resour
  *----------------------------------------------------------------------------*/
 int64_t S3CurlIODriver::ioRead (uint8_t* data, int64_t size, uint64_t pos)
 {
-    return get(data, size, pos, ioBucket, ioKey, asset->getRegion(), &latestCredentials);
+    /* Readahead Disabled */
+    if(raSize <= 0)
+    {
+        return get(data, size, pos, ioBucket, ioKey, asset->getRegion(), &latestCredentials);
+    }
+
+    /* Check for Sequential Access */
+    bool sequential = (pos >= raLastEnd) && ((pos - raLastEnd) <= (uint64_t)raGap);
+    raLastEnd = pos + size;
+
+    /* Serve Request from Readahead Window */
+    if(readWindow(data, size, pos))
+    {
+        /* Start Fetching Next Window (a short window ends at the end of the object) */
+        if(raAsync && sequential && (raValid == raSize)) startReadahead(raPos + raValid);
+        return size;
+    }
+
+    /* Read Directly when Not Sequential or Larger than Window */
+    if(!sequential || size >= raSize)
+    {
+        return get(data, size, pos, ioBucket, ioKey, asset->getRegion(), &latestCredentials);
+    }
+
+    /* Coalesce Request with the Data that Follows It */
+    raValid = 0; // invalidate window in case get throws
+    raValid = get(raBuffer, raSize, pos, ioBucket, ioKey, asset->getRegion(), &latestCredentials);
+    raPos = pos;
+
+    /* Copy Request out of Window */
+    int64_t bytes = MIN(size, raValid);
+    memcpy(data, raBuffer, bytes);
+
+    /* Start Fetching Next Window */
+    if(raAsync && (raValid == raSize)) startReadahead(raPos + raValid);
+
+    return bytes;
+}
+
+/*----------------------------------------------------------------------------
+ * readWindow
+ *
+ *  returns true if the request was copied out of the readahead window; a
+ *  background fetch that starts inside the request is waited on and then
+ *  becomes the current window
+ *----------------------------------------------------------------------------*/
+bool S3CurlIODriver::readWindow (uint8_t* data, int64_t size, uint64_t pos)
+{
+    /* Check Current Window */
+    if((pos >= raPos) && ((pos + size) <= (raPos + raValid)))
+    {
+        memcpy(data, &raBuffer[pos - raPos], size);
+        return true;
+    }
+
+    /* Check Background Window */
+    bool pending = false;
+    raCond.lock();
+    if(raNextState != READAHEAD_IDLE)
+    {
+        pending = true;
+        bool in_next = (pos >= raNextPos) && (pos < (raNextPos + raSize));
+
+        /* Wait for Background Fetch
+         *  also waited on when the window is not going to be used
+         *  because the next window's buffer can't be reused until
+         *  the fetch into it completes */
+        while(raNextState == READAHEAD_REQUESTED || raNextState == READAHEAD_FETCHING)
+        {
+            raCond.wait(0, SYS_TIMEOUT);
+        }
+
+        /* Make Next Window Current */
+        if(in_next && (raNextValid > 0))
+        {
+            uint8_t* tmp = raBuffer;
+            raBuffer = raNextBuffer;
+            raNextBuffer = tmp;
+            raPos = raNextPos;
+            raValid = raNextValid;
+        }
+
+        raNextState = READAHEAD_IDLE;
+    }
+    raCond.unlock();
+    if(!pending) return false;
+
+    /* Check New Window */
+    if((pos >= raPos) && ((pos + size) <= (raPos + raValid)))
+    {
+        memcpy(data, &raBuffer[pos - raPos], size);
+        return true;
+    }
+
+    return false;
+}
+
+/*----------------------------------------------------------------------------
+ * startReadahead
+ *----------------------------------------------------------------------------*/
+void S3CurlIODriver::startReadahead (uint64_t pos)
+{
+    raCond.lock();
+    {
+        if(raNextState == READAHEAD_IDLE)
+        {
+            /* Start Background Thread on First Use */
+            if(!raPid)
+            {
+                raActive = true;
+                raPid = new Thread(readaheadThread, this);
+            }
+
+            /* Request Next Window */
+            raNextPos = pos;
+            raNextValid = 0;
+            raNextState = READAHEAD_REQUESTED;
+            raCond.signal();
+        }
+    }
+    raCond.unlock();
+}
+
+/*----------------------------------------------------------------------------
+ * readaheadThread
+ *----------------------------------------------------------------------------*/
+void* S3CurlIODriver::readaheadThread (void* parm)
+{
+    S3CurlIODriver* driver = (S3CurlIODriver*)parm;
+
+    driver->raCond.lock();
+    while(driver->raActive)
+    {
+        if(driver->raNextState == READAHEAD_REQUESTED)
+        {
+            uint64_t pos = driver->raNextPos;
+            driver->raNextState = READAHEAD_FETCHING;
+            driver->raCond.unlock();
+
+            /* Fetch Next Window */
+            int64_t valid = -1;
+            try
+            {
+                valid = get(driver->raNextBuffer, driver->raSize, pos, driver->ioBucket, driver->ioKey, driver->asset->getRegion(), &driver->latestCredentials);
+            }
+            catch(const RunTimeException& e)
+            {
+                mlog(e.level(), "Failed to read ahead %s at %lu: %s", driver->ioKey, (unsigned long)pos, e.what());
+            }
+
+            driver->raCond.lock();
+            driver->raNextValid = valid;
+            driver->raNextState = READAHEAD_COMPLETE;
+            driver->raCond.signal();
+        }
+        else
+        {
+            driver->raCond.wait(0, SYS_TIMEOUT);
+        }
+    }
+    driver->raCond.unlock();
+
+    return NULL;
+}
+
+/*----------------------------------------------------------------------------
+ * ioVersion - ETag of the object (Last-Modified when there is no ETag)
+ *----------------------------------------------------------------------------*/
+const char* S3CurlIODriver::ioVersion (void)
+{
+    /* Bucket-less Drivers are Unable to Tell */
+    if(ioBucket == NULL) return NULL;
+
+    /* Massage Key */
+    const char* key_ptr = ioKey;
+    if(key_ptr[0] == '/') key_ptr++;
+
+    /* Build URL */
+    FString host("s3.%s.amazonaws.com", asset->getRegion());
+    FString url("https://%s/%s/%s", host.c_str(), ioBucket, key_ptr);
+
+    /* Setup Buffer for Header Callback */
+    version[0] = '\0';
+    version_data_t info = {
+        .version = version,
+        .etag = false
+    };
+
+    /* Issue Head Request */
+    bool status = false;
+    struct curl_slist* headers = buildReadHeadersV2(ioBucket, key_ptr, &latestCredentials, "HEAD");
+    CURL* curl = initializeReadRequest(host.c_str(), url, headers, NULL, NULL);
+    if(curl)
+    {
+        curl_easy_setopt(curl, CURLOPT_NOBODY, 1L);
+        curl_easy_setopt(curl, CURLOPT_HEADERFUNCTION, curlHeaderVersion);
+        curl_easy_setopt(curl, CURLOPT_HEADERDATA, &info);
+
+        int attempts = ATTEMPTS_PER_REQUEST;
+        while(!status && (attempts-- > 0))
+        {
+            CURLcode res = curl_easy_perform(curl);
+            if(res == CURLE_OK)
+            {
+                long http_code = 0;
+                curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &http_code);
+                if(http_code < 300) status = true;
+                else mlog(CRITICAL, "S3 head returned http error <%ld>: %s", http_code, key_ptr);
+                break;
+            }
+            mlog(CRITICAL, "cURL call failed (%d) for head request: %s", res, key_ptr);
+        }
+
+        releaseHandle(host.c_str(), curl);
+    }
+    curl_slist_free_all(headers);
+
+    /* Throw Exception on Failure */
+    if(!status)
+    {
+        throw RunTimeException(CRITICAL, RTE_ERROR, "cURL head request to S3 failed");
+    }
+
+    return version;
 }
 
 /*----------------------------------------------------------------------------
@@ -414,7 +770,8 @@ int64_t S3CurlIODriver::get (uint8_t* data, int64_t size, uint64_t pos, const ch
     if(key_ptr[0] == '/') key_ptr++;
 
     /* Build URL */
-    FString url("https://s3.%s.amazonaws.com/%s/%s", region, bucket, key_ptr);
+    FString host("s3.%s.amazonaws.com", region);
+    FString url("https://%s/%s/%s", host.c_str(), bucket, key_ptr);
 
     /* Check Size and Initialize Data */
     assert(size > 0);
@@ -442,7 +799,7 @@ int64_t S3CurlIODriver::get (uint8_t* data, int64_t size, uint64_t pos, const ch
         headers = curl_slist_append(headers, rangeHeader.c_str());
 
         /* Initialize cURL Request */
-        CURL* curl = initializeReadRequest(url, headers, curlWriteFixed, &info);
+        CURL* curl = initializeReadRequest(host.c_str(), url, headers, curlWriteFixed, &info);
         if(curl)
         {
             while(!rqst_complete && (attempts-- > 0))
@@ -486,8 +843,8 @@ int64_t S3CurlIODriver::get (uint8_t* data, int64_t size, uint64_t pos, const ch
                 }
             }
 
-            /* Clean Up cURL */
-            curl_easy_cleanup(curl);
+            /* Release cURL Handle */
+            releaseHandle(host.c_str(), curl);
         }
         else
         {
@@ -505,8 +862,10 @@ int64_t S3CurlIODriver::get (uint8_t* data, int64_t size, uint64_t pos, const ch
         throw RunTimeException(CRITICAL, RTE_ERROR, "cURL fixed request to S3 failed");
     }
 
-    /* Return Success */
-    return size;
+    /* Return Number of Bytes Received
+     *  can be less than the size requested when the
+     *  range extends past the end of the object */
+    return info.index;
 }
 
 /*----------------------------------------------------------------------------
@@ -530,10 +889,11 @@ int64_t S3CurlIODriver::get (uint8_t** data, const char* bucket, const char* key
     List<streaming_data_t> rsps_set;
 
     /* Build URL */
-    FString url("https://s3.%s.amazonaws.com/%s/%s", region, bucket, key_ptr);
+    FString host("s3.%s.amazonaws.com", region);
+    FString url("https://%s/%s/%s", host.c_str(), bucket, key_ptr);
 
     /* Initialize cURL Request */
-    CURL* curl = initializeReadRequest(url, headers, curlWriteStreaming, &rsps_set);
+    CURL* curl = initializeReadRequest(host.c_str(), url, headers, curlWriteStreaming, &rsps_set);
     if(curl)
     {
         bool rqst_complete = false;
@@ -598,8 +958,8 @@ int64_t S3CurlIODriver::get (uint8_t** data, const char* bucket, const char* key
             }
         }
 
-        /* Clean Up cURL */
-        curl_easy_cleanup(curl);
+        /* Release cURL Handle */
+        releaseHandle(host.c_str(), curl);
     }
 
     /* Clean Up Headers */
@@ -642,10 +1002,11 @@ int64_t S3CurlIODriver::get (const char* filename, const char* bucket, const cha
     if(data.fd)
     {
         /* Build URL */
-        FString url("https://s3.%s.amazonaws.com/%s/%s", region, bucket, key_ptr);
+        FString host("s3.%s.amazonaws.com", region);
+        FString url("https://%s/%s/%s", host.c_str(), bucket, key_ptr);
 
         /* Initialize cURL Request */
-        CURL* curl = initializeReadRequest(url, headers, curlWriteFile, &data);
+        CURL* curl = initializeReadRequest(host.c_str(), url, headers, curlWriteFile, &data);
         if(curl)
         {
             bool rqst_complete = false;
@@ -689,8 +1050,8 @@ int64_t S3CurlIODriver::get (const char* filename, const char* bucket, const cha
                 }
             }
 
-            /* Clean Up cURL */
-            curl_easy_cleanup(curl);
+            /* Release cURL Handle */
+            releaseHandle(host.c_str(), curl);
         }
 
         /* Close File */
@@ -989,6 +1350,51 @@ int S3CurlIODriver::luaUpload(lua_State* L)
     return 1;
 }
 
+/*----------------------------------------------------------------------------
+ * luaReadahead - s3readahead(<window size>, [<coalesce gap>], [<async>])
+ *
+ *  applies to drivers created after the call; a window size of 0 disables
+ *  readahead
+ *----------------------------------------------------------------------------*/
+int S3CurlIODriver::luaReadahead(lua_State* L)
+{
+    bool status = false;
+
+    try
+    {
+        /* Get Parameters */
+        long size   = LuaObject::getLuaInteger(L, 1);
+        long gap    = LuaObject::getLuaInteger(L, 2, true, DEFAULT_COALESCE_GAP);
+        bool async  = LuaObject::getLuaBoolean(L, 3, true, false);
+
+        /* Check Parameters */
+        if(size < 0) throw RunTimeException(CRITICAL, RTE_ERROR, "Invalid readahead size: %ld", size);
+        if(gap < 0) throw RunTimeException(CRITICAL, RTE_ERROR, "Invalid coalesce gap: %ld", gap);
+
+        /* Configure Readahead */
+        configureReadahead(size, gap, async);
+        status = true;
+    }
+    catch(const RunTimeException& e)
+    {
+        mlog(e.level(), "Error configuring S3 readahead: %s", e.what());
+    }
+
+    /* Return Status */
+    lua_pushboolean(L, status);
+    return 1;
+}
+
+/*----------------------------------------------------------------------------
+ * configureReadahead
+ *----------------------------------------------------------------------------*/
+void S3CurlIODriver::configureReadahead (int64_t size, int64_t gap, bool async)
+{
+    readaheadSize = size;
+    coalesceGap = gap;
+    asyncReadahead = async;
+}
+
 /*----------------------------------------------------------------------------
  * Constructor - for derived classes
  *----------------------------------------------------------------------------*/
@@ -998,6 +1404,22 @@ S3CurlIODriver::S3CurlIODriver (const Asset* _asset):
     ioBucket = NULL;
     ioKey = NULL;
 
+    /* Readahead Not Used for Bucket-less Drivers */
+    raSize = 0;
+    raGap = 0;
+    raAsync = false;
+    raLastEnd = 0;
+    raBuffer = NULL;
+    raPos = 0;
+    raValid = 0;
+    raNextBuffer = NULL;
+    raNextPos = 0;
+    raNextValid = 0;
+    raNextState = READAHEAD_IDLE;
+    raActive = false;
+    raPid = NULL;
+    version[0] = '\0';
+
     /* Get Latest Credentials */
     latestCredentials = CredentialStore::get(asset->getIdentity());
 }
@@ -1025,6 +1447,22 @@ S3CurlIODriver::S3CurlIODriver (const Asset* _asset, const char* resource):
     else throw RunTimeException(CRITICAL, RTE_ERROR, "invalid S3 url: %s", resource);
     ioKey++;
 
+    /* Initialize Readahead */
+    raSize = readaheadSize;
+    raGap = coalesceGap;
+    raAsync = asyncReadahead && (raSize > 0);
+    raLastEnd = 0;
+    raBuffer = (raSize > 0) ? new uint8_t [raSize] : NULL;
+    raPos = 0;
+    raValid = 0;
+    raNextBuffer = raAsync ? new uint8_t [raSize] : NULL;
+    raNextPos = 0;
+    raNextValid = 0;
+    raNextState = READAHEAD_IDLE;
+    raActive = false;
+    raPid = NULL;
+    version[0] = '\0';
+
     /* Get Latest Credentials */
     latestCredentials = CredentialStore::get(asset->getIdentity());
 }
@@ -1034,6 +1472,19 @@ S3CurlIODriver::S3CurlIODriver (const Asset* _asset, const char* resource):
  *----------------------------------------------------------------------------*/
 S3CurlIODriver::~S3CurlIODriver (void)
 {
+    /* Stop Readahead Thread */
+    raCond.lock();
+    {
+        raActive = false;
+        raCond.signal();
+    }
+    raCond.unlock();
+    delete raPid;
+
+    /* Delete Readahead Windows */
+    delete [] raBuffer;
+    delete [] raNextBuffer;
+
     /*
      * Delete Memory Allocated for ioBucket
      *  only ioBucket is freed because ioKey only points
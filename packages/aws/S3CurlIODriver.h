@@ -60,6 +60,9 @@ class S3CurlIODriver: public Asset::IODriver
         static const long ATTEMPTS_PER_REQUEST = 3;
         static const long SSL_VERIFYPEER = 0;
         static const long SSL_VERIFYHOST = 0;
+        static const int MAX_POOLED_HANDLES = 32; // idle cURL handles kept per host
+        static const int64_t DEFAULT_READAHEAD_SIZE = 0; // disabled; sequential readers opt in with s3readahead
+        static const int64_t DEFAULT_COALESCE_GAP = 0x10000; // 64KB
         static const char* DEFAULT_REGION;
         static const char* DEFAULT_IDENTITY;
         static const char* CURL_FORMAT;
@@ -68,8 +71,10 @@ class S3CurlIODriver: public Asset::IODriver
          * Methods
          *--------------------------------------------------------------------*/
 
+        static void         deinit          (void);
         static IODriver*    create          (const Asset* _asset, const char* resource);
         virtual int64_t     ioRead          (uint8_t* data, int64_t size, uint64_t pos) override;
+        virtual const char* ioVersion       (void) override;
 
         // fixed GET - memory preallocated
         static int64_t      get             (uint8_t* data, int64_t size, uint64_t pos,
@@ -95,9 +100,23 @@ class S3CurlIODriver: public Asset::IODriver
         static int          luaDownload     (lua_State* L);
         static int          luaRead         (lua_State* L);
         static int          luaUpload       (lua_State* L);
+        static int          luaReadahead    (lua_State* L);
+
+        static void         configureReadahead (int64_t size, int64_t gap, bool async);
 
     protected:
 
+        /*--------------------------------------------------------------------
+         * Typedefs
+         *--------------------------------------------------------------------*/
+
+        typedef enum {
+            READAHEAD_IDLE,
+            READAHEAD_REQUESTED,
+            READAHEAD_FETCHING,
+            READAHEAD_COMPLETE
+        } readahead_state_t;
+
         /*--------------------------------------------------------------------
          * Methods
          *--------------------------------------------------------------------*/
@@ -106,14 +125,39 @@ class S3CurlIODriver: public Asset::IODriver
         explicit            S3CurlIODriver  (const Asset* _asset, const char* resource);
         virtual             ~S3CurlIODriver (void);
 
+        bool                readWindow      (uint8_t* data, int64_t size, uint64_t pos);
+        void                startReadahead  (uint64_t pos);
+        static void*        readaheadThread (void* parm);
+
         /*--------------------------------------------------------------------
          * Data
          *--------------------------------------------------------------------*/
 
+        static int64_t              readaheadSize;
+        static int64_t              coalesceGap;
+        static bool                 asyncReadahead;
+
         const Asset*                asset;
         CredentialStore::Credential latestCredentials;
         char*                       ioBucket;
         char*                       ioKey;
+        char                        version[MAX_VERSION_SIZE];
+
+        /* Readahead */
+        int64_t                     raSize;         // size of readahead window (0 if disabled)
+        int64_t                     raGap;          // distance past the last read still considered sequential
+        bool                        raAsync;        // fetch the next window in the background
+        uint64_t                    raLastEnd;      // end of the previous read
+        uint8_t*                    raBuffer;       // current window
+        uint64_t                    raPos;
+        int64_t                     raValid;        // bytes held in current window
+        uint8_t*                    raNextBuffer;   // window fetched in the background
+        uint64_t                    raNextPos;
+        int64_t                     raNextValid;    // bytes fetched into next window (-1 on failure)
+        readahead_state_t           raNextState;
+        bool                        raActive;
+        Cond                        raCond;
+        Thread*                     raPid;
 };
 
 #endif  /* __s3_curl_io_driver__ */
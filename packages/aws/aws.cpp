@@ -58,6 +58,7 @@ int aws_open (lua_State *L)
         {"s3download",  S3CurlIODriver::luaDownload},
         {"s3read",      S3CurlIODriver::luaRead},
         {"s3upload",    S3CurlIODriver::luaUpload},
+        {"s3readahead", S3CurlIODriver::luaReadahead},
         {"s3cache",     S3CacheIODriver::luaCreateCache},
         {NULL,          NULL}
     };
@@ -95,6 +96,7 @@ void initaws (void)
 void deinitaws (void)
 {
     /* Uninitialize Modules */
+    S3CurlIODriver::deinit();
     CredentialStore::deinit();
 }
 }
@@ -0,0 +1,180 @@
+/*
+ * Copyright (c) 2021, University of Washington
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the University of Washington nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE UNIVERSITY OF WASHINGTON AND CONTRIBUTORS
+ * “AS IS” AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE UNIVERSITY OF WASHINGTON OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+
+#include "CcsdsPacketBatch.h"
+#include "core.h"
+
+/******************************************************************************
+ * PUBLIC METHODS
+ ******************************************************************************/
+
+/*----------------------------------------------------------------------------
+ * Constructor
+ *----------------------------------------------------------------------------*/
+CcsdsPacketBatch::CcsdsPacketBatch(int _max_pkts, int _max_bytes)
+{
+    if(_max_pkts <= 0 || _max_pkts > MAX_PKTS)
+    {
+        throw RunTimeException(CRITICAL, RTE_ERROR, "invalid number of packets in batch: %d", _max_pkts);
+    }
+
+    if(_max_bytes <= 0 || _max_bytes > MAX_BYTES)
+    {
+        throw RunTimeException(CRITICAL, RTE_ERROR, "invalid number of bytes in batch: %d", _max_bytes);
+    }
+
+    maxPkts = _max_pkts;
+    maxBytes = _max_bytes;
+    numPkts = 0;
+    dataSize = 0;
+
+    /* Room for Packets plus Index, Count, and Tag */
+    buffer = new unsigned char [maxBytes + ((maxPkts + 2) * sizeof(uint32_t))];
+    offsets = new uint32_t [maxPkts];
+}
+
+/*----------------------------------------------------------------------------
+ * Destructor
+ *----------------------------------------------------------------------------*/
+CcsdsPacketBatch::~CcsdsPacketBatch(void)
+{
+    delete [] buffer;
+    delete [] offsets;
+}
+
+/*----------------------------------------------------------------------------
+ * add
+ *
+ *  returns false if the packet does not fit in the batch; a packet larger
+ *  than the batch is never added
+ *----------------------------------------------------------------------------*/
+bool CcsdsPacketBatch::add(const unsigned char* pkt, int len)
+{
+    if(numPkts >= maxPkts || dataSize + len > maxBytes)
+    {
+        return false;
+    }
+
+    offsets[numPkts++] = dataSize;
+    memcpy(&buffer[dataSize], pkt, len);
+    dataSize += len;
+
+    return true;
+}
+
+/*----------------------------------------------------------------------------
+ * serialize
+ *
+ *  appends the index, count, and tag to the packets and returns the batch as
+ *  a single message; the batch must be cleared before more packets are added
+ *----------------------------------------------------------------------------*/
+const unsigned char* CcsdsPacketBatch::serialize(int* size)
+{
+    uint32_t num_pkts = numPkts;
+    uint32_t tag = BATCH_TAG;
+    int index_size = numPkts * sizeof(uint32_t);
+    memcpy(&buffer[dataSize], offsets, index_size);
+    memcpy(&buffer[dataSize + index_size], &num_pkts, sizeof(uint32_t));
+    memcpy(&buffer[dataSize + index_size + sizeof(uint32_t)], &tag, sizeof(uint32_t));
+
+    *size = dataSize + index_size + (2 * sizeof(uint32_t));
+    return buffer;
+}
+
+/*----------------------------------------------------------------------------
+ * clear
+ *----------------------------------------------------------------------------*/
+void CcsdsPacketBatch::clear(void)
+{
+    numPkts = 0;
+    dataSize = 0;
+}
+
+/*----------------------------------------------------------------------------
+ * length
+ *----------------------------------------------------------------------------*/
+int CcsdsPacketBatch::length(void) const
+{
+    return numPkts;
+}
+
+/*----------------------------------------------------------------------------
+ * count
+ *
+ *  returns the number of packets in a serialized batch, or -1 if the message
+ *  is not a valid batch (e.g. not tagged as a batch of this version)
+ *----------------------------------------------------------------------------*/
+int CcsdsPacketBatch::count(const unsigned char* batch, int size)
+{
+    if(size < (int)(2 * sizeof(uint32_t))) return -1;
+
+    uint32_t tag;
+    memcpy(&tag, &batch[size - sizeof(uint32_t)], sizeof(uint32_t));
+    if(tag != BATCH_TAG) return -1;
+
+    uint32_t num_pkts;
+    memcpy(&num_pkts, &batch[size - (2 * sizeof(uint32_t))], sizeof(uint32_t));
+    if(num_pkts > (uint32_t)MAX_PKTS || num_pkts > (size / sizeof(uint32_t)) - 2) return -1;
+
+    return num_pkts;
+}
+
+/*----------------------------------------------------------------------------
+ * packet
+ *
+ *  returns a pointer to the packet at index inside a serialized batch, or
+ *  NULL if the index or the batch is invalid
+ *----------------------------------------------------------------------------*/
+unsigned char* CcsdsPacketBatch::packet(unsigned char* batch, int size, int index, int* len)
+{
+    int num_pkts = count(batch, size);
+    if(index < 0 || index >= num_pkts) return NULL;
+
+    /* Locate Packet in Index */
+    uint32_t index_start = size - ((num_pkts + 2) * sizeof(uint32_t));
+    uint32_t start;
+    uint32_t stop = index_start;
+    memcpy(&start, &batch[index_start + (index * sizeof(uint32_t))], sizeof(uint32_t));
+    if(index < num_pkts - 1)
+    {
+        memcpy(&stop, &batch[index_start + ((index + 1) * sizeof(uint32_t))], sizeof(uint32_t));
+    }
+
+    /* Check Packet Bounds */
+    if(start >= stop || stop > index_start) return NULL;
+
+    *len = stop - start;
+    return &batch[start];
+}
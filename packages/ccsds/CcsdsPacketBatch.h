@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) 2021, University of Washington
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice, 
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice, 
+ *    this list of conditions and the following disclaimer in the documentation 
+ *    and/or other materials provided with the distribution.
+ * 
+ * 3. Neither the name of the University of Washington nor the names of its 
+ *    contributors may be used to endorse or promote products derived from this 
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE UNIVERSITY OF WASHINGTON AND CONTRIBUTORS
+ * “AS IS” AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED 
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE UNIVERSITY OF WASHINGTON OR 
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, 
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, 
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, 
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR 
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __ccsds_packet_batch__
+#define __ccsds_packet_batch__
+
+/******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+
+#include "OsApi.h"
+
+/******************************************************************************
+ * CCSDS PACKET BATCH CLASS
+ *
+ *  Packets are stored back to back followed by an index of packet offsets,
+ *  the number of packets in the batch, and a tag identifying the message as
+ *  a batch and its layout version:
+ *
+ *      | pkt 0 | ... | pkt N-1 | offset 0 | ... | offset N-1 | N | TAG |
+ *
+ *  offsets, count, and tag are native endian uint32_t values and are not
+ *  aligned; the index is at the end so that packets can be appended without
+ *  knowing ahead of time how many will fit in the batch
+ ******************************************************************************/
+
+class CcsdsPacketBatch
+{
+    public:
+
+        /*--------------------------------------------------------------------
+         * Constants
+         *--------------------------------------------------------------------*/
+
+        static const int DEFAULT_MAX_BYTES = 0x100000;
+        static const int MAX_BYTES = 0x4000000; // 64MB
+        static const int MAX_PKTS = 0x4000;
+        static const uint32_t BATCH_TAG = 0xCCBA0001; // magic (upper half) and version (lower half)
+
+        /*--------------------------------------------------------------------
+         * Methods
+         *--------------------------------------------------------------------*/
+
+                                CcsdsPacketBatch    (int _max_pkts, int _max_bytes=DEFAULT_MAX_BYTES);
+                                ~CcsdsPacketBatch   (void);
+
+        bool                    add                 (const unsigned char* pkt, int len);
+        const unsigned char*    serialize           (int* size);
+        void                    clear               (void);
+        int                     length              (void) const;
+
+        static int              count               (const unsigned char* batch, int size);
+        static unsigned char*   packet              (unsigned char* batch, int size, int index, int* len);
+
+    private:
+
+        /*--------------------------------------------------------------------
+         * Data
+         *--------------------------------------------------------------------*/
+
+        unsigned char*          buffer;
+        uint32_t*               offsets;
+        int                     maxPkts;
+        int                     maxBytes;
+        int                     numPkts;
+        int                     dataSize;
+};
+
+#endif  /* __ccsds_packet_batch__ */
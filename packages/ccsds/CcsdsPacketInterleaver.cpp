@@ -55,7 +55,11 @@ const struct luaL_Reg CcsdsPacketInterleaver::LUA_META_TABLE[] = {
  ******************************************************************************/
 
 /*----------------------------------------------------------------------------
- * luaCreate - interleave([<inq1, inq2, ...>], <outq>)
+ * luaCreate - interleave([<inq1, inq2, ...>], <outq>, [<batch size>])
+ *
+ *  a batch size greater than zero means the input queues carry batches of
+ *  packets (see CcsdsPacketParser) and that up to that many packets are
+ *  posted at a time to the output queue as a single batch
  *----------------------------------------------------------------------------*/
 int CcsdsPacketInterleaver::luaCreate (lua_State* L)
 {
@@ -93,8 +97,15 @@ int CcsdsPacketInterleaver::luaCreate (lua_State* L)
         /* Get Output Queue */
         const char* outq_name = getLuaString(L, 2);
 
+        /* Get Batch Size */
+        long batch_size = getLuaInteger(L, 3, true, 0);
+        if(batch_size < 0 || batch_size > CcsdsPacketBatch::MAX_PKTS)
+        {
+            throw RunTimeException(CRITICAL, RTE_ERROR, "invalid batch size: %ld, must be between 0 and %d", batch_size, CcsdsPacketBatch::MAX_PKTS);
+        }
+
         /* Create Lua Object */
-        return createLuaObject(L, new CcsdsPacketInterleaver(L, inq_names, outq_name));
+        return createLuaObject(L, new CcsdsPacketInterleaver(L, inq_names, outq_name, batch_size));
     }
     catch(const RunTimeException& e)
     {
@@ -110,7 +121,7 @@ int CcsdsPacketInterleaver::luaCreate (lua_State* L)
 /*----------------------------------------------------------------------------
  * Constructor
  *----------------------------------------------------------------------------*/
-CcsdsPacketInterleaver::CcsdsPacketInterleaver(lua_State* L, List<string>& inq_names, const char* outq_name):
+CcsdsPacketInterleaver::CcsdsPacketInterleaver(lua_State* L, List<string>& inq_names, const char* outq_name, int batch_size):
     LuaObject(L, OBJECT_TYPE, LUA_META_NAME, LUA_META_TABLE)
 {
     /* Create Input Streams */
@@ -127,6 +138,13 @@ CcsdsPacketInterleaver::CcsdsPacketInterleaver(lua_State* L, List<string>& inq_n
     startTime = 0;
     stopTime = 0;
 
+    /* Create Output Batch */
+    batch = NULL;
+    if(batch_size > 0)
+    {
+        batch = new CcsdsPacketBatch(batch_size);
+    }
+
     /* Create Thread */
     active = true;
     pid = new Thread(processorThread, this);
@@ -140,6 +158,7 @@ CcsdsPacketInterleaver::~CcsdsPacketInterleaver(void)
     active = false;
     delete pid;
     delete outQ;
+    delete batch;
 }
 
 /******************************************************************************
@@ -166,12 +185,21 @@ void* CcsdsPacketInterleaver::processorThread(void* parm)
     /* Create Packet Arrays */
     double* pkt_times = new double[num_inputs];
     Subscriber::msgRef_t* pkt_refs = new Subscriber::msgRef_t[num_inputs];
+    unsigned char** pkt_bufs = new unsigned char* [num_inputs];
+    int* pkt_lens = new int[num_inputs];
+    int* pkt_index = new int[num_inputs];
+    int* pkt_count = new int[num_inputs];
     bool* inq_valid = new bool[num_inputs];
 
-    /* Initialize Packet Arrays */
+    /* Initialize Packet Arrays
+     *  each input holds a reference to its current message until every
+     *  packet in the message has been sent; when not batched a message
+     *  holds a single packet */
     for(int i = 0; i < num_inputs; i++)
     {
-        pkt_refs[i].size = 0;
+        pkt_lens[i] = 0;
+        pkt_index[i] = 0;
+        pkt_count[i] = 0;
         inq_valid[i] = true;
     }
 
@@ -182,44 +210,89 @@ void* CcsdsPacketInterleaver::processorThread(void* parm)
         /* Read Packets */
         for(int i = 0; i < num_inputs; i++)
         {
-            if(inq_valid[i] && pkt_refs[i].size == 0)
+            while(inq_valid[i] && pkt_lens[i] == 0)
             {
-                int status = processor->inQs[i]->receiveRef(pkt_refs[i], SYS_TIMEOUT);
-                if(status > 0)
+                /* Read Next Message */
+                if(pkt_index[i] >= pkt_count[i])
                 {
-                    if(pkt_refs[i].size > 0)
+                    /* Release Previous Message */
+                    if(pkt_count[i] > 0)
                     {
-                        /* Capture Packet Time */
-                        CcsdsSpacePacket pkt((unsigned char*)pkt_refs[i].data, pkt_refs[i].size);
-                        pkt_times[i] = pkt.getCdsTime();
+                        processor->inQs[i]->dereference(pkt_refs[i]);
+                        pkt_count[i] = 0;
+                    }
 
-                        /* Check Time Filter */
-                        if(processor->startTime > 0 && pkt_times[i] < processor->startTime)
+                    /* Receive Message (posting batch before waiting on input) */
+                    int status = processor->inQs[i]->receiveRef(pkt_refs[i], IO_CHECK);
+                    if(status == MsgQ::STATE_EMPTY)
+                    {
+                        if(processor->batch && processor->batch->length() > 0)
                         {
-                            processor->inQs[i]->dereference(pkt_refs[i]);
-                            pkt_refs[i].size = 0;
+                            processor->postBatch();
                         }
-                        else if(processor->stopTime > 0 && pkt_times[i] > processor->stopTime)
+                        status = processor->inQs[i]->receiveRef(pkt_refs[i], SYS_TIMEOUT);
+                    }
+                    if(status > 0)
+                    {
+                        if(pkt_refs[i].size > 0)
+                        {
+                            /* Count Packets in Message */
+                            pkt_index[i] = 0;
+                            pkt_count[i] = processor->batch ? CcsdsPacketBatch::count((unsigned char*)pkt_refs[i].data, pkt_refs[i].size) : 1;
+                            if(pkt_count[i] <= 0)
+                            {
+                                mlog(ERROR, "Invalid batch of %d bytes received on %s", pkt_refs[i].size, processor->inQs[i]->getName());
+                                processor->inQs[i]->dereference(pkt_refs[i]);
+                                pkt_count[i] = 0;
+                            }
+                        }
+                        else
                         {
+                            /* Terminator Received */
                             processor->inQs[i]->dereference(pkt_refs[i]);
-                            pkt_refs[i].size = 0;
+                            inq_valid[i] = false;
+                            num_valid--;
+                            mlog(DEBUG, "Terminator received on %s (%d remaining)", processor->inQs[i]->getName(), num_valid);
                         }
                     }
-                    else
+                    else if(status != MsgQ::STATE_TIMEOUT)
                     {
-                        /* Terminator Received */
-                        processor->inQs[i]->dereference(pkt_refs[i]);
+                        mlog(CRITICAL, "Failed to read from input queue %s: %d", processor->inQs[i]->getName(), status);
                         inq_valid[i] = false;
                         num_valid--;
-                        mlog(DEBUG, "Terminator received on %s (%d remaining)", processor->inQs[i]->getName(), num_valid);
                     }
+                    else
+                    {
+                        break; // nothing to read
+                    }
+                    continue;
+                }
+
+                /* Get Next Packet in Message */
+                unsigned char* buf = (unsigned char*)pkt_refs[i].data;
+                int len = pkt_refs[i].size;
+                if(processor->batch)
+                {
+                    buf = CcsdsPacketBatch::packet((unsigned char*)pkt_refs[i].data, pkt_refs[i].size, pkt_index[i], &len);
                 }
-                else if(status != MsgQ::STATE_TIMEOUT)
+                pkt_index[i]++;
+                if(!buf)
                 {
-                    mlog(CRITICAL, "Failed to read from input queue %s: %d", processor->inQs[i]->getName(), status);
-                    inq_valid[i] = false;
-                    num_valid--;
+                    mlog(ERROR, "Invalid packet %d in batch received on %s", pkt_index[i] - 1, processor->inQs[i]->getName());
+                    continue;
                 }
+
+                /* Capture Packet Time */
+                CcsdsSpacePacket pkt(buf, len);
+                pkt_times[i] = pkt.getCdsTime();
+
+                /* Check Time Filter */
+                if(processor->startTime > 0 && pkt_times[i] < processor->startTime) continue;
+                if(processor->stopTime > 0 && pkt_times[i] > processor->stopTime) continue;
+
+                /* Set Current Packet */
+                pkt_bufs[i] = buf;
+                pkt_lens[i] = len;
             }
         }
 
@@ -228,7 +301,7 @@ void* CcsdsPacketInterleaver::processorThread(void* parm)
         double earliest_pkt_time = DBL_MAX;
         for(int i = 0; i < num_inputs; i++)
         {
-            if(inq_valid[i] && pkt_refs[i].size > 0)
+            if(inq_valid[i] && pkt_lens[i] > 0)
             {
                 if(pkt_times[i] < earliest_pkt_time)
                 {
@@ -238,17 +311,28 @@ void* CcsdsPacketInterleaver::processorThread(void* parm)
             }
         }
 
-        /* Send Earliest Packet */
-        if(earliest_pkt >= 0)
+        /* Send Earliest Packet (batched or individually) */
+        if(earliest_pkt >= 0 && processor->batch)
+        {
+            if(!processor->batch->add(pkt_bufs[earliest_pkt], pkt_lens[earliest_pkt]))
+            {
+                processor->postBatch();
+                if(!processor->batch->add(pkt_bufs[earliest_pkt], pkt_lens[earliest_pkt]))
+                {
+                    mlog(CRITICAL, "Packet of size %d does not fit in batch", pkt_lens[earliest_pkt]);
+                }
+            }
+            pkt_lens[earliest_pkt] = 0;
+        }
+        else if(earliest_pkt >= 0)
         {
             int status = MsgQ::STATE_TIMEOUT;
             while(processor->active && status == MsgQ::STATE_TIMEOUT)
             {
-                status = processor->outQ->postCopy(pkt_refs[earliest_pkt].data, pkt_refs[earliest_pkt].size, SYS_TIMEOUT);
+                status = processor->outQ->postCopy(pkt_bufs[earliest_pkt], pkt_lens[earliest_pkt], SYS_TIMEOUT);
                 if(status > 0)
                 {
-                    processor->inQs[earliest_pkt]->dereference(pkt_refs[earliest_pkt]);
-                    pkt_refs[earliest_pkt].size = 0;
+                    pkt_lens[earliest_pkt] = 0;
                 }
                 else if(status == MsgQ::STATE_TIMEOUT)
                 {
@@ -263,10 +347,16 @@ void* CcsdsPacketInterleaver::processorThread(void* parm)
         }
     }
 
+    /* Post Remaining Batch */
+    if(processor->batch && processor->batch->length() > 0)
+    {
+        processor->postBatch();
+    }
+
     /* Dereference Outstanding Messages */
     for(int i = 0; i < num_inputs; i++)
     {
-        if(inq_valid[i] && pkt_refs[i].size > 0)
+        if(pkt_count[i] > 0)
         {
             processor->inQs[i]->dereference(pkt_refs[i]);
         }
@@ -275,6 +365,10 @@ void* CcsdsPacketInterleaver::processorThread(void* parm)
     /* Free Packet Arrays */
     delete [] pkt_times;
     delete [] pkt_refs;
+    delete [] pkt_bufs;
+    delete [] pkt_lens;
+    delete [] pkt_index;
+    delete [] pkt_count;
     delete [] inq_valid;
 
     /* Signal Complete */
@@ -282,6 +376,32 @@ void* CcsdsPacketInterleaver::processorThread(void* parm)
     return NULL;
 }
 
+/*----------------------------------------------------------------------------
+ * postBatch
+ *----------------------------------------------------------------------------*/
+void CcsdsPacketInterleaver::postBatch(void)
+{
+    int size;
+    const unsigned char* buffer = batch->serialize(&size);
+
+    int status = MsgQ::STATE_TIMEOUT;
+    while(active && status == MsgQ::STATE_TIMEOUT)
+    {
+        status = outQ->postCopy(buffer, size, SYS_TIMEOUT);
+        if(status == MsgQ::STATE_TIMEOUT)
+        {
+            mlog(WARNING, "Unexepected timeout in interleaver on %s", outQ->getName());
+        }
+        else if(status <= 0)
+        {
+            mlog(CRITICAL, "Failed to post to %s... exiting interleaver!", outQ->getName());
+            active = false;
+        }
+    }
+
+    batch->clear();
+}
+
 /*----------------------------------------------------------------------------
  * luaSetStartTime - :start(<gmt time>)
  *----------------------------------------------------------------------------*/
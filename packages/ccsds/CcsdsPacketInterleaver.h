@@ -37,6 +37,7 @@
  ******************************************************************************/
 
 #include "LuaObject.h"
+#include "CcsdsPacketBatch.h"
 #include "MsgQ.h"
 #include "List.h"
 #include "OsApi.h"
@@ -69,7 +70,7 @@ class CcsdsPacketInterleaver: public LuaObject
          * Methods
          *--------------------------------------------------------------------*/
 
-                    CcsdsPacketInterleaver      (lua_State* L, List<string>& inq_names, const char* outq_name);
+                    CcsdsPacketInterleaver      (lua_State* L, List<string>& inq_names, const char* outq_name, int batch_size);
         virtual     ~CcsdsPacketInterleaver     (void);
 
     private:
@@ -84,12 +85,14 @@ class CcsdsPacketInterleaver: public LuaObject
         Publisher*          outQ;
         double              startTime;
         double              stopTime;
+        CcsdsPacketBatch*   batch; // NULL when packets received and posted individually
 
         /*--------------------------------------------------------------------
          * Methods
          *--------------------------------------------------------------------*/
 
         static void*    processorThread (void* parm);
+        void            postBatch       (void);
         static int      luaSetStartTime (lua_State* L);
         static int      luaSetStopTime  (lua_State* L);
 };
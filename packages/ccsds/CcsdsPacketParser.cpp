@@ -60,7 +60,10 @@ const struct luaL_Reg CcsdsPacketParser::LUA_META_TABLE[] = {
  ******************************************************************************/
 
 /*----------------------------------------------------------------------------
- * luaCreate - parser(<parser>, <type - ccsds.ENCAP|ccsds.SPACE>, <inq>, <outq>, <statq>)
+ * luaCreate - parser(<parser>, <type - ccsds.ENCAP|ccsds.SPACE>, <inq>, <outq>, <statq>, [<batch size>])
+ *
+ *  a batch size greater than zero posts up to that many packets at a time
+ *  as a single CcsdsPacketBatch message instead of one message per packet
  *----------------------------------------------------------------------------*/
 int CcsdsPacketParser::luaCreate (lua_State* L)
 {
@@ -72,6 +75,7 @@ int CcsdsPacketParser::luaCreate (lua_State* L)
         const char*         inq_name    = getLuaString(L, 3);
         const char*         outq_name   = getLuaString(L, 4, true, NULL);
         const char*         statq_name  = getLuaString(L, 5, true, NULL);
+        long                batch_size  = getLuaInteger(L, 6, true, 0);
 
         /* Get Packet Type */
         CcsdsPacket::type_t pkt_type = str2pkttype(type_str);
@@ -80,8 +84,14 @@ int CcsdsPacketParser::luaCreate (lua_State* L)
             throw RunTimeException(CRITICAL, RTE_ERROR, "invalid packet type: %s", type_str);
         }
 
+        /* Check Batch Size */
+        if(batch_size < 0 || batch_size > CcsdsPacketBatch::MAX_PKTS)
+        {
+            throw RunTimeException(CRITICAL, RTE_ERROR, "invalid batch size: %ld, must be between 0 and %d", batch_size, CcsdsPacketBatch::MAX_PKTS);
+        }
+
         /* Create Packet Parser */
-        return createLuaObject(L, new CcsdsPacketParser(L, _parser, pkt_type, inq_name, outq_name, statq_name));
+        return createLuaObject(L, new CcsdsPacketParser(L, _parser, pkt_type, inq_name, outq_name, statq_name, batch_size));
     }
     catch(const RunTimeException& e)
     {
@@ -97,7 +107,7 @@ int CcsdsPacketParser::luaCreate (lua_State* L)
 /*----------------------------------------------------------------------------
  * Constructor
  *----------------------------------------------------------------------------*/
-CcsdsPacketParser::CcsdsPacketParser(lua_State* L, CcsdsParserModule* _parser, CcsdsPacket::type_t _type, const char* inq_name, const char* outq_name, const char* statq_name):
+CcsdsPacketParser::CcsdsPacketParser(lua_State* L, CcsdsParserModule* _parser, CcsdsPacket::type_t _type, const char* inq_name, const char* outq_name, const char* statq_name, int batch_size):
     MsgProcessor(L, inq_name, LUA_META_NAME, LUA_META_TABLE)
 {
     assert(_parser);
@@ -153,6 +163,13 @@ CcsdsPacketParser::CcsdsPacketParser(lua_State* L, CcsdsParserModule* _parser, C
         statQ = new Publisher(statq_name);
     }
 
+    /* Initialize Packet Batch */
+    batch = NULL;
+    if(batch_size > 0)
+    {
+        batch = new CcsdsPacketBatch(batch_size);
+    }
+
     /* Create Threads */
     telemetryActive = true;
     telemetryThread = new Thread(telemetry_thread, this);
@@ -175,6 +192,7 @@ CcsdsPacketParser::~CcsdsPacketParser(void)
 
     if(outQ)    delete outQ;
     if(statQ)   delete statQ;
+    if(batch)   delete batch;
 }
 
 /*----------------------------------------------------------------------------
@@ -524,8 +542,35 @@ bool CcsdsPacketParser::processMsg (unsigned char* msg, int bytes)
                     apidStats[ALL_APIDS].total_bytes += len;
                     apidStats[ALL_APIDS].curr_bytes += len;
 
-                    /* Post Packet */
-                    if(outQ != NULL)
+                    /* Post Packet (batched or individually) */
+                    if(outQ != NULL && batch != NULL)
+                    {
+                        /* Get Buffer and Buffer Size */
+                        unsigned char* bufptr = pkt->getBuffer();
+                        int buflen = pkt->getLEN();
+                        if(stripHdrOnPost)
+                        {
+                            bufptr += pkt->getHdrSize();
+                            buflen -= pkt->getHdrSize();
+                        }
+
+                        /* Add Buffer to Batch */
+                        if(buflen <= 0)
+                        {
+                            mlog(CRITICAL, "Packet %04X has invalid size %d", pkt->getAPID(), buflen);
+                        }
+                        else if(!batch->add(bufptr, buflen))
+                        {
+                            postBatch();
+                            if(!batch->add(bufptr, buflen))
+                            {
+                                mlog(CRITICAL, "Packet %04X of size %d does not fit in batch", pkt->getAPID(), buflen);
+                                apidStats[apid].pkts_dropped++;
+                                apidStats[ALL_APIDS].pkts_dropped++;
+                            }
+                        }
+                    }
+                    else if(outQ != NULL)
                     {
                         int status = MsgQ::STATE_TIMEOUT;
                         while(isActive() && status == MsgQ::STATE_TIMEOUT)
@@ -582,6 +627,12 @@ bool CcsdsPacketParser::processMsg (unsigned char* msg, int bytes)
         }
     }
 
+    /* Post Packets Batched from Message */
+    if(batch != NULL && batch->length() > 0)
+    {
+        postBatch();
+    }
+
     return true;
 }
 
@@ -745,6 +796,29 @@ bool CcsdsPacketParser::isValid (unsigned char* _pkt, unsigned int _len, bool ig
     return status;
 }
 
+/*----------------------------------------------------------------------------
+ * postBatch
+ *----------------------------------------------------------------------------*/
+void CcsdsPacketParser::postBatch (void)
+{
+    int size;
+    const unsigned char* buffer = batch->serialize(&size);
+
+    int status = MsgQ::STATE_TIMEOUT;
+    while(isActive() && status == MsgQ::STATE_TIMEOUT)
+    {
+        status = outQ->postCopy(buffer, size, SYS_TIMEOUT);
+        if((status != MsgQ::STATE_TIMEOUT) && (status < 0))
+        {
+            mlog(CRITICAL, "Batch of %d packets unable to be posted[%d] to output stream %s", batch->length(), status, outQ->getName());
+            apidStats[ALL_APIDS].pkts_dropped += batch->length();
+            break;
+        }
+    }
+
+    batch->clear();
+}
+
 /*----------------------------------------------------------------------------
  * str2pkttype
  *----------------------------------------------------------------------------*/
@@ -37,6 +37,7 @@
  ******************************************************************************/
 
 #include "CcsdsPacket.h"
+#include "CcsdsPacketBatch.h"
 #include "CcsdsParserModule.h"
 #include "MsgProcessor.h"
 #include "MsgQ.h"
@@ -118,6 +119,7 @@ class CcsdsPacketParser: public MsgProcessor
 
         Publisher*          outQ;
         Publisher*          statQ;
+        CcsdsPacketBatch*   batch; // NULL when packets posted individually
 
         bool                parserInSync;
         long                parserBytes;
@@ -126,7 +128,7 @@ class CcsdsPacketParser: public MsgProcessor
          * Methods
          *--------------------------------------------------------------------*/
 
-                        CcsdsPacketParser       (lua_State* L, CcsdsParserModule* _parser, CcsdsPacket::type_t _type, const char* inq_name, const char* outq_name, const char* statq_name);
+                        CcsdsPacketParser       (lua_State* L, CcsdsParserModule* _parser, CcsdsPacket::type_t _type, const char* inq_name, const char* outq_name, const char* statq_name, int batch_size);
                         ~CcsdsPacketParser      (void);
 
         static int      luaPassInvalid          (lua_State* L);
@@ -141,6 +143,7 @@ class CcsdsPacketParser: public MsgProcessor
         bool            deinitProcessing        (void) override;
         bool            processMsg              (unsigned char* msg, int bytes) override;
         bool            isValid                 (unsigned char* _pkt, unsigned int _len, bool ignore_length);
+        void            postBatch               (void);
 
         static CcsdsPacket::type_t  str2pkttype         (const char* str);
         static double               integrateAverage    (uint32_t statcnt, double curr_avg, double new_val);
@@ -35,6 +35,7 @@
 
 #include "CcsdsRecordDispatcher.h"
 #include "CcsdsRecord.h"
+#include "CcsdsPacketBatch.h"
 #include "core.h"
 
 /******************************************************************************
@@ -42,7 +43,7 @@
  ******************************************************************************/
 
 /*----------------------------------------------------------------------------
- * luaCreate - dispatcher(<input stream name>, [<num threads>], [<key mode>, <key parm>])
+ * luaCreate - dispatcher(<input stream name>, [<num threads>], [<key mode>, <key parm>], [<batched>])
  *----------------------------------------------------------------------------*/
 int CcsdsRecordDispatcher::luaCreate (lua_State* L)
 {
@@ -52,6 +53,7 @@ int CcsdsRecordDispatcher::luaCreate (lua_State* L)
         const char* qname           = getLuaString(L, 1);
         long        num_threads     = getLuaInteger(L, 2, true, OsApi::nproc());
         const char* key_mode_str    = getLuaString(L, 3, true, "RECEIPT_KEY");
+        bool        batched         = getLuaBoolean(L, 5, true, false);
 
         /* Check Number of Threads */
         if(num_threads < 1)
@@ -78,7 +80,7 @@ int CcsdsRecordDispatcher::luaCreate (lua_State* L)
         }
 
         /* Create Record Dispatcher */
-        return createLuaObject(L, new CcsdsRecordDispatcher(L, qname, key_mode, key_field, key_func, num_threads));
+        return createLuaObject(L, new CcsdsRecordDispatcher(L, qname, key_mode, key_field, key_func, num_threads, batched));
     }
     catch(const RunTimeException& e)
     {
@@ -94,8 +96,9 @@ int CcsdsRecordDispatcher::luaCreate (lua_State* L)
 /*----------------------------------------------------------------------------
  * Constructor
  *----------------------------------------------------------------------------*/
-CcsdsRecordDispatcher::CcsdsRecordDispatcher(lua_State* L, const char* inputq_name, keyMode_t key_mode, const char* key_field, calcFunc_f key_func, int num_threads):
-    RecordDispatcher(L, inputq_name, key_mode, key_field, key_func, num_threads, MsgQ::SUBSCRIBER_OF_CONFIDENCE)
+CcsdsRecordDispatcher::CcsdsRecordDispatcher(lua_State* L, const char* inputq_name, keyMode_t key_mode, const char* key_field, calcFunc_f key_func, int num_threads, bool _batched):
+    RecordDispatcher(L, inputq_name, key_mode, key_field, key_func, num_threads, MsgQ::SUBSCRIBER_OF_CONFIDENCE),
+    batched(_batched)
 {
 }
 
@@ -113,3 +116,26 @@ RecordObject* CcsdsRecordDispatcher::createRecord (unsigned char* buffer, int si
 {
     return new CcsdsRecordInterface(buffer, size);
 }
+
+/*----------------------------------------------------------------------------
+ * countRecords
+ *
+ *  number of packets in a batch when the input is batched; a message that is
+ *  not a batch (e.g. untagged) is invalid
+ *----------------------------------------------------------------------------*/
+int CcsdsRecordDispatcher::countRecords (unsigned char* msg, int len)
+{
+    if(!batched) return RecordDispatcher::countRecords(msg, len);
+    return CcsdsPacketBatch::count(msg, len);
+}
+
+/*----------------------------------------------------------------------------
+ * unpackRecord
+ *
+ *  iterates the packets of a batch in place when the input is batched
+ *----------------------------------------------------------------------------*/
+unsigned char* CcsdsRecordDispatcher::unpackRecord (unsigned char* msg, int len, int index, int* size)
+{
+    if(!batched) return RecordDispatcher::unpackRecord(msg, len, index, size);
+    return CcsdsPacketBatch::packet(msg, len, index, size);
+}
@@ -54,14 +54,22 @@ class CcsdsRecordDispatcher: public RecordDispatcher
 
     private:
 
+        /*--------------------------------------------------------------------
+         * Data
+         *--------------------------------------------------------------------*/
+
+        bool            batched; // input queue carries CcsdsPacketBatch messages
+
         /*--------------------------------------------------------------------
          * Methods
          *--------------------------------------------------------------------*/
 
-                        CcsdsRecordDispatcher   (lua_State* L, const char* inputq_name, keyMode_t key_mode, const char* key_field, calcFunc_f key_func, int num_threads);
+                        CcsdsRecordDispatcher   (lua_State* L, const char* inputq_name, keyMode_t key_mode, const char* key_field, calcFunc_f key_func, int num_threads, bool _batched);
                         ~CcsdsRecordDispatcher  (void);
 
         RecordObject*   createRecord            (unsigned char* buffer, int size) override;
+        int             countRecords            (unsigned char* msg, int len) override;
+        unsigned char*  unpackRecord            (unsigned char* msg, int len, int index, int* size) override;
 };
 
 #endif  /* __ccsds_record_dispatcher__ */
@@ -112,6 +112,7 @@ int ccsds_open (lua_State *L)
     LuaEngine::setAttrStr   (L, "NOSYNC",       "NOSYNC");
     LuaEngine::setAttrStr   (L, "ENCAP",        "ENCAP");
     LuaEngine::setAttrStr   (L, "SPACE",        "SPACE");
+    LuaEngine::setAttrInt   (L, "MAX_BATCH",    CcsdsPacketBatch::MAX_PKTS);
 
     return 1;
 }
@@ -37,6 +37,7 @@
  ******************************************************************************/
 
 #include "CcsdsPacket.h"
+#include "CcsdsPacketBatch.h"
 #include "CcsdsPacketizer.h"
 #include "CcsdsPacketInterleaver.h"
 #include "CcsdsPacketParser.h"
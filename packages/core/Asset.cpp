@@ -81,6 +81,44 @@ int64_t Asset::IODriver::ioRead (uint8_t* data, int64_t size, uint64_t pos)
     return 0;
 }
 
+/*----------------------------------------------------------------------------
+ * ioMap
+ *
+ *  returns a pointer to the requested bytes if the driver can provide them
+ *  without a copy, valid for the lifetime of the driver; NULL otherwise
+ *----------------------------------------------------------------------------*/
+const uint8_t* Asset::IODriver::ioMap (int64_t size, uint64_t pos)
+{
+    (void)size;
+    (void)pos;
+    return NULL;
+}
+
+/*----------------------------------------------------------------------------
+ * ioAdvise
+ *
+ *  hint of how the requested bytes will be accessed; a size of zero applies
+ *  the hint to the whole resource
+ *----------------------------------------------------------------------------*/
+void Asset::IODriver::ioAdvise (int64_t size, uint64_t pos, io_access_t access)
+{
+    (void)size;
+    (void)pos;
+    (void)access;
+}
+
+/*----------------------------------------------------------------------------
+ * ioVersion
+ *
+ *  returns a string that changes whenever the contents of the resource
+ *  change (e.g. an ETag), valid until the next call; NULL if the driver
+ *  is unable to tell
+ *----------------------------------------------------------------------------*/
+const char* Asset::IODriver::ioVersion (void)
+{
+    return NULL;
+}
+
 /*----------------------------------------------------------------------------
  * Constructor
  *----------------------------------------------------------------------------*/
@@ -160,6 +198,22 @@ bool Asset::registerDriver (const char* _format, io_driver_f factory)
     return status;
 }
 
+/*----------------------------------------------------------------------------
+ * findDriver
+ *----------------------------------------------------------------------------*/
+bool Asset::findDriver (const char* _format, io_driver_t* driver)
+{
+    bool found;
+
+    ioDriverMut.lock();
+    {
+        found = ioDrivers.find(_format, driver);
+    }
+    ioDriverMut.unlock();
+
+    return found;
+}
+
 /*----------------------------------------------------------------------------
  * createDriver
  *----------------------------------------------------------------------------*/
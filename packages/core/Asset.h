@@ -67,10 +67,22 @@ class Asset: public LuaObject
         class IODriver
         {
             public:
-                static IODriver*    create      (const Asset* _asset, const char* resource);
-                                    IODriver    (void);
-                virtual             ~IODriver   (void);
-                virtual int64_t     ioRead      (uint8_t* data, int64_t size, uint64_t pos);
+                typedef enum {
+                    IO_ACCESS_NORMAL,
+                    IO_ACCESS_SEQUENTIAL,
+                    IO_ACCESS_RANDOM,
+                    IO_ACCESS_WILLNEED
+                } io_access_t;
+
+                static const int        MAX_VERSION_SIZE = 128;
+
+                static IODriver*        create      (const Asset* _asset, const char* resource);
+                                        IODriver    (void);
+                virtual                 ~IODriver   (void);
+                virtual int64_t         ioRead      (uint8_t* data, int64_t size, uint64_t pos);
+                virtual const uint8_t*  ioMap       (int64_t size, uint64_t pos);
+                virtual void            ioAdvise    (int64_t size, uint64_t pos, io_access_t access);
+                virtual const char*     ioVersion   (void);
         };
 
         /*--------------------------------------------------------------------
@@ -101,6 +113,7 @@ class Asset: public LuaObject
 
         static int      luaCreate       (lua_State* L);
         static bool     registerDriver  (const char* _format, io_driver_f factory);
+        static bool     findDriver      (const char* _format, io_driver_t* driver);
 
         IODriver*       createDriver    (const char* resource) const;
 
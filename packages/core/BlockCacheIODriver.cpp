@@ -0,0 +1,728 @@
+/*
+ * Copyright (c) 2021, University of Washington
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the University of Washington nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE UNIVERSITY OF WASHINGTON AND CONTRIBUTORS
+ * “AS IS” AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE UNIVERSITY OF WASHINGTON OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <errno.h>
+
+#include "BlockCacheIODriver.h"
+#include "OsApi.h"
+#include "Asset.h"
+#include "StringLib.h"
+#include "EventLib.h"
+
+/******************************************************************************
+ * STATIC DATA
+ ******************************************************************************/
+
+const char* BlockCacheIODriver::DEFAULT_CACHE_ROOT = ".blockcache";
+const char* BlockCacheIODriver::INDEX_FILENAME = "blockcache.idx";
+const char* BlockCacheIODriver::DATA_FILENAME = "blockcache.dat";
+
+Cond                                    BlockCacheIODriver::cacheMut;
+const char*                             BlockCacheIODriver::cacheRoot = NULL;
+int64_t                                 BlockCacheIODriver::blockSize = 0;
+int64_t                                 BlockCacheIODriver::numSlots = 0;
+int                                     BlockCacheIODriver::dataFd = -1;
+int                                     BlockCacheIODriver::indexFd = -1;
+BlockCacheIODriver::slot_t*             BlockCacheIODriver::slots = NULL;
+uint64_t*                               BlockCacheIODriver::slotGeneration = NULL;
+int64_t                                 BlockCacheIODriver::slotPins = 0;
+int64_t*                                BlockCacheIODriver::freeSlots = NULL;
+int64_t                                 BlockCacheIODriver::numFree = 0;
+uint64_t                                BlockCacheIODriver::sequence = 0;
+BlockCacheIODriver::lru_t*              BlockCacheIODriver::lru = NULL;
+Dictionary<int64_t>                     BlockCacheIODriver::blockLookUp;
+Dictionary<Asset::io_driver_t>          BlockCacheIODriver::cachedFormats;
+int64_t                                 BlockCacheIODriver::blockHits = 0;
+int64_t                                 BlockCacheIODriver::blockMisses = 0;
+
+/******************************************************************************
+ * LOCAL FUNCTIONS
+ ******************************************************************************/
+
+/*----------------------------------------------------------------------------
+ * compareSequence - orders slots oldest first when restoring the cache
+ *----------------------------------------------------------------------------*/
+static const void* sortSlots = NULL;
+static int compareSequence (const void* a, const void* b)
+{
+    const uint64_t* sequences = (const uint64_t*)sortSlots;
+    uint64_t seq_a = sequences[*(const int64_t*)a];
+    uint64_t seq_b = sequences[*(const int64_t*)b];
+    if(seq_a < seq_b) return -1;
+    if(seq_a > seq_b) return 1;
+    return 0;
+}
+
+/******************************************************************************
+ * BLOCK CACHE IO DRIVER CLASS
+ ******************************************************************************/
+
+/*----------------------------------------------------------------------------
+ * deinit
+ *----------------------------------------------------------------------------*/
+void BlockCacheIODriver::deinit (void)
+{
+    cacheMut.lock();
+    {
+        closeCache();
+        cachedFormats.clear();
+    }
+    cacheMut.unlock();
+}
+
+/*----------------------------------------------------------------------------
+ * create
+ *----------------------------------------------------------------------------*/
+Asset::IODriver* BlockCacheIODriver::create (const Asset* _asset, const char* resource)
+{
+    Asset::io_driver_t cached_driver;
+    bool found = false;
+
+    cacheMut.lock();
+    {
+        found = cachedFormats.find(_asset->getDriver(), &cached_driver);
+    }
+    cacheMut.unlock();
+
+    if(!found)
+    {
+        throw RunTimeException(CRITICAL, RTE_ERROR, "format %s is not block cached", _asset->getDriver());
+    }
+
+    return new BlockCacheIODriver(_asset, resource, cached_driver.factory);
+}
+
+/*----------------------------------------------------------------------------
+ * luaCreateCache - blockcache(<format>, [<cache root>], [<capacity in bytes>], [<block size>])
+ *----------------------------------------------------------------------------*/
+int BlockCacheIODriver::luaCreateCache (lua_State* L)
+{
+    try
+    {
+        /* Get Parameters */
+        const char* format      = LuaObject::getLuaString(L, 1);
+        const char* cache_root  = LuaObject::getLuaString(L, 2, true, DEFAULT_CACHE_ROOT);
+        int64_t     capacity    = LuaObject::getLuaInteger(L, 3, true, DEFAULT_CACHE_SIZE);
+        int64_t     block_size  = LuaObject::getLuaInteger(L, 4, true, DEFAULT_BLOCK_SIZE);
+
+        /* Create Cache and Cache Format */
+        bool status = createCache(cache_root, capacity, block_size) && cacheFormat(format);
+
+        lua_pushboolean(L, status);
+        return 1;
+    }
+    catch(const RunTimeException& e)
+    {
+        mlog(e.level(), "Error creating block cache: %s", e.what());
+        lua_pushboolean(L, false);
+        return 1;
+    }
+}
+
+/*----------------------------------------------------------------------------
+ * luaUncacheFormat - blockuncache(<format>)
+ *----------------------------------------------------------------------------*/
+int BlockCacheIODriver::luaUncacheFormat (lua_State* L)
+{
+    try
+    {
+        const char* format = LuaObject::getLuaString(L, 1);
+        lua_pushboolean(L, uncacheFormat(format));
+        return 1;
+    }
+    catch(const RunTimeException& e)
+    {
+        mlog(e.level(), "Error removing format from block cache: %s", e.what());
+        lua_pushboolean(L, false);
+        return 1;
+    }
+}
+
+/*----------------------------------------------------------------------------
+ * luaCacheStats - blockstats() --> {hit, miss, blocks, slots}
+ *----------------------------------------------------------------------------*/
+int BlockCacheIODriver::luaCacheStats (lua_State* L)
+{
+    lua_newtable(L);
+    cacheMut.lock();
+    {
+        LuaEngine::setAttrInt(L, "hit",     blockHits);
+        LuaEngine::setAttrInt(L, "miss",    blockMisses);
+        LuaEngine::setAttrInt(L, "blocks",  lru ? lru->length() : 0);
+        LuaEngine::setAttrInt(L, "slots",   numSlots);
+    }
+    cacheMut.unlock();
+    return 1;
+}
+
+/*----------------------------------------------------------------------------
+ * createCache
+ *
+ *  the cache is created once; subsequent calls use the existing cache
+ *----------------------------------------------------------------------------*/
+bool BlockCacheIODriver::createCache (const char* cache_root, int64_t capacity, int64_t block_size)
+{
+    /* Check Parameters */
+    if(block_size <= 0 || capacity < block_size)
+    {
+        throw RunTimeException(CRITICAL, RTE_ERROR, "invalid block cache size %ld with block size %ld", (long)capacity, (long)block_size);
+    }
+
+    cacheMut.lock();
+    {
+        /* Check Existing Cache */
+        if(dataFd >= 0)
+        {
+            if(!StringLib::match(cache_root, cacheRoot) || block_size != blockSize || capacity / block_size != numSlots)
+            {
+                mlog(WARNING, "Block cache already created at %s, ignoring request for cache at %s", cacheRoot, cache_root);
+            }
+            cacheMut.unlock();
+            return true;
+        }
+
+        /* Create Cache Directory (if it doesn't exist) */
+        int ret = mkdir(cache_root, 0700);
+        if(ret == -1 && errno != EEXIST)
+        {
+            cacheMut.unlock();
+            throw RunTimeException(CRITICAL, RTE_ERROR, "failed to create block cache directory %s: %s", cache_root, strerror(errno));
+        }
+
+        /* Open Cache Files */
+        FString index_filename("%s%c%s", cache_root, PATH_DELIMETER, INDEX_FILENAME);
+        FString data_filename("%s%c%s", cache_root, PATH_DELIMETER, DATA_FILENAME);
+        indexFd = open(index_filename.c_str(), O_RDWR | O_CREAT, 0600);
+        dataFd = open(data_filename.c_str(), O_RDWR | O_CREAT, 0600);
+        if(indexFd < 0 || dataFd < 0)
+        {
+            closeCache();
+            cacheMut.unlock();
+            throw RunTimeException(CRITICAL, RTE_ERROR, "failed to open block cache files in %s: %s", cache_root, strerror(errno));
+        }
+
+        /* Allocate Slots */
+        cacheRoot = StringLib::duplicate(cache_root);
+        blockSize = block_size;
+        numSlots = capacity / block_size;
+        slots = new slot_t[numSlots];
+        slotGeneration = new uint64_t[numSlots];
+        freeSlots = new int64_t[numSlots];
+        lru = new lru_t(numSlots);
+        memset(slots, 0, sizeof(slot_t) * numSlots);
+        memset(slotGeneration, 0, sizeof(uint64_t) * numSlots);
+        numFree = 0;
+        sequence = 0;
+
+        /* Restore Index (if it matches the requested cache) */
+        index_header_t header;
+        int64_t slots_size = sizeof(slot_t) * numSlots;
+        bool restored = pread(indexFd, &header, sizeof(header), 0) == sizeof(header) &&
+                        header.magic == INDEX_MAGIC &&
+                        header.block_size == blockSize &&
+                        header.num_slots == numSlots &&
+                        pread(indexFd, slots, slots_size, sizeof(header)) == slots_size;
+
+        if(!restored)
+        {
+            /* Reinitialize Cache Files */
+            memset(slots, 0, slots_size);
+            header = { .magic = INDEX_MAGIC, .block_size = blockSize, .num_slots = numSlots };
+            bool initialized = ftruncate(indexFd, 0) == 0 &&
+                               ftruncate(indexFd, sizeof(header) + slots_size) == 0 &&
+                               pwrite(indexFd, &header, sizeof(header), 0) == sizeof(header) &&
+                               ftruncate(dataFd, 0) == 0 &&
+                               ftruncate(dataFd, numSlots * blockSize) == 0; // sparse
+            if(!initialized)
+            {
+                int err = errno;
+                closeCache();
+                cacheMut.unlock();
+                throw RunTimeException(CRITICAL, RTE_ERROR, "failed to initialize block cache in %s: %s", cache_root, strerror(err));
+            }
+        }
+
+        /* Build Lookup and Replacement Order from Index */
+        int64_t* valid_slots = new int64_t[numSlots];
+        uint64_t* sequences = new uint64_t[numSlots];
+        int64_t num_valid = 0;
+        for(int64_t slot = 0; slot < numSlots; slot++)
+        {
+            slot_t& entry = slots[slot];
+            sequences[slot] = entry.sequence;
+            entry.key[MAX_KEY_SIZE - 1] = '\0';
+            entry.version[MAX_VERSION_SIZE - 1] = '\0';
+            if(entry.size > 0 && entry.size <= blockSize) valid_slots[num_valid++] = slot;
+            else freeSlots[numFree++] = slot;
+        }
+        sortSlots = sequences;
+        qsort(valid_slots, num_valid, sizeof(int64_t), compareSequence);
+        for(int64_t i = 0; i < num_valid; i++)
+        {
+            int64_t slot = valid_slots[i];
+            FString block_key("%s#%lu", slots[slot].key, (unsigned long)slots[slot].block);
+            blockLookUp.add(block_key.c_str(), slot);
+            lru->add(slot, slot, true);
+            if(slots[slot].sequence >= sequence) sequence = slots[slot].sequence + 1;
+        }
+        delete [] valid_slots;
+        delete [] sequences;
+
+        mlog(INFO, "Block cache at %s restored %ld of %ld blocks", cacheRoot, (long)num_valid, (long)numSlots);
+    }
+    cacheMut.unlock();
+
+    return true;
+}
+
+/*----------------------------------------------------------------------------
+ * cacheFormat
+ *
+ *  replaces the driver registered for the format with the block cache, which
+ *  then uses the replaced driver to read the blocks that are not yet cached
+ *----------------------------------------------------------------------------*/
+bool BlockCacheIODriver::cacheFormat (const char* format)
+{
+    bool status = true;
+
+    cacheMut.lock();
+    {
+        if(!cachedFormats.find(format))
+        {
+            Asset::io_driver_t cached_driver;
+            if(Asset::findDriver(format, &cached_driver))
+            {
+                cachedFormats.add(format, cached_driver);
+                status = Asset::registerDriver(format, create);
+            }
+            else
+            {
+                mlog(CRITICAL, "Failed to find I/O driver for %s, unable to block cache", format);
+                status = false;
+            }
+        }
+    }
+    cacheMut.unlock();
+
+    return status;
+}
+
+/*----------------------------------------------------------------------------
+ * uncacheFormat
+ *
+ *  restores the driver the block cache replaced for the format; the cache
+ *  files are closed once no format is cached, drivers already created then
+ *  bypass the cache
+ *----------------------------------------------------------------------------*/
+bool BlockCacheIODriver::uncacheFormat (const char* format)
+{
+    bool status = false;
+
+    cacheMut.lock();
+    {
+        Asset::io_driver_t cached_driver;
+        if(cachedFormats.find(format, &cached_driver))
+        {
+            status = Asset::registerDriver(format, cached_driver.factory);
+            cachedFormats.remove(format);
+            if(cachedFormats.length() == 0) closeCache();
+        }
+        else
+        {
+            mlog(WARNING, "Format %s is not block cached", format);
+        }
+    }
+    cacheMut.unlock();
+
+    return status;
+}
+
+/*----------------------------------------------------------------------------
+ * ioRead
+ *----------------------------------------------------------------------------*/
+int64_t BlockCacheIODriver::ioRead (uint8_t* data, int64_t size, uint64_t pos)
+{
+    /* Bypass Cache */
+    if(!cacheable || dataFd < 0 || size <= 0)
+    {
+        return getDriver()->ioRead(data, size, pos);
+    }
+
+    /* Get Version of Resource Blocks Must Match */
+    if(!versionKnown)
+    {
+        const char* current_version = getDriver()->ioVersion();
+        StringLib::copy(version, current_version ? current_version : "", MAX_VERSION_SIZE);
+        versionKnown = true;
+    }
+
+    /* Read Blocks */
+    int64_t total = 0;
+    uint64_t block = pos / blockSize;
+    uint64_t last_block = (pos + size - 1) / blockSize;
+    while(block <= last_block)
+    {
+        /* Read Cached Block */
+        int64_t slot;
+        int64_t valid;
+        uint64_t generation;
+        if(lookupBlock(block, &slot, &valid, &generation))
+        {
+            uint64_t block_start = block * blockSize;
+            uint64_t copy_start = MAX(pos, block_start);
+            uint64_t copy_end = MIN(pos + size, block_start + valid);
+            int64_t copy_size = copy_end > copy_start ? copy_end - copy_start : 0;
+            bool copied = (copy_size == 0) || (pread(dataFd, &data[copy_start - pos], copy_size, (slot * blockSize) + (copy_start - block_start)) == copy_size);
+            if(releaseBlock(slot, generation) && copied)
+            {
+                total += copy_size;
+                if(valid < blockSize) break; // end of resource
+                block++;
+                continue;
+            }
+        }
+
+        /* Find Run of Missing Blocks */
+        uint64_t num_blocks = 1;
+        cacheMut.lock();
+        {
+            while(block + num_blocks <= last_block)
+            {
+                FString block_key("%s#%lu", cacheKey, (unsigned long)(block + num_blocks));
+                if(blockLookUp.find(block_key.c_str())) break;
+                num_blocks++;
+            }
+        }
+        cacheMut.unlock();
+
+        /* Fetch Missing Blocks */
+        uint64_t run_start = MAX(pos, block * blockSize);
+        uint64_t run_end = MIN(pos + size, (block + num_blocks) * blockSize);
+        int64_t bytes_fetched = fetchBlocks(block, num_blocks, data, size, pos);
+        total += bytes_fetched;
+        if(bytes_fetched < (int64_t)(run_end - run_start)) break; // end of resource
+        block += num_blocks;
+    }
+
+    return total;
+}
+
+/*----------------------------------------------------------------------------
+ * Constructor
+ *----------------------------------------------------------------------------*/
+BlockCacheIODriver::BlockCacheIODriver (const Asset* _asset, const char* _resource, Asset::io_driver_f _factory):
+    asset(_asset),
+    factory(_factory),
+    driver(NULL)
+{
+    resource = StringLib::duplicate(_resource);
+    FString key("%s/%s", asset->getPath(), resource);
+    cacheable = key.length() < MAX_KEY_SIZE;
+    StringLib::copy(cacheKey, cacheable ? key.c_str() : "", MAX_KEY_SIZE);
+    version[0] = '\0';
+    versionKnown = false;
+}
+
+/*----------------------------------------------------------------------------
+ * Destructor
+ *----------------------------------------------------------------------------*/
+BlockCacheIODriver::~BlockCacheIODriver (void)
+{
+    delete driver;
+    delete [] resource;
+}
+
+/*----------------------------------------------------------------------------
+ * getDriver - the underlying driver is created by the first read, which needs
+ *             the version of the resource
+ *----------------------------------------------------------------------------*/
+Asset::IODriver* BlockCacheIODriver::getDriver (void)
+{
+    if(!driver) driver = factory(asset, resource);
+    return driver;
+}
+
+/*----------------------------------------------------------------------------
+ * lookupBlock
+ *----------------------------------------------------------------------------*/
+bool BlockCacheIODriver::lookupBlock (uint64_t block, int64_t* slot, int64_t* size, uint64_t* generation)
+{
+    bool found = false;
+    FString block_key("%s#%lu", cacheKey, (unsigned long)block);
+
+    cacheMut.lock();
+    {
+        if(dataFd >= 0 && blockLookUp.find(block_key.c_str(), slot))
+        {
+            if(StringLib::match(slots[*slot].version, version))
+            {
+                /* Mark as Most Recently Used */
+                lru->find(*slot, lru_t::MATCH_EXACTLY, NULL, true);
+                slots[*slot].sequence = sequence++;
+                writeSlot(*slot);
+
+                /* Pin Slot until Block is Read */
+                slotPins++;
+                blockHits++;
+                *size = slots[*slot].size;
+                *generation = slotGeneration[*slot];
+                found = true;
+            }
+            else
+            {
+                /* Resource Changed since Block was Cached */
+                dropBlock(*slot);
+            }
+        }
+    }
+    cacheMut.unlock();
+
+    return found;
+}
+
+/*----------------------------------------------------------------------------
+ * releaseBlock - unpins the slot; true if it was not reused since it was looked up
+ *----------------------------------------------------------------------------*/
+bool BlockCacheIODriver::releaseBlock (int64_t slot, uint64_t generation)
+{
+    bool valid;
+
+    cacheMut.lock();
+    {
+        valid = (slotGeneration[slot] == generation);
+        if(--slotPins == 0) cacheMut.signal();
+    }
+    cacheMut.unlock();
+
+    return valid;
+}
+
+/*----------------------------------------------------------------------------
+ * dropBlock - must be called with cacheMut locked
+ *----------------------------------------------------------------------------*/
+void BlockCacheIODriver::dropBlock (int64_t slot)
+{
+    FString block_key("%s#%lu", slots[slot].key, (unsigned long)slots[slot].block);
+    blockLookUp.remove(block_key.c_str());
+    lru->remove(slot);
+    slotGeneration[slot]++;
+    slots[slot].size = 0;
+    writeSlot(slot);
+    freeSlots[numFree++] = slot;
+}
+
+/*----------------------------------------------------------------------------
+ * writeSlot - must be called with cacheMut locked
+ *
+ *  a failed write only loses the replacement order or leaves a dropped block
+ *  to be restored; the block is still checked against its version
+ *----------------------------------------------------------------------------*/
+void BlockCacheIODriver::writeSlot (int64_t slot)
+{
+    int64_t index_offset = sizeof(index_header_t) + (slot * sizeof(slot_t));
+    if(pwrite(indexFd, &slots[slot], sizeof(slot_t), index_offset) != sizeof(slot_t))
+    {
+        mlog(WARNING, "Failed to update slot %ld of block cache index: %s", (long)slot, strerror(errno));
+    }
+}
+
+/*----------------------------------------------------------------------------
+ * storeBlock
+ *----------------------------------------------------------------------------*/
+void BlockCacheIODriver::storeBlock (uint64_t block, const uint8_t* buffer, int64_t size)
+{
+    FString block_key("%s#%lu", cacheKey, (unsigned long)block);
+    slot_t entry;
+    int64_t slot = -1;
+
+    /* Allocate Slot */
+    cacheMut.lock();
+    {
+        if(dataFd >= 0 && !blockLookUp.find(block_key.c_str()))
+        {
+            if(numFree > 0)
+            {
+                slot = freeSlots[--numFree];
+            }
+            else if(lru->length() > 0)
+            {
+                /* Evict Least Recently Used Block */
+                lru->first(&slot);
+                lru->remove(slot);
+                FString evicted_key("%s#%lu", slots[slot].key, (unsigned long)slots[slot].block);
+                blockLookUp.remove(evicted_key.c_str());
+            }
+
+            if(slot >= 0)
+            {
+                /* Pending Until Written - not in lookup or replacement order */
+                slotGeneration[slot]++;
+                StringLib::copy(slots[slot].key, cacheKey, MAX_KEY_SIZE);
+                StringLib::copy(slots[slot].version, version, MAX_VERSION_SIZE);
+                slots[slot].block = block;
+                slots[slot].size = 0;
+                slots[slot].sequence = sequence++;
+                entry = slots[slot];
+
+                /* Pin Cache Files until Block is Written */
+                slotPins++;
+            }
+        }
+    }
+    cacheMut.unlock();
+
+    /* Check Slot */
+    if(slot < 0) return;
+
+    /* Write Block and then Index Entry */
+    int64_t index_offset = sizeof(index_header_t) + (slot * sizeof(slot_t));
+    bool written = pwrite(indexFd, &entry, sizeof(slot_t), index_offset) == sizeof(slot_t) &&
+                   pwrite(dataFd, buffer, size, slot * blockSize) == size;
+    if(written)
+    {
+        entry.size = size;
+        written = pwrite(indexFd, &entry, sizeof(slot_t), index_offset) == sizeof(slot_t);
+    }
+
+    /* Publish Slot */
+    cacheMut.lock();
+    {
+        if(written)
+        {
+            slots[slot].size = size;
+            blockLookUp.add(block_key.c_str(), slot);
+            lru->add(slot, slot, true);
+        }
+        else
+        {
+            mlog(ERROR, "Failed to write block %lu of %s to block cache: %s", (unsigned long)block, cacheKey, strerror(errno));
+            freeSlots[numFree++] = slot;
+        }
+
+        if(--slotPins == 0) cacheMut.signal();
+    }
+    cacheMut.unlock();
+}
+
+/*----------------------------------------------------------------------------
+ * fetchBlocks
+ *
+ *  reads a run of blocks from the underlying driver, caches them, and copies
+ *  the requested portion of them into data; returns the number of bytes copied
+ *----------------------------------------------------------------------------*/
+int64_t BlockCacheIODriver::fetchBlocks (uint64_t first_block, uint64_t num_blocks, uint8_t* data, int64_t size, uint64_t pos)
+{
+    uint64_t run_start = first_block * blockSize;
+    int64_t run_size = num_blocks * blockSize;
+    uint8_t* buffer = new uint8_t [run_size];
+
+    /* Read Run */
+    int64_t bytes_read = 0;
+    try
+    {
+        IODriver* io_driver = getDriver();
+        while(bytes_read < run_size)
+        {
+            int64_t requested = run_size - bytes_read;
+            int64_t bytes = io_driver->ioRead(&buffer[bytes_read], requested, run_start + bytes_read);
+            if(bytes <= 0) break;
+            bytes_read += bytes;
+            if(bytes < requested) break; // end of resource; reading past it fails on s3 (416)
+        }
+    }
+    catch(const RunTimeException&)
+    {
+        delete [] buffer;
+        throw;
+    }
+
+    /* Count Blocks Fetched */
+    cacheMut.lock();
+    {
+        blockMisses += (bytes_read + blockSize - 1) / blockSize;
+    }
+    cacheMut.unlock();
+
+    /* Cache Blocks */
+    for(uint64_t i = 0; i < num_blocks; i++)
+    {
+        int64_t block_offset = i * blockSize;
+        int64_t block_size = MIN(blockSize, bytes_read - block_offset);
+        if(block_size <= 0) break;
+        storeBlock(first_block + i, &buffer[block_offset], block_size);
+    }
+
+    /* Copy Requested Data */
+    uint64_t copy_start = MAX(pos, run_start);
+    uint64_t copy_end = MIN(pos + size, run_start + bytes_read);
+    int64_t copy_size = copy_end > copy_start ? copy_end - copy_start : 0;
+    if(copy_size > 0) memcpy(&data[copy_start - pos], &buffer[copy_start - run_start], copy_size);
+
+    delete [] buffer;
+    return copy_size;
+}
+
+/*----------------------------------------------------------------------------
+ * closeCache - must be called with cacheMut locked
+ *
+ *  waits for the pinned reads and writes so their file descriptors and
+ *  slots are not reused while they are in progress
+ *----------------------------------------------------------------------------*/
+void BlockCacheIODriver::closeCache (void)
+{
+    while(slotPins > 0) cacheMut.wait(0, SYS_TIMEOUT);
+
+    if(indexFd >= 0) close(indexFd);
+    if(dataFd >= 0) close(dataFd);
+    indexFd = -1;
+    dataFd = -1;
+
+    delete [] cacheRoot;
+    delete [] slots;
+    delete [] slotGeneration;
+    delete [] freeSlots;
+    delete lru;
+    cacheRoot = NULL;
+    slots = NULL;
+    slotGeneration = NULL;
+    freeSlots = NULL;
+    lru = NULL;
+    numSlots = 0;
+    numFree = 0;
+    blockLookUp.clear();
+}
@@ -0,0 +1,165 @@
+/*
+ * Copyright (c) 2021, University of Washington
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the University of Washington nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE UNIVERSITY OF WASHINGTON AND CONTRIBUTORS
+ * “AS IS” AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE UNIVERSITY OF WASHINGTON OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __block_cache_io_driver__
+#define __block_cache_io_driver__
+
+/******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+
+#include "OsApi.h"
+#include "Asset.h"
+#include "Dictionary.h"
+#include "Table.h"
+#include "LuaEngine.h"
+
+/******************************************************************************
+ * BLOCK CACHE IO DRIVER CLASS
+ ******************************************************************************/
+
+/*
+ * Caches fixed size blocks of the resources read through any other I/O driver
+ * in a single data file on local disk.  The data file holds a fixed number of
+ * block slots (the capacity of the cache divided by the block size) and an
+ * index file records which block of which resource is held in each slot, so
+ * the contents of the cache survive a restart.  Least recently used blocks
+ * are replaced first; only the blocks a read touches are ever fetched from
+ * the underlying driver.  Each block is stored with the version the
+ * underlying driver reports for its resource (e.g. the ETag of an S3 object)
+ * and is dropped instead of read once the resource changes.
+ */
+class BlockCacheIODriver: public Asset::IODriver
+{
+    public:
+
+        /*--------------------------------------------------------------------
+         * Constants
+         *--------------------------------------------------------------------*/
+
+        static const char*      DEFAULT_CACHE_ROOT;
+        static const int64_t    DEFAULT_CACHE_SIZE = 0x40000000; // 1GB
+        static const int64_t    DEFAULT_BLOCK_SIZE = 0x100000; // 1MB
+        static const int        MAX_KEY_SIZE = 256;
+
+        /*--------------------------------------------------------------------
+         * Methods
+         *--------------------------------------------------------------------*/
+
+        static void         deinit          (void);
+        static IODriver*    create          (const Asset* _asset, const char* resource);
+        static int          luaCreateCache  (lua_State* L);
+        static int          luaUncacheFormat(lua_State* L);
+        static int          luaCacheStats   (lua_State* L);
+        static bool         createCache     (const char* cache_root=DEFAULT_CACHE_ROOT, int64_t capacity=DEFAULT_CACHE_SIZE, int64_t block_size=DEFAULT_BLOCK_SIZE);
+        static bool         cacheFormat     (const char* format);
+        static bool         uncacheFormat   (const char* format);
+        int64_t             ioRead          (uint8_t* data, int64_t size, uint64_t pos) override;
+
+    private:
+
+        /*--------------------------------------------------------------------
+         * Constants
+         *--------------------------------------------------------------------*/
+
+        static const uint64_t   INDEX_MAGIC = 0x32584449434B4C42LL; // "BLKCIDX2"
+        static const char*      INDEX_FILENAME;
+        static const char*      DATA_FILENAME;
+
+        /*--------------------------------------------------------------------
+         * Types
+         *--------------------------------------------------------------------*/
+
+        typedef struct {
+            uint64_t    magic;
+            int64_t     block_size;
+            int64_t     num_slots;
+        } index_header_t;
+
+        typedef struct {
+            char        key[MAX_KEY_SIZE];  // resource the block belongs to
+            uint64_t    block;              // block number within resource
+            int64_t     size;               // number of valid bytes in block (0 if slot is empty)
+            uint64_t    sequence;           // order blocks were last used in, restores replacement order on restart
+            char        version[MAX_VERSION_SIZE]; // version of resource the block was read from
+        } slot_t;
+
+        typedef Table<int64_t, uint64_t> lru_t;
+
+        /*--------------------------------------------------------------------
+         * Methods
+         *--------------------------------------------------------------------*/
+
+                            BlockCacheIODriver  (const Asset* _asset, const char* resource, Asset::io_driver_f _factory);
+                            ~BlockCacheIODriver (void);
+
+        IODriver*           getDriver           (void);
+        bool                lookupBlock         (uint64_t block, int64_t* slot, int64_t* size, uint64_t* generation);
+        bool                releaseBlock        (int64_t slot, uint64_t generation);
+        static void         dropBlock           (int64_t slot);
+        static void         writeSlot           (int64_t slot);
+        void                storeBlock          (uint64_t block, const uint8_t* buffer, int64_t size);
+        int64_t             fetchBlocks         (uint64_t first_block, uint64_t num_blocks, uint8_t* data, int64_t size, uint64_t pos);
+        static void         closeCache          (void);
+
+        /*--------------------------------------------------------------------
+         * Data
+         *--------------------------------------------------------------------*/
+
+        static Cond                             cacheMut;
+        static const char*                      cacheRoot;
+        static int64_t                          blockSize;
+        static int64_t                          numSlots;
+        static int                              dataFd;
+        static int                              indexFd;
+        static slot_t*                          slots;
+        static uint64_t*                        slotGeneration; // incremented each time a slot is reused
+        static int64_t                          slotPins; // reads and writes of the cache files in progress
+        static int64_t*                         freeSlots;
+        static int64_t                          numFree;
+        static uint64_t                         sequence;
+        static lru_t*                           lru;
+        static Dictionary<int64_t>              blockLookUp; // <key>#<block> --> slot
+        static Dictionary<Asset::io_driver_t>   cachedFormats; // format --> driver being cached
+        static int64_t                          blockHits; // blocks read from the cache
+        static int64_t                          blockMisses; // blocks fetched from the underlying driver
+
+        const Asset*                            asset;
+        const char*                             resource;
+        char                                    cacheKey[MAX_KEY_SIZE];
+        char                                    version[MAX_VERSION_SIZE];
+        bool                                    versionKnown;
+        bool                                    cacheable;
+        Asset::io_driver_f                      factory;
+        IODriver*                               driver;
+};
+
+#endif  /* __block_cache_io_driver__ */
@@ -56,6 +56,44 @@
  */
 static Publisher* outq;
 
+/*
+ * Events are written by the thread generating them into a ring buffer owned
+ * by that thread, and are posted to the output queue by a collector thread.
+ * Each ring has a single producer (the owning thread) and a single consumer
+ * (the collector), so head and tail are the only synchronization needed.
+ * Rings are never freed; when a thread exits its ring is returned to the
+ * pool and picked up by the next thread that needs one. The collector waits
+ * on a condition when the rings are empty and producers only signal it when
+ * it is idle, so an active collector costs producers nothing.
+ */
+typedef struct {
+    std::atomic<uint32_t>   head;       // bytes written, updated by producer
+    std::atomic<uint32_t>   tail;       // bytes read, updated by collector
+    std::atomic<bool>       in_use;     // owned by a thread
+    uint8_t                 buffer[EventLib::EVENT_RING_SIZE];
+} event_ring_t;
+
+struct event_ring_owner_t
+{
+    event_ring_t* ring;
+    event_ring_owner_t(void): ring(NULL) {}
+    ~event_ring_owner_t(void) { if(ring) ring->in_use.store(false, std::memory_order_release); }
+};
+
+static const uint32_t EVENT_RING_MASK = EventLib::EVENT_RING_SIZE - 1;
+static const uint32_t EVENT_RING_PAD = 0xFFFFFFFF; // rest of ring is unused, wrap to start
+
+static event_ring_t* event_rings[EventLib::MAX_EVENT_RINGS];
+static std::atomic<int> num_event_rings{0};
+static Mutex event_ring_mut;
+static thread_local event_ring_owner_t event_ring_owner;
+
+static Thread* collector_pid = NULL;
+static std::atomic<bool> collector_active{false};
+static std::atomic<bool> collector_idle{false};
+static Cond collector_cond;
+static std::atomic<uint64_t> events_dropped{0};
+
 static RecordObject::fieldDef_t rec_def[] =
 {
     {"time",    RecordObject::INT64,    offsetof(EventLib::event_t, systime), 1,                        NULL, NATIVE_FLAGS},
@@ -106,6 +144,10 @@ void EventLib::init (const char* eventq)
 
     /* Create Output Q */
     outq = new Publisher(eventq);
+
+    /* Start Collector */
+    collector_active = true;
+    collector_pid = new Thread(collectorThread, NULL);
 }
 
 /*----------------------------------------------------------------------------
@@ -113,6 +155,19 @@ void EventLib::init (const char* eventq)
  *----------------------------------------------------------------------------*/
 void EventLib::deinit (void)
 {
+    /* Stop Collector (drains remaining events) */
+    collector_active = false;
+    collector_cond.lock();
+    {
+        collector_cond.signal();
+    }
+    collector_cond.unlock();
+    delete collector_pid;
+    collector_pid = NULL;
+
+    /* Post Events Written While Collector Was Stopping */
+    drainEvents();
+
     /* Cleanup Output Q */
     delete outq;
 }
@@ -217,7 +272,7 @@ uint32_t EventLib::startTrace(uint32_t parent, const char* name, event_level_t l
     /* Initialize Trace */
     event.systime   = TimeLib::latchtime() * 1000000; // us
     event.tid       = Thread::getId();
-    event.id        = trace_id++;;
+    event.id        = trace_id.fetch_add(1, std::memory_order_relaxed);
     event.parent    = parent;
     event.flags     = START;
     event.type      = TRACE;
@@ -225,9 +280,6 @@ uint32_t EventLib::startTrace(uint32_t parent, const char* name, event_level_t l
     event.name[0]   = '\0';
     event.attr[0]   = '\0';
 
-    /* Copy IP Address */
-    StringLib::copy(event.ipv4, SockLib::sockipv4(), SockLib::IPV4_STR_LEN);
-
     /* Copy Name */
     StringLib::copy(event.name, name, MAX_NAME_SIZE);
 
@@ -240,7 +292,7 @@ uint32_t EventLib::startTrace(uint32_t parent, const char* name, event_level_t l
     va_end(args);
 
     /* Send Event */
-    sendEvent(&event, attr_size);
+    queueEvent(&event, attr_size);
 
     /* Return Trace ID */
     return event.id;
@@ -267,11 +319,8 @@ void EventLib::stopTrace(uint32_t id, event_level_t lvl)
     event.name[0]   = '\0';
     event.attr[0]   = '\0';
 
-    /* Copy IP Address */
-    StringLib::copy(event.ipv4, SockLib::sockipv4(), SockLib::IPV4_STR_LEN);
-
     /* Send Event */
-    sendEvent(&event, 1);
+    queueEvent(&event, 1);
 }
 
 /*----------------------------------------------------------------------------
@@ -309,9 +358,6 @@ void EventLib::logMsg(const char* file_name, unsigned int line_number, event_lev
     event.type      = LOG;
     event.level     = lvl;
 
-    /* Copy IP Address */
-    StringLib::copy(event.ipv4, SockLib::sockipv4(), SockLib::IPV4_STR_LEN);
-
     /* Build Name - <Filename>:<Line Number> */
     const char* last_path_delimeter = StringLib::find(file_name, PATH_DELIMETER, false);
     const char* file_name_only = last_path_delimeter ? last_path_delimeter + 1 : file_name;
@@ -326,7 +372,7 @@ void EventLib::logMsg(const char* file_name, unsigned int line_number, event_lev
     va_end(args);
 
     /* Post Log Message */
-    sendEvent(&event, attr_size);
+    queueEvent(&event, attr_size);
 }
 
 /*----------------------------------------------------------------------------
@@ -348,16 +394,23 @@ void EventLib::generateMetric (event_level_t lvl, const char* name, metric_subty
     event.type      = METRIC;
     event.level     = lvl;
 
-    /* Copy IP Address */
-    StringLib::copy(event.ipv4, SockLib::sockipv4(), SockLib::IPV4_STR_LEN);
-
     /* Populate Name and Populate Attribute */
     StringLib::copy(event.name, name, MAX_NAME_SIZE);
     StringLib::formats(event.attr, MAX_ATTR_SIZE, "%lf", value);
 
     /* Post Metric */
     int attr_size = StringLib::size(event.attr) + 1;
-    sendEvent(&event, attr_size);
+    queueEvent(&event, attr_size);
+}
+
+/*----------------------------------------------------------------------------
+ * droppedEvents
+ *
+ *  number of events dropped because the ring of the thread was full
+ *----------------------------------------------------------------------------*/
+uint64_t EventLib::droppedEvents (void)
+{
+    return events_dropped.load(std::memory_order_relaxed);
 }
 
 /*----------------------------------------------------------------------------
@@ -369,5 +422,238 @@ int EventLib::sendEvent (event_t* event, int attr_size)
     RecordObject record(rec_type, event_record_size, false);
     event_t* data = (event_t*)record.getRecordData();
     memcpy(data, event, event_record_size);
+    StringLib::copy(data->ipv4, SockLib::sockipv4(), SockLib::IPV4_STR_LEN);
     return record.post(outq, 0, NULL, false);
 }
+
+/*----------------------------------------------------------------------------
+ * queueEvent
+ *
+ *  writes the event into the calling thread's ring for the collector to
+ *  post; falls back to posting it directly when there is no collector or
+ *  no ring available; when the ring is full the event is dropped and
+ *  counted, since posting it directly would put it ahead of the events
+ *  already in the ring - except for logged errors, which wait for the
+ *  collector to make room and are posted directly (out of order) only if
+ *  it does not within the timeout
+ *----------------------------------------------------------------------------*/
+void EventLib::queueEvent (event_t* event, int attr_size)
+{
+    event_ring_t* ring = event_ring_owner.ring;
+
+    /* Get Ring for Thread */
+    if(!ring && collector_active)
+    {
+        /* Reuse Ring Released by Exited Thread */
+        int num_rings = num_event_rings.load(std::memory_order_acquire);
+        for(int i = 0; i < num_rings && !ring; i++)
+        {
+            bool in_use = false;
+            if(event_rings[i]->in_use.compare_exchange_strong(in_use, true, std::memory_order_acquire))
+            {
+                ring = event_rings[i];
+            }
+        }
+
+        /* Allocate New Ring */
+        if(!ring)
+        {
+            event_ring_mut.lock();
+            {
+                num_rings = num_event_rings.load(std::memory_order_relaxed);
+                if(num_rings < MAX_EVENT_RINGS)
+                {
+                    ring = new event_ring_t;
+                    ring->head = 0;
+                    ring->tail = 0;
+                    ring->in_use = true;
+                    event_rings[num_rings] = ring;
+                    num_event_rings.store(num_rings + 1, std::memory_order_release);
+                }
+            }
+            event_ring_mut.unlock();
+        }
+
+        event_ring_owner.ring = ring;
+    }
+
+    /* Write Event to Ring */
+    if(ring && collector_active)
+    {
+        uint32_t event_size = offsetof(event_t, attr) + attr_size;
+        uint32_t entry_size = (sizeof(uint32_t) + event_size + 7) & ~7; // keep entries 8-byte aligned
+        uint32_t head = ring->head.load(std::memory_order_relaxed);
+        uint32_t tail = ring->tail.load(std::memory_order_acquire);
+        uint32_t pos = head & EVENT_RING_MASK;
+        uint32_t contiguous = EVENT_RING_SIZE - pos;
+        uint32_t pad_size = (contiguous < entry_size) ? contiguous : 0;
+        if(EVENT_RING_SIZE - (head - tail) < pad_size + entry_size)
+        {
+            /* Drop Event (unless it is a logged error) */
+            if(event->type != LOG || event->level < ERROR)
+            {
+                events_dropped.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+
+            /* Wait for Collector to Make Room */
+            int waited_ms = 0;
+            while(collector_active && (EVENT_RING_SIZE - (head - tail) < pad_size + entry_size) && (waited_ms++ < SYS_TIMEOUT))
+            {
+                wakeCollector();
+                OsApi::sleep(0.001);
+                tail = ring->tail.load(std::memory_order_acquire);
+            }
+
+            /* Post Event Directly if Still Full */
+            if(EVENT_RING_SIZE - (head - tail) < pad_size + entry_size)
+            {
+                sendEvent(event, attr_size);
+                return;
+            }
+        }
+
+        if(pad_size > 0)
+        {
+            memcpy(&ring->buffer[pos], &EVENT_RING_PAD, sizeof(uint32_t));
+            head += pad_size;
+            pos = 0;
+        }
+        memcpy(&ring->buffer[pos], &event_size, sizeof(uint32_t));
+        memcpy(&ring->buffer[pos + sizeof(uint32_t)], event, event_size);
+        ring->head.store(head + entry_size, std::memory_order_release);
+
+        /* Wake Collector if Idle
+         *  pairs with the fence in collectorThread: either the collector
+         *  sees the new head before waiting or this thread sees it idle */
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if(collector_idle.load(std::memory_order_relaxed))
+        {
+            wakeCollector();
+        }
+        return;
+    }
+
+    /* Post Event Directly */
+    sendEvent(event, attr_size);
+}
+
+/*----------------------------------------------------------------------------
+ * wakeCollector
+ *----------------------------------------------------------------------------*/
+void EventLib::wakeCollector (void)
+{
+    collector_cond.lock();
+    {
+        collector_cond.signal();
+    }
+    collector_cond.unlock();
+}
+
+/*----------------------------------------------------------------------------
+ * drainEvents
+ *
+ *  posts every event currently in the rings, returns number of events posted
+ *----------------------------------------------------------------------------*/
+int EventLib::drainEvents (void)
+{
+    static const int max_event_size = offsetof(event_t, attr) + MAX_ATTR_SIZE;
+    RecordObject record(rec_type, max_event_size, false);
+    event_t* data = (event_t*)record.getRecordData();
+    StringLib::copy(data->ipv4, SockLib::sockipv4(), SockLib::IPV4_STR_LEN);
+
+    int events_posted = 0;
+    int num_rings = num_event_rings.load(std::memory_order_acquire);
+    for(int i = 0; i < num_rings; i++)
+    {
+        event_ring_t* ring = event_rings[i];
+        uint32_t tail = ring->tail.load(std::memory_order_relaxed);
+        uint32_t head = ring->head.load(std::memory_order_acquire);
+        while(tail != head)
+        {
+            uint32_t pos = tail & EVENT_RING_MASK;
+            uint32_t event_size;
+            memcpy(&event_size, &ring->buffer[pos], sizeof(uint32_t));
+            if(event_size == EVENT_RING_PAD)
+            {
+                tail += EVENT_RING_SIZE - pos;
+                continue;
+            }
+
+            /* Post Event (ip address is filled in once above) */
+            int ipv4_offset = offsetof(event_t, ipv4);
+            int name_offset = offsetof(event_t, name);
+            const uint8_t* event = &ring->buffer[pos + sizeof(uint32_t)];
+            memcpy(data, event, ipv4_offset);
+            memcpy((uint8_t*)data + name_offset, event + name_offset, event_size - name_offset);
+            uint8_t* rec_buf = NULL;
+            int rec_bytes = record.serialize(&rec_buf, RecordObject::REFERENCE, event_size);
+            outq->postCopy(rec_buf, rec_bytes, IO_PEND);
+            events_posted++;
+
+            tail += (sizeof(uint32_t) + event_size + 7) & ~7;
+        }
+        ring->tail.store(tail, std::memory_order_release);
+    }
+
+    return events_posted;
+}
+
+/*----------------------------------------------------------------------------
+ * pendingEvents
+ *----------------------------------------------------------------------------*/
+bool EventLib::pendingEvents (void)
+{
+    int num_rings = num_event_rings.load(std::memory_order_acquire);
+    for(int i = 0; i < num_rings; i++)
+    {
+        event_ring_t* ring = event_rings[i];
+        if(ring->head.load(std::memory_order_acquire) != ring->tail.load(std::memory_order_relaxed))
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/*----------------------------------------------------------------------------
+ * collectorThread
+ *----------------------------------------------------------------------------*/
+void* EventLib::collectorThread (void* parm)
+{
+    (void)parm;
+
+    uint64_t dropped_reported = 0;
+    while(collector_active)
+    {
+        /* Wait for Events */
+        if(drainEvents() == 0)
+        {
+            collector_cond.lock();
+            {
+                collector_idle.store(true, std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                if(collector_active && !pendingEvents())
+                {
+                    collector_cond.wait(0, SYS_TIMEOUT);
+                }
+                collector_idle.store(false, std::memory_order_relaxed);
+            }
+            collector_cond.unlock();
+        }
+
+        /* Report Dropped Events */
+        uint64_t dropped = events_dropped.load(std::memory_order_relaxed);
+        if(dropped != dropped_reported)
+        {
+            mlog(WARNING, "Dropped %lu events from full event rings", (unsigned long)(dropped - dropped_reported));
+            dropped_reported = dropped;
+        }
+    }
+
+    /* Post Events Queued Before Stopping */
+    drainEvents();
+
+    return NULL;
+}
@@ -74,6 +74,8 @@ class EventLib
         static const int MAX_NAME_SIZE = 32;
         static const int MAX_ATTR_SIZE = 1024;
         static const int MAX_METRICS = 128;
+        static const int EVENT_RING_SIZE = 0x20000; // bytes per thread (over 100 events of maximum size), must be a power of two
+        static const int MAX_EVENT_RINGS = 1024;
         static const int32_t INVALID_METRIC = -1;
 
         static const char* rec_type;
@@ -134,6 +136,8 @@ class EventLib
 
         static void             generateMetric  (event_level_t lvl, const char* name, metric_subtype_t subtype, double value);
 
+        static uint64_t         droppedEvents   (void);
+
     private:
 
         /*--------------------------------------------------------------------
@@ -141,6 +145,11 @@ class EventLib
          *--------------------------------------------------------------------*/
 
         static int              sendEvent       (event_t* event, int attr_size);
+        static void             queueEvent      (event_t* event, int attr_size);
+        static void             wakeCollector   (void);
+        static int              drainEvents     (void);
+        static bool             pendingEvents   (void);
+        static void*            collectorThread (void* parm);
 
         /*--------------------------------------------------------------------
          * Data
@@ -33,9 +33,13 @@
  * INCLUDES
  ******************************************************************************/
 
+#include <sys/stat.h>
+#include <errno.h>
+
 #include "FileIODriver.h"
 #include "OsApi.h"
 #include "Asset.h"
+#include "StringLib.h"
 
 /******************************************************************************
  * STATIC DATA
@@ -70,12 +74,28 @@ int64_t FileIODriver::ioRead (uint8_t* data, int64_t size, uint64_t pos)
     return fread(data, 1, size, ioFile);
 }
 
+/*----------------------------------------------------------------------------
+ * ioVersion - size and modification time of the file
+ *----------------------------------------------------------------------------*/
+const char* FileIODriver::ioVersion (void)
+{
+    struct stat info;
+    if(fstat(fileno(ioFile), &info) != 0)
+    {
+        throw RunTimeException(CRITICAL, RTE_ERROR, "failed to get status of resource: %s", strerror(errno));
+    }
+
+    StringLib::format(version, MAX_VERSION_SIZE, "%ld:%ld.%09ld", (long)info.st_size, (long)info.st_mtim.tv_sec, (long)info.st_mtim.tv_nsec);
+    return version;
+}
+
 /*----------------------------------------------------------------------------
  * Constructor
  *----------------------------------------------------------------------------*/
 FileIODriver::FileIODriver (const Asset* _asset, const char* resource):
     asset(_asset)
 {
+    version[0] = '\0';
     FString filepath("%s/%s", asset->getPath(), resource);
     ioFile = fopen(filepath.c_str(), "r");
     if(ioFile == NULL)
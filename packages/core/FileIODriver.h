@@ -57,8 +57,9 @@ class FileIODriver: Asset::IODriver
          * Methods
          *--------------------------------------------------------------------*/
 
-        static IODriver*    create  (const Asset* _asset, const char* resource);
-        int64_t             ioRead  (uint8_t* data, int64_t size, uint64_t pos) override;
+        static IODriver*    create      (const Asset* _asset, const char* resource);
+        int64_t             ioRead      (uint8_t* data, int64_t size, uint64_t pos) override;
+        const char*         ioVersion   (void) override;
 
     private:
 
@@ -75,6 +76,7 @@ class FileIODriver: Asset::IODriver
 
         const Asset*    asset;
         fileptr_t       ioFile;
+        char            version[MAX_VERSION_SIZE];
 };
 
 #endif  /* __file_io_driver__ */
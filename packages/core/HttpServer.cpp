@@ -47,6 +47,7 @@ const char* HttpServer::LUA_META_NAME = "HttpServer";
 const struct luaL_Reg HttpServer::LUA_META_TABLE[] = {
     {"attach",      luaAttach},
     {"untilup",     luaUntilUp},
+    {"compression", luaCompression},
     {NULL,          NULL}
 };
 
@@ -99,6 +100,8 @@ HttpServer::HttpServer(lua_State* L, const char* _ip_addr, int _port, int max_co
     listenerPid = new Thread(listenerThread, this);
 
     metricId = EventLib::INVALID_METRIC;
+
+    compressStreams = false;
 }
 
 /*----------------------------------------------------------------------------
@@ -128,6 +131,14 @@ int HttpServer::getPort (void) const
     return port;
 }
 
+/*----------------------------------------------------------------------------
+ * setCompression
+ *----------------------------------------------------------------------------*/
+void HttpServer::setCompression (bool enable)
+{
+    compressStreams = enable;
+}
+
 /*----------------------------------------------------------------------------
  * Connection Constructor
  *----------------------------------------------------------------------------*/
@@ -151,17 +162,31 @@ HttpServer::Connection::Connection (const Connection& other)
  *----------------------------------------------------------------------------*/
 HttpServer::Connection::~Connection (void)
 {
-    /* Free Stream Buffer */
-    delete [] rsps_state.stream_buf;
-
     /* Free Message Queue */
-    if(rsps_state.ref_status > 0)
+    if(rsps_state.stream_ref_cnt > 0)
+    {
+        for(int i = 0; i < rsps_state.stream_ref_cnt; i++)
+        {
+            rsps_state.rspq->dereference(rsps_state.stream_refs[i]);
+        }
+        rsps_state.stream_ref_cnt = 0;
+        rsps_state.ref_status = 0; // first stream reference is the current reference
+    }
+    else if(rsps_state.ref_status > 0 && !rsps_state.stream_end)
     {
         rsps_state.rspq->dereference(rsps_state.ref);
         rsps_state.ref_status = 0;
     }
     delete rsps_state.rspq;
 
+    /* Free Stream Encoder */
+    if(rsps_state.encoder)
+    {
+        count_metric(INFO, "http_stream.bytes_in", rsps_state.encoder->getBytesIn());
+        count_metric(INFO, "http_stream.bytes_out", rsps_state.encoder->getBytesOut());
+        delete rsps_state.encoder;
+    }
+
     /* Free Id */
     delete [] id;
     delete [] name;
@@ -185,6 +210,9 @@ void HttpServer::Connection::initialize (const char* _name)
     /* Default Keep Alive to False */
     keep_alive = false;
 
+    /* Default to No Content Encoding */
+    encoding = StreamEncoder::IDENTITY;
+
     /* Create Unique ID for Request */
     name = StringLib::duplicate(_name);
     id = new char [REQUEST_ID_LEN];
@@ -350,7 +378,7 @@ int HttpServer::pollHandler(int fd, short* events, void* parm)
     else *events &= ~IO_READ_FLAG;
 
     /* Set Write Polling Flag (if data to write) */
-    if(state->ref_status > 0) *events |= IO_WRITE_FLAG;
+    if(state->ref_status > 0 || state->stream_chunk_size > 0) *events |= IO_WRITE_FLAG;
     else *events &= ~IO_WRITE_FLAG;
 
     return 0;
@@ -474,6 +502,16 @@ int HttpServer::onRead(int fd)
                     {
                         connection->keep_alive = false;
                     }
+
+                    /* Get Accepted Content Encoding */
+                    if(compressStreams)
+                    {
+                        string* accept_encoding;
+                        if(connection->request->headers.find("accept-encoding", &accept_encoding))
+                        {
+                            connection->encoding = StreamEncoder::negotiate(accept_encoding->c_str());
+                        }
+                    }
                 }
                 else
                 {
@@ -531,80 +569,56 @@ int HttpServer::onWrite(int fd)
     uint32_t trace_id = start_trace(DEBUG, connection->trace_id, "on_write", "%s", "{}");
     
     /* If Something to Send */
-    if(state->ref_status > 0)
+    if(state->ref_status > 0 || state->stream_chunk_size > 0)
     {
-        bool ref_complete = false;
-        uint8_t* buffer;
-        int bytes_left;
-
-        if(state->header_sent && connection->response_type == EndpointObject::STREAMING) /* Setup Streaming */
+        if(state->header_sent && connection->response_type == EndpointObject::STREAMING)
         {
-            /* Allocate Streaming Buffer (if necessary) */
-            if(state->ref.size + STREAM_OVERHEAD_SIZE > state->stream_mem_size)
-            {
-                /* Delete Old Buffer */
-                delete [] state->stream_buf;
-
-                /* Allocate New Buffer */
-                state->stream_mem_size = state->ref.size + STREAM_OVERHEAD_SIZE;
-                state->stream_buf = new uint8_t [state->stream_mem_size];
-            }
-
-            /* Build Stream Buffer */
-            if(state->stream_buf_size == 0)
+            /* Write Streaming Data */
+            status = writeChunk(fd, state);
+        }
+        else
+        {
+            bool ref_complete = false;
+
+            /* Compress Stream
+             *  when compression is enabled the header of a streaming response
+             *  is sent without its terminating line break so that the vary
+             *  and content encoding headers can be added in front of the
+             *  first chunk */
+            if( compressStreams && !state->header_sent && (state->ref_index == 0) && !state->header_pending &&
+                (connection->response_type == EndpointObject::STREAMING) &&
+                (state->ref.size >= 4) && (memcmp(((uint8_t*)state->ref.data) + state->ref.size - 4, "\r\n\r\n", 4) == 0) )
             {
-                /* Write Chunk Header - HTTP */
-                unsigned long chunk_size = state->ref.size > 0 ? state->ref.size : 0;
-                StringLib::format((char*)state->stream_buf, STREAM_OVERHEAD_SIZE, "%lX\r\n", chunk_size);
-                state->stream_buf_size = StringLib::size((const char*)state->stream_buf);
-
-                if(state->ref.size > 0)
+                if(connection->encoding != StreamEncoder::IDENTITY)
                 {
-                    /* Write Message Data */
-                    memcpy(&state->stream_buf[state->stream_buf_size], state->ref.data, state->ref.size);
-                    state->stream_buf_size += state->ref.size;
+                    try
+                    {
+                        state->encoder = new StreamEncoder(connection->encoding);
+                        state->stream_flush_time = TimeLib::latchtime();
+                    }
+                    catch(const RunTimeException& e)
+                    {
+                        mlog(e.level(), "Failed to compress stream for %s: %s", connection->id, e.what());
+                    }
                 }
-
-                /* Write Chunk Trailer - HTTP */
-                StringLib::format((char*)&state->stream_buf[state->stream_buf_size], STREAM_OVERHEAD_SIZE, "\r\n");
-                state->stream_buf_size += 2;
+                state->header_pending = true;
+                state->ref.size -= 2;
             }
 
             /* Setup Write State */
-            buffer = &state->stream_buf[state->stream_buf_index];
-            bytes_left = state->stream_buf_size - state->stream_buf_index;
-        }
-        else /* Setup Normal */
-        {
-            /* Setup Write State */
-            buffer = ((uint8_t*)state->ref.data) + state->ref_index;
-            bytes_left = state->ref.size - state->ref_index;
-        }
+            uint8_t* buffer = ((uint8_t*)state->ref.data) + state->ref_index;
+            int bytes_left = state->ref.size - state->ref_index;
 
-        /* If Anything Left to Send */
-        if(bytes_left > 0)
-        {
-            /* Write Data to Socket */
-            int bytes = SockLib::socksend(fd, buffer, bytes_left, IO_CHECK);
-            if(bytes >= 0)
+            /* If Anything Left to Send */
+            if(bytes_left > 0)
             {
-                /* Update Status */
-                status += bytes;
-
-                /* Update Write State */
-                if(state->header_sent && connection->response_type == EndpointObject::STREAMING)
-                {
-                    /* Update Streaming Write State */
-                    state->stream_buf_index += bytes;
-                    if(state->stream_buf_index == state->stream_buf_size)
-                    {
-                        state->stream_buf_index = 0;
-                        state->stream_buf_size = 0;
-                        ref_complete = true;
-                    }
-                }
-                else
+                /* Write Data to Socket */
+                int bytes = SockLib::socksend(fd, buffer, bytes_left, IO_CHECK);
+                if(bytes >= 0)
                 {
+                    /* Update Status */
+                    status += bytes;
+
                     /* Update Normal Write State
                     *  note that this code will be executed once for the
                     *  header of a streaming write as well */
@@ -615,31 +629,31 @@ int HttpServer::onWrite(int fd)
                         ref_complete = true;
                     }
                 }
+                else
+                {
+                    /* Failed to Write Ready Socket */
+                    status = INVALID_RC; // will close socket
+                }
             }
-            else
+
+            /* Check if Done with Entire Response
+             *  a valid reference of size zero indicates that
+             *  the response is complete */
+            if(state->ref.size == 0)
             {
-                /* Failed to Write Ready Socket */
+                ref_complete = true; // logic is skipped above on terminating message
+                state->response_complete = true; // prevent further messages received
                 status = INVALID_RC; // will close socket
             }
-        }
 
-        /* Check if Done with Entire Response
-         *  a valid reference of size zero indicates that
-         *  the response is complete */
-        if(state->ref.size == 0)
-        {
-            ref_complete = true; // logic is skipped above on terminating message
-            state->response_complete = true; // prevent further messages received
-            status = INVALID_RC; // will close socket
-        }
-
-        /* Reset State */
-        if(ref_complete)
-        {
-            state->rspq->dereference(state->ref);
-            state->ref_status = 0;
-            state->ref_index = 0;
-            state->ref.size = 0;
+            /* Reset State */
+            if(ref_complete)
+            {
+                state->rspq->dereference(state->ref);
+                state->ref_status = 0;
+                state->ref_index = 0;
+                state->ref.size = 0;
+            }
         }
 
         /* Check for Keep Alive */
@@ -666,6 +680,272 @@ int HttpServer::onWrite(int fd)
     return status;
 }
 
+/*----------------------------------------------------------------------------
+ * writeChunk
+ *
+ *  Notes: sends the current reference, along with any other messages already
+ *  waiting on the response queue, as a single HTTP chunk; the messages are
+ *  sent straight out of the queue and are not copied, unless the stream is
+ *  compressed in which case the compressed output is sent
+ *----------------------------------------------------------------------------*/
+int HttpServer::writeChunk(int fd, rsps_state_t* state)
+{
+    int status = 0;
+
+    /* Build Chunk */
+    if(state->stream_chunk_size == 0)
+    {
+        if(state->encoder)
+        {
+            if(encodeChunk(state) < 0) return INVALID_RC; // will close socket
+        }
+        else
+        {
+            buildChunk(state);
+        }
+
+        /* Nothing to Send (compressed data held until flushed) */
+        if(state->stream_chunk_size == 0) return 0;
+    }
+
+    /* Gather Chunk Segments */
+    const void* bufs[MAX_STREAM_REFS + 2];
+    int sizes[MAX_STREAM_REFS + 2];
+    int segments = 0;
+    bufs[segments] = state->stream_hdr;
+    sizes[segments++] = StringLib::size(state->stream_hdr);
+    if(state->encoder)
+    {
+        long payload_size;
+        bufs[segments] = state->encoder->getOutput(&payload_size);
+        sizes[segments++] = payload_size;
+    }
+    else
+    {
+        for(int i = 0; i < state->stream_ref_cnt; i++)
+        {
+            bufs[segments] = state->stream_refs[i].data;
+            sizes[segments++] = state->stream_refs[i].size;
+        }
+    }
+    bufs[segments] = state->stream_trl;
+    sizes[segments++] = StringLib::size(state->stream_trl);
+
+    /* Skip Part of Chunk Already Sent */
+    int count = 0;
+    long offset = state->stream_chunk_index;
+    for(int i = 0; i < segments; i++)
+    {
+        if(offset >= sizes[i])
+        {
+            offset -= sizes[i]; // already sent
+        }
+        else
+        {
+            bufs[count] = (const uint8_t*)bufs[i] + offset;
+            sizes[count] = sizes[i] - offset;
+            count++;
+            offset = 0;
+        }
+    }
+
+    /* Write Data to Socket */
+    int bytes = SockLib::socksendv(fd, bufs, sizes, count, IO_CHECK);
+    if(bytes >= 0)
+    {
+        status += bytes;
+        state->stream_chunk_index += bytes;
+    }
+    else
+    {
+        status = INVALID_RC; // will close socket
+    }
+
+    /* Release Messages in Completed Chunk */
+    if(state->stream_chunk_index == state->stream_chunk_size)
+    {
+        for(int i = 0; i < state->stream_ref_cnt; i++)
+        {
+            state->rspq->dereference(state->stream_refs[i]);
+        }
+        state->stream_ref_cnt = 0;
+        state->stream_chunk_size = 0;
+        state->ref_status = 0;
+        state->ref_index = 0;
+        state->ref.size = 0;
+
+        /* Release Compressed Output */
+        if(state->encoder)
+        {
+            state->encoder->clearOutput();
+            state->stream_flush_time = TimeLib::latchtime();
+        }
+
+        /* Check if Done with Entire Response */
+        if(state->stream_end)
+        {
+            state->response_complete = true; // prevent further messages received
+            status = INVALID_RC; // will close socket
+        }
+    }
+
+    return status;
+}
+
+/*----------------------------------------------------------------------------
+ * buildChunk
+ *
+ *  Notes: coalesces the current reference and any messages waiting on the
+ *  response queue into the next chunk
+ *----------------------------------------------------------------------------*/
+void HttpServer::buildChunk(rsps_state_t* state)
+{
+    long payload_size = 0;
+    Subscriber::msgRef_t ref = state->ref;
+    while(true)
+    {
+        if(ref.size == 0)
+        {
+            /* Terminating Message */
+            state->rspq->dereference(ref);
+            state->stream_end = true;
+            break;
+        }
+
+        /* Add Message to Chunk */
+        state->stream_refs[state->stream_ref_cnt++] = ref;
+        payload_size += ref.size;
+
+        /* Get Next Message */
+        if(state->stream_ref_cnt >= MAX_STREAM_REFS || payload_size >= STREAM_COALESCE_SIZE) break;
+        if(state->rspq->receiveRef(ref, IO_CHECK) <= 0) break;
+    }
+
+    /* Write Chunk Header and Trailer - HTTP
+     *  the first chunk completes the response header */
+    char pending_hdr[STREAM_OVERHEAD_SIZE];
+    const char* response_hdr = pendingHeader(state, pending_hdr);
+    if(payload_size > 0)
+    {
+        StringLib::format(state->stream_hdr, STREAM_OVERHEAD_SIZE, "%s%lX\r\n", response_hdr, payload_size);
+        StringLib::format(state->stream_trl, STREAM_OVERHEAD_SIZE, "\r\n%s", state->stream_end ? "0\r\n\r\n" : "");
+    }
+    else
+    {
+        StringLib::format(state->stream_hdr, STREAM_OVERHEAD_SIZE, "%s", response_hdr);
+        StringLib::format(state->stream_trl, STREAM_OVERHEAD_SIZE, "0\r\n\r\n");
+    }
+    state->stream_chunk_size = StringLib::size(state->stream_hdr) + payload_size + StringLib::size(state->stream_trl);
+    state->stream_chunk_index = 0;
+}
+
+/*----------------------------------------------------------------------------
+ * encodeChunk
+ *
+ *  Notes: compresses the current reference and any messages waiting on the
+ *  response queue; the messages are released as soon as they are compressed.
+ *  A chunk is only built once enough compressed output has accumulated, the
+ *  stream ends, or compressed data has been held for the flush period - this
+ *  bounds the latency added by the compressor when messages trickle in.
+ *  Returns INVALID_RC if the stream could not be compressed, in which case
+ *  the connection must be closed since the client cannot decode the rest of
+ *  the response
+ *----------------------------------------------------------------------------*/
+int HttpServer::encodeChunk(rsps_state_t* state)
+{
+    StreamEncoder* encoder = state->encoder;
+    long payload_size = 0;
+
+    /* Compress Messages */
+    if(state->ref_status > 0)
+    {
+        Subscriber::msgRef_t ref = state->ref;
+        while(true)
+        {
+            if(ref.size == 0)
+            {
+                /* Terminating Message */
+                state->rspq->dereference(ref);
+                state->stream_end = true;
+                break;
+            }
+
+            /* Add Message to Compressor */
+            bool compressed = encoder->write(ref.data, ref.size);
+            state->rspq->dereference(ref);
+            if(!compressed)
+            {
+                mlog(CRITICAL, "Failed to compress %d byte message in stream", ref.size);
+                state->ref_status = 0;
+                state->ref.size = 0;
+                return INVALID_RC;
+            }
+
+            /* Get Next Message */
+            encoder->getOutput(&payload_size);
+            if(payload_size >= STREAM_COALESCE_SIZE) break;
+            if(state->rspq->receiveRef(ref, IO_CHECK) <= 0) break;
+        }
+        state->ref_status = 0;
+        state->ref_index = 0;
+        state->ref.size = 0;
+    }
+
+    /* Flush Compressor */
+    bool flushed = false;
+    if(state->stream_end || (!encoder->isFlushed() && ((TimeLib::latchtime() - state->stream_flush_time) * 1000.0 >= STREAM_FLUSH_PERIOD_MS)))
+    {
+        if(!encoder->flush(state->stream_end))
+        {
+            mlog(CRITICAL, "Failed to flush compressed stream");
+            return INVALID_RC;
+        }
+        flushed = true;
+    }
+
+    /* Hold Compressed Data */
+    encoder->getOutput(&payload_size);
+    if(!flushed && payload_size < STREAM_COALESCE_SIZE) return 0;
+
+    /* Write Chunk Header and Trailer - HTTP
+     *  the first chunk completes the response header */
+    char pending_hdr[STREAM_OVERHEAD_SIZE];
+    const char* response_hdr = pendingHeader(state, pending_hdr);
+    if(payload_size > 0)
+    {
+        StringLib::format(state->stream_hdr, STREAM_OVERHEAD_SIZE, "%s%lX\r\n", response_hdr, payload_size);
+        StringLib::format(state->stream_trl, STREAM_OVERHEAD_SIZE, "\r\n%s", state->stream_end ? "0\r\n\r\n" : "");
+    }
+    else
+    {
+        StringLib::format(state->stream_hdr, STREAM_OVERHEAD_SIZE, "%s", response_hdr);
+        StringLib::format(state->stream_trl, STREAM_OVERHEAD_SIZE, "%s", state->stream_end ? "0\r\n\r\n" : "");
+    }
+    state->stream_chunk_size = StringLib::size(state->stream_hdr) + payload_size + StringLib::size(state->stream_trl);
+    state->stream_chunk_index = 0;
+
+    return 0;
+}
+
+/*----------------------------------------------------------------------------
+ * pendingHeader
+ *
+ *  Notes: returns the header lines held back from a streaming response until
+ *  its first chunk (see onWrite), or an empty string once they have been sent
+ *----------------------------------------------------------------------------*/
+const char* HttpServer::pendingHeader(rsps_state_t* state, char* buf)
+{
+    if(!state->header_pending) return "";
+    state->header_pending = false;
+
+    if(state->encoder)
+    {
+        return StringLib::format(buf, STREAM_OVERHEAD_SIZE, "Vary: Accept-Encoding\r\nContent-Encoding: %s\r\n\r\n", StreamEncoder::encoding2str(state->encoder->getEncoding()));
+    }
+
+    return StringLib::format(buf, STREAM_OVERHEAD_SIZE, "Vary: Accept-Encoding\r\n\r\n");
+}
+
 /*----------------------------------------------------------------------------
  * onAlive
  *
@@ -673,15 +953,22 @@ int HttpServer::onWrite(int fd)
  *----------------------------------------------------------------------------*/
 int HttpServer::onAlive(int fd)
 {
+    int status = 0;
     Connection* connection = connections[fd];
     rsps_state_t* state = &connection->rsps_state;
 
-    if(!state->response_complete && state->ref_status <= 0)
+    if(!state->response_complete && state->ref_status <= 0 && state->stream_chunk_size == 0)
     {
         state->ref_status = state->rspq->receiveRef(state->ref, IO_CHECK);
+
+        /* Flush Compressed Data Held While Stream Idle */
+        if(state->ref_status <= 0 && state->encoder && state->header_sent)
+        {
+            status = encodeChunk(state); // will close socket on failure
+        }
     }
 
-    return 0;
+    return status;
 }
 
 /*----------------------------------------------------------------------------
@@ -791,3 +1078,34 @@ int HttpServer::luaUntilUp (lua_State* L)
     /* Return Status */
     return returnLuaStatus(L, status);
 }
+
+/*----------------------------------------------------------------------------
+ * luaCompression - :compression(<enable>)
+ *
+ *  compresses streamed responses using the content encoding negotiated with
+ *  the client through its Accept-Encoding header
+ *----------------------------------------------------------------------------*/
+int HttpServer::luaCompression (lua_State* L)
+{
+    bool status = false;
+
+    try
+    {
+        /* Get Self */
+        HttpServer* lua_obj = dynamic_cast<HttpServer*>(getLuaSelf(L, 1));
+
+        /* Get Parameters */
+        bool enable = getLuaBoolean(L, 2);
+
+        /* Set Compression */
+        lua_obj->setCompression(enable);
+        status = true;
+    }
+    catch(const RunTimeException& e)
+    {
+        mlog(e.level(), "Error setting stream compression: %s", e.what());
+    }
+
+    /* Return Status */
+    return returnLuaStatus(L, status);
+}
@@ -43,6 +43,7 @@
 #include "OsApi.h"
 #include "StringLib.h"
 #include "LuaObject.h"
+#include "StreamEncoder.h"
 #include "EndpointObject.h"
 
 /******************************************************************************
@@ -63,6 +64,9 @@ class HttpServer: public LuaObject
         static const int INITIAL_POLL_SIZE          = 16;
         static const int DEFAULT_MAX_CONNECTIONS    = 256;
         static const int STREAM_OVERHEAD_SIZE       = 128; // chunk size, record size, and line breaks
+        static const int MAX_STREAM_REFS            = 64; // messages coalesced into a single chunk
+        static const int STREAM_COALESCE_SIZE       = 0x100000; // bytes of messages coalesced into a single chunk
+        static const int STREAM_FLUSH_PERIOD_MS     = 250; // maximum time compressed data is held before being sent
 
         static const char* OBJECT_TYPE;
         static const char* LUA_META_NAME;
@@ -79,6 +83,7 @@ class HttpServer: public LuaObject
 
         const char*         getIpAddr       (void) const;
         int                 getPort         (void) const;
+        void                setCompression  (bool enable);
 
     private:
 
@@ -101,10 +106,16 @@ class HttpServer: public LuaObject
             int                         ref_status;
             int                         ref_index;
             Subscriber*                 rspq;
-            uint8_t*                    stream_buf;
-            int                         stream_buf_index;
-            int                         stream_buf_size;
-            int                         stream_mem_size;
+            Subscriber::msgRef_t        stream_refs[MAX_STREAM_REFS]; // messages in the chunk being sent
+            int                         stream_ref_cnt;
+            char                        stream_hdr[STREAM_OVERHEAD_SIZE]; // chunk size line
+            char                        stream_trl[STREAM_OVERHEAD_SIZE]; // chunk line break and terminating chunk
+            long                        stream_chunk_size;
+            long                        stream_chunk_index;
+            bool                        stream_end; // terminating message is part of the chunk
+            StreamEncoder*              encoder; // compresses stream when content encoding negotiated
+            bool                        header_pending; // vary and content encoding headers not yet sent
+            double                      stream_flush_time; // time compressed data was last sent
         } rsps_state_t;
 
         struct Connection {
@@ -118,6 +129,7 @@ class HttpServer: public LuaObject
             rqst_state_t                rqst_state;
             rsps_state_t                rsps_state;
             bool                        keep_alive;
+            StreamEncoder::encoding_t   encoding;
             EndpointObject::rsptype_t   response_type;
             EndpointObject::Request*    request;
         };
@@ -151,6 +163,8 @@ class HttpServer: public LuaObject
 
         int32_t                         metricId;
 
+        bool                            compressStreams;
+
         /*--------------------------------------------------------------------
          * Methods
          *--------------------------------------------------------------------*/
@@ -163,6 +177,10 @@ class HttpServer: public LuaObject
         static int          activeHandler       (int fd, int flags, void* parm);
         int                 onRead              (int fd);
         int                 onWrite             (int fd);
+        int                 writeChunk          (int fd, rsps_state_t* state);
+        void                buildChunk          (rsps_state_t* state);
+        int                 encodeChunk         (rsps_state_t* state);
+        static const char*  pendingHeader       (rsps_state_t* state, char* buf);
         int                 onAlive             (int fd);
         int                 onConnect           (int fd);
         int                 onDisconnect        (int fd);
@@ -170,6 +188,7 @@ class HttpServer: public LuaObject
         static int          luaAttach           (lua_State* L);
         static int          luaMetric           (lua_State* L);
         static int          luaUntilUp          (lua_State* L);
+        static int          luaCompression      (lua_State* L);
 };
 
 #endif  /* __http_server__ */
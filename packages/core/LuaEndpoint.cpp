@@ -43,6 +43,8 @@
 const char* LuaEndpoint::LUA_META_NAME = "LuaEndpoint";
 const struct luaL_Reg LuaEndpoint::LUA_META_TABLE[] = {
     {"auth",        luaAuth},
+    {"admission",   luaAdmission},
+    {"priority",    luaPriority},
     {NULL,          NULL}
 };
 
@@ -100,7 +102,7 @@ void LuaEndpoint::init (void)
 }
 
 /*----------------------------------------------------------------------------
- * luaCreate - endpoint([<normal memory threshold>], [<stream memory threshold>])
+ * luaCreate - endpoint([<normal memory threshold>], [<stream memory threshold>], [<log level>], [<pooled engines>])
  *----------------------------------------------------------------------------*/
 int LuaEndpoint::luaCreate (lua_State* L)
 {
@@ -110,9 +112,13 @@ int LuaEndpoint::luaCreate (lua_State* L)
         double normal_mem_thresh = getLuaFloat(L, 1, true, DEFAULT_NORMAL_REQUEST_MEMORY_THRESHOLD);
         double stream_mem_thresh = getLuaFloat(L, 2, true, DEFAULT_STREAM_REQUEST_MEMORY_THRESHOLD);
         event_level_t lvl = (event_level_t)getLuaInteger(L, 3, true, INFO);
+        long num_engines = getLuaInteger(L, 4, true, DEFAULT_ENGINE_POOL_SIZE);
+
+        /* Check Parameters */
+        if(num_engines < 0) throw RunTimeException(CRITICAL, RTE_ERROR, "invalid number of pooled engines: %ld", num_engines);
 
         /* Create Lua Endpoint */
-        return createLuaObject(L, new LuaEndpoint(L, normal_mem_thresh, stream_mem_thresh, lvl));
+        return createLuaObject(L, new LuaEndpoint(L, normal_mem_thresh, stream_mem_thresh, lvl, num_engines));
     }
     catch(const RunTimeException& e)
     {
@@ -151,13 +157,29 @@ void LuaEndpoint::generateExceptionStatus (int code, event_level_t level, Publis
 /*----------------------------------------------------------------------------
  * Constructor
  *----------------------------------------------------------------------------*/
-LuaEndpoint::LuaEndpoint(lua_State* L, double normal_mem_thresh, double stream_mem_thresh, event_level_t lvl):
+LuaEndpoint::LuaEndpoint(lua_State* L, double normal_mem_thresh, double stream_mem_thresh, event_level_t lvl, int num_engines):
     EndpointObject(L, LUA_META_NAME, LUA_META_TABLE),
     normalRequestMemoryThreshold(normal_mem_thresh),
     streamRequestMemoryThreshold(stream_mem_thresh),
     logLevel(lvl),
-    authenticator(NULL)
+    authenticator(NULL),
+    maxActiveRequests(DEFAULT_MAX_ACTIVE_REQUESTS),
+    maxQueuedRequests(DEFAULT_MAX_QUEUED_REQUESTS),
+    activeRequests(0),
+    pendingSeq(0)
 {
+    /* Pre-Warm Engine Pool */
+    enginePoolSize = num_engines;
+    enginePoolCnt = 0;
+    enginePool = NULL;
+    if(enginePoolSize > 0)
+    {
+        enginePool = new LuaEngine* [enginePoolSize];
+        while(enginePoolCnt < enginePoolSize)
+        {
+            enginePool[enginePoolCnt++] = new LuaEngine(NULL);
+        }
+    }
 }
 
 /*----------------------------------------------------------------------------
@@ -165,6 +187,32 @@ LuaEndpoint::LuaEndpoint(lua_State* L, double normal_mem_thresh, double stream_m
  *----------------------------------------------------------------------------*/
 LuaEndpoint::~LuaEndpoint(void)
 {
+    /* Drain Queued Requests */
+    pending_request_t pending;
+    bool drained = false;
+    while(!drained)
+    {
+        admissionMut.lock();
+        {
+            uint64_t key = pendingRequests.first(&pending);
+            if(key != (uint64_t)INVALID_KEY) pendingRequests.remove(key);
+            else drained = true;
+        }
+        admissionMut.unlock();
+
+        if(!drained)
+        {
+            mlog(WARNING, "Endpoint shutting down, rejecting queued request: %s %s", verb2str(pending.info->request->verb), pending.info->request->resource);
+            rejectRequest(pending.info);
+        }
+    }
+
+    /* Delete Idle Engines */
+    for(int i = 0; i < enginePoolCnt; i++)
+    {
+        delete enginePool[i];
+    }
+    delete [] enginePool;
 }
 
 /*----------------------------------------------------------------------------
@@ -243,7 +291,10 @@ void* LuaEndpoint::requestThread (void* parm)
 
     /* Stop Trace */
     stop_trace(INFO, trace_id);
-    
+
+    /* Start Next Queued Request */
+    lua_endpoint->finishRequest();
+
     /* Return */
     return NULL;
 }
@@ -257,18 +308,24 @@ EndpointObject::rsptype_t LuaEndpoint::handleRequest (Request* request)
     info->endpoint = this;
     info->request = request;
 
-    /* Start Thread */
-    Thread pid(requestThread, info, false);
+    /* Determine Response Type */
+    rsptype_t rsptype = (request->verb == POST) ? STREAMING : NORMAL;
+
+    /* Start or Queue Request */
+    if(!admitRequest(info))
+    {
+        mlog(WARNING, "Request queue full, rejecting request: %s %s", verb2str(request->verb), request->resource);
+        rejectRequest(info);
+    }
 
     /* Return Response Type */
-    if(request->verb == POST) return STREAMING;
-    return NORMAL;
+    return rsptype;
 }
 
 /*----------------------------------------------------------------------------
  * normalResponse
  *----------------------------------------------------------------------------*/
-void LuaEndpoint::normalResponse (const char* scriptpath, Request* request, Publisher* rspq, uint32_t trace_id) const
+void LuaEndpoint::normalResponse (const char* scriptpath, Request* request, Publisher* rspq, uint32_t trace_id)
 {
     char header[MAX_HDR_SIZE];
     double mem;
@@ -280,7 +337,7 @@ void LuaEndpoint::normalResponse (const char* scriptpath, Request* request, Publ
         ((mem = OsApi::memusage()) < normalRequestMemoryThreshold) )
     {
         /* Launch Engine */
-        engine = new LuaEngine(scriptpath, (const char*)request->body, trace_id, NULL, true);
+        engine = acquireEngine(scriptpath, (const char*)request->body, trace_id);
         bool status = engine->executeEngine(MAX_RESPONSE_TIME_MS);
 
         /* Send Response */
@@ -315,13 +372,13 @@ void LuaEndpoint::normalResponse (const char* scriptpath, Request* request, Publ
     }
 
     /* Clean Up */
-    delete engine;
+    if(engine) releaseEngine(engine);
 }
 
 /*----------------------------------------------------------------------------
  * streamResponse
  *----------------------------------------------------------------------------*/
-void LuaEndpoint::streamResponse (const char* scriptpath, Request* request, Publisher* rspq, uint32_t trace_id) const
+void LuaEndpoint::streamResponse (const char* scriptpath, Request* request, Publisher* rspq, uint32_t trace_id)
 {
     char header[MAX_HDR_SIZE];
     double mem;
@@ -337,7 +394,7 @@ void LuaEndpoint::streamResponse (const char* scriptpath, Request* request, Publ
         rspq->postCopy(header, header_length);
 
         /* Create Engine */
-        engine = new LuaEngine(scriptpath, (const char*)request->body, trace_id, NULL, true);
+        engine = acquireEngine(scriptpath, (const char*)request->body, trace_id);
 
         /* Supply Global Variables to Script */
         engine->setString(LUA_RESPONSE_QUEUE, rspq->getName());
@@ -356,9 +413,202 @@ void LuaEndpoint::streamResponse (const char* scriptpath, Request* request, Publ
     }
 
     /* Clean Up */
+    if(engine) releaseEngine(engine);
+}
+
+/*----------------------------------------------------------------------------
+ * acquireEngine
+ *
+ *  takes an idle engine from the pool, or creates a new one when the pool is
+ *  empty, and loads the script into it; the engine is returned paused
+ *----------------------------------------------------------------------------*/
+LuaEngine* LuaEndpoint::acquireEngine (const char* scriptpath, const char* arg, uint32_t trace_id)
+{
+    LuaEngine* engine = NULL;
+
+    enginePoolMut.lock();
+    {
+        if(enginePoolCnt > 0)
+        {
+            engine = enginePool[--enginePoolCnt];
+        }
+    }
+    enginePoolMut.unlock();
+
+    if(engine)
+    {
+        engine->reload(scriptpath, arg, trace_id);
+    }
+    else
+    {
+        engine = new LuaEngine(scriptpath, arg, trace_id, NULL, true);
+    }
+
+    return engine;
+}
+
+/*----------------------------------------------------------------------------
+ * releaseEngine
+ *
+ *  returns the engine to the pool if it finished its script and there is
+ *  room, otherwise deletes it
+ *----------------------------------------------------------------------------*/
+void LuaEndpoint::releaseEngine (LuaEngine* engine)
+{
+    if(engine->recycle())
+    {
+        enginePoolMut.lock();
+        {
+            if(enginePoolCnt < enginePoolSize)
+            {
+                enginePool[enginePoolCnt++] = engine;
+                engine = NULL;
+            }
+        }
+        enginePoolMut.unlock();
+    }
+
     delete engine;
 }
 
+/*----------------------------------------------------------------------------
+ * admitRequest
+ *
+ *  starts the request if there is a free slot, otherwise queues it behind
+ *  requests of equal or higher priority; returns false if the queue is full
+ *----------------------------------------------------------------------------*/
+bool LuaEndpoint::admitRequest (EndpointObject::info_t* info)
+{
+    /* Unlimited */
+    if(maxActiveRequests <= 0)
+    {
+        startRequest(info, 0.0);
+        return true;
+    }
+
+    /* Get Priority of Resource */
+    int priority = DEFAULT_PRIORITY;
+    resourcePriority.find(info->request->resource, &priority);
+
+    bool admitted = true;
+    bool start = false;
+    long queue_depth = 0;
+    admissionMut.lock();
+    {
+        if(activeRequests < activeLimit(priority))
+        {
+            activeRequests++;
+            start = true;
+        }
+        else if(pendingRequests.length() < maxQueuedRequests)
+        {
+            pending_request_t pending = {
+                .info = info,
+                .priority = priority,
+                .queued_at = TimeLib::latchtime()
+            };
+            uint64_t key = ((uint64_t)(MAX_PRIORITY - priority) << 48) | (pendingSeq++ & 0xFFFFFFFFFFFFULL);
+            pendingRequests.add(key, pending);
+        }
+        else
+        {
+            admitted = false;
+        }
+        queue_depth = pendingRequests.length();
+    }
+    admissionMut.unlock();
+
+    /* Queue Depth Metric */
+    FString depth_metric("%s.queue_depth", info->request->resource);
+    gauge_metric(INFO, depth_metric.c_str(), queue_depth);
+
+    /* Start Request */
+    if(start) startRequest(info, 0.0);
+
+    return admitted;
+}
+
+/*----------------------------------------------------------------------------
+ * rejectRequest
+ *
+ *  responds unavailable to a request that was never started and frees it
+ *----------------------------------------------------------------------------*/
+void LuaEndpoint::rejectRequest (EndpointObject::info_t* info)
+{
+    Request* request = info->request;
+
+    /* Rejected Metric */
+    FString rejected_metric("%s.rejected", request->resource);
+    count_metric(INFO, rejected_metric.c_str(), 1);
+
+    /* Respond Unavailable */
+    char header[MAX_HDR_SIZE];
+    int header_length = buildheader(header, Service_Unavailable);
+    Publisher rspq(request->id);
+    rspq.postCopy(header, header_length);
+    rspq.postCopy("", 0);
+
+    /* Clean Up */
+    delete request;
+    delete info;
+}
+
+/*----------------------------------------------------------------------------
+ * startRequest
+ *----------------------------------------------------------------------------*/
+void LuaEndpoint::startRequest (EndpointObject::info_t* info, double queue_time)
+{
+    /* Queue Time Metric */
+    if(maxActiveRequests > 0)
+    {
+        FString queue_metric("%s.queue_time", info->request->resource);
+        gauge_metric(INFO, queue_metric.c_str(), queue_time);
+    }
+
+    /* Start Thread */
+    Thread pid(requestThread, info, false);
+}
+
+/*----------------------------------------------------------------------------
+ * finishRequest
+ *
+ *  releases the slot held by a completed request and hands it to the
+ *  highest priority queued request that is allowed to use it
+ *----------------------------------------------------------------------------*/
+void LuaEndpoint::finishRequest (void)
+{
+    if(maxActiveRequests <= 0) return;
+
+    pending_request_t pending;
+    bool start = false;
+    admissionMut.lock();
+    {
+        activeRequests--;
+        uint64_t key = pendingRequests.first(&pending);
+        if((key != (uint64_t)INVALID_KEY) && (activeRequests < activeLimit(pending.priority)))
+        {
+            pendingRequests.remove(key);
+            activeRequests++;
+            start = true;
+        }
+    }
+    admissionMut.unlock();
+
+    if(start)
+    {
+        startRequest(pending.info, TimeLib::latchtime() - pending.queued_at);
+    }
+}
+
+/*----------------------------------------------------------------------------
+ * activeLimit
+ *----------------------------------------------------------------------------*/
+int LuaEndpoint::activeLimit (int priority) const
+{
+    if(priority > DEFAULT_PRIORITY) return maxActiveRequests + PRIORITY_HEADROOM;
+    return maxActiveRequests;
+}
+
 /*----------------------------------------------------------------------------
  * luaAuth - :auth(<authentication object>)
  *
@@ -390,3 +640,81 @@ int LuaEndpoint::luaAuth (lua_State* L)
     /* Return Status */
     return returnLuaStatus(L, status);
 }
+
+/*----------------------------------------------------------------------------
+ * luaAdmission - :admission(<max active requests>, [<max queued requests>])
+ *
+ * Note: NOT thread safe, must be called prior to attaching endpoint to server
+ *----------------------------------------------------------------------------*/
+int LuaEndpoint::luaAdmission (lua_State* L)
+{
+    bool status = false;
+
+    try
+    {
+        /* Get Self */
+        LuaEndpoint* lua_obj = dynamic_cast<LuaEndpoint*>(getLuaSelf(L, 1));
+
+        /* Get Parameters */
+        long max_active = getLuaInteger(L, 2);
+        long max_queued = getLuaInteger(L, 3, true, DEFAULT_MAX_QUEUED_REQUESTS);
+
+        /* Check Parameters */
+        if(max_active < 0) throw RunTimeException(CRITICAL, RTE_ERROR, "invalid maximum number of active requests: %ld", max_active);
+        if(max_queued < 0) throw RunTimeException(CRITICAL, RTE_ERROR, "invalid maximum number of queued requests: %ld", max_queued);
+
+        /* Set Limits */
+        lua_obj->maxActiveRequests = max_active;
+        lua_obj->maxQueuedRequests = max_queued;
+
+        /* Set return Status */
+        status = true;
+    }
+    catch(const RunTimeException& e)
+    {
+        mlog(e.level(), "Error setting admission limits: %s", e.what());
+    }
+
+    /* Return Status */
+    return returnLuaStatus(L, status);
+}
+
+/*----------------------------------------------------------------------------
+ * luaPriority - :priority(<resource>, <priority>)
+ *
+ *  queued requests for resources with a higher priority are started first,
+ *  and any priority above the default may exceed the active request limit
+ *  by PRIORITY_HEADROOM
+ *
+ * Note: NOT thread safe, must be called prior to attaching endpoint to server
+ *----------------------------------------------------------------------------*/
+int LuaEndpoint::luaPriority (lua_State* L)
+{
+    bool status = false;
+
+    try
+    {
+        /* Get Self */
+        LuaEndpoint* lua_obj = dynamic_cast<LuaEndpoint*>(getLuaSelf(L, 1));
+
+        /* Get Parameters */
+        const char* resource = getLuaString(L, 2);
+        long priority = getLuaInteger(L, 3);
+
+        /* Check Parameters */
+        if(priority < DEFAULT_PRIORITY || priority > MAX_PRIORITY)
+        {
+            throw RunTimeException(CRITICAL, RTE_ERROR, "invalid priority for %s: %ld", resource, priority);
+        }
+
+        /* Set Priority */
+        status = lua_obj->resourcePriority.add(resource, priority);
+    }
+    catch(const RunTimeException& e)
+    {
+        mlog(e.level(), "Error setting priority: %s", e.what());
+    }
+
+    /* Return Status */
+    return returnLuaStatus(L, status);
+}
@@ -40,8 +40,10 @@
 #include "OsApi.h"
 #include "StringLib.h"
 #include "Dictionary.h"
+#include "Ordering.h"
 #include "MsgQ.h"
 #include "LuaObject.h"
+#include "LuaEngine.h"
 #include "RecordObject.h"
 
 /******************************************************************************
@@ -64,6 +66,12 @@ class LuaEndpoint: public EndpointObject
 
         static const double DEFAULT_NORMAL_REQUEST_MEMORY_THRESHOLD;
         static const double DEFAULT_STREAM_REQUEST_MEMORY_THRESHOLD;
+        static const int DEFAULT_ENGINE_POOL_SIZE = 8;
+        static const int DEFAULT_MAX_ACTIVE_REQUESTS = 0; // unlimited
+        static const int DEFAULT_MAX_QUEUED_REQUESTS = 1024;
+        static const int DEFAULT_PRIORITY = 0;
+        static const int MAX_PRIORITY = 255;
+        static const int PRIORITY_HEADROOM = 4; // extra active requests allowed for prioritized resources
 
         static const int MAX_RESPONSE_TIME_MS = 5000;
         static const int MAX_EXCEPTION_TEXT_SIZE = 256;
@@ -81,6 +89,13 @@ class LuaEndpoint: public EndpointObject
             char    text[MAX_EXCEPTION_TEXT_SIZE];
         } response_exception_t;
 
+        /* Queued Request */
+        typedef struct {
+            EndpointObject::info_t* info;
+            int                     priority;
+            double                  queued_at;  // latch time when queued
+        } pending_request_t;
+
         /*--------------------------------------------------------------------
          * Authenticator Subclass
          *--------------------------------------------------------------------*/
@@ -118,17 +133,28 @@ class LuaEndpoint: public EndpointObject
          * Methods
          *--------------------------------------------------------------------*/
 
-                            LuaEndpoint     (lua_State* L, double normal_mem_thresh, double stream_mem_thresh, event_level_t lvl);
+                            LuaEndpoint     (lua_State* L, double normal_mem_thresh, double stream_mem_thresh, event_level_t lvl, int num_engines);
         virtual             ~LuaEndpoint    (void);
 
         static void*        requestThread   (void* parm);
 
         rsptype_t           handleRequest   (Request* request) override;
 
-        void                normalResponse  (const char* scriptpath, Request* request, Publisher* rspq, uint32_t trace_id) const;
-        void                streamResponse  (const char* scriptpath, Request* request, Publisher* rspq, uint32_t trace_id) const;
+        void                normalResponse  (const char* scriptpath, Request* request, Publisher* rspq, uint32_t trace_id);
+        void                streamResponse  (const char* scriptpath, Request* request, Publisher* rspq, uint32_t trace_id);
+
+        LuaEngine*          acquireEngine   (const char* scriptpath, const char* arg, uint32_t trace_id);
+        void                releaseEngine   (LuaEngine* engine);
+
+        bool                admitRequest    (EndpointObject::info_t* info);
+        void                rejectRequest   (EndpointObject::info_t* info);
+        void                startRequest    (EndpointObject::info_t* info, double queue_time);
+        void                finishRequest   (void);
+        int                 activeLimit     (int priority) const;
 
         static int          luaAuth         (lua_State* L);
+        static int          luaAdmission    (lua_State* L);
+        static int          luaPriority     (lua_State* L);
 
         /*--------------------------------------------------------------------
          * Data
@@ -138,6 +164,19 @@ class LuaEndpoint: public EndpointObject
         double              streamRequestMemoryThreshold;
         event_level_t       logLevel;
         Authenticator*      authenticator;
+
+        LuaEngine**         enginePool;     // idle engines ready to be reloaded
+        int                 enginePoolSize;
+        int                 enginePoolCnt;
+        Mutex               enginePoolMut;
+
+        int                 maxActiveRequests;  // zero means unlimited
+        int                 maxQueuedRequests;
+        int                 activeRequests;
+        uint64_t            pendingSeq;
+        Ordering<pending_request_t, uint64_t> pendingRequests; // keyed by priority then arrival
+        Dictionary<int>     resourcePriority;
+        Mutex               admissionMut;
 };
 
 #endif  /* __lua_endpoint__ */
@@ -36,6 +36,7 @@
 #include "LuaEngine.h"
 #include "core.h"
 #include <regex>
+#include <sys/stat.h>
 
 /******************************************************************************
  * STATIC DATA
@@ -44,6 +45,8 @@
 const char* LuaEngine::LUA_SELFKEY = "__this";
 const char* LuaEngine::LUA_TRACEID = "__traceid";
 const char* LuaEngine::LUA_CONFDIR = "__confdir";
+const char* LuaEngine::LUA_BASETABLES = "__basetables";
+const char* LuaEngine::LUA_BASEMETAS = "__basemetas";
 
 List<LuaEngine::libInitEntry_t> LuaEngine::libInitTable;
 Mutex LuaEngine::libInitTableMutex;
@@ -53,6 +56,9 @@ Mutex LuaEngine::pkgInitTableMutex;
 
 std::atomic<uint64_t> LuaEngine::engineIds{1};
 
+Dictionary<LuaEngine::chunk_t*> LuaEngine::chunkCache;
+Mutex LuaEngine::chunkCacheMutex;
+
 /******************************************************************************
  * PUBLIC METHODS
  ******************************************************************************/
@@ -69,6 +75,7 @@ LuaEngine::LuaEngine(const char* name, int lua_argc, char lua_argv[][MAX_LUA_ARG
     mode            = PROTECTED_MODE;
     traceId         = start_trace(CRITICAL, trace_id, "lua_engine", "{\"name\":\"%s\"}", name);
     dInfo           = NULL;
+    engineThread    = NULL;
     L               = createState(hook);
 
     /* Create Lua Thread */
@@ -107,6 +114,7 @@ LuaEngine::LuaEngine(const char* script, const char* arg, uint32_t trace_id, lua
     mode            = DIRECT_MODE;
     traceId         = start_trace(CRITICAL, trace_id, "lua_engine", "{\"script\":\"%s\"}", script);
     pInfo           = NULL;
+    engineThread    = NULL;
     L               = createState(hook);
 
     /* Create Script Thread */
@@ -124,6 +132,30 @@ LuaEngine::LuaEngine(const char* script, const char* arg, uint32_t trace_id, lua
     }
 }
 
+/*----------------------------------------------------------------------------
+ * Constructor
+ *
+ *  DIRECT_MODE - creates an idle engine (e.g. for a pool) whose script and
+ *  argument are supplied later by reload()
+ *----------------------------------------------------------------------------*/
+LuaEngine::LuaEngine(luaStepHook hook)
+{
+    /* Initialize Parameters */
+    engineId        = engineIds++;
+    mode            = DIRECT_MODE;
+    traceId         = ORIGIN;
+    pInfo           = NULL;
+    engineThread    = NULL;
+    engineActive    = false;
+    L               = createState(hook);
+
+    /* Create Empty Script Info */
+    dInfo = new directThread_t;
+    dInfo->engine = this;
+    dInfo->script = NULL;
+    dInfo->arg    = NULL;
+}
+
 /*----------------------------------------------------------------------------
  * Destructor
  *----------------------------------------------------------------------------*/
@@ -154,7 +186,7 @@ LuaEngine::~LuaEngine(void)
     }
 
     /* Stop Trace */
-    stop_trace(CRITICAL, traceId);
+    if(traceId != ORIGIN) stop_trace(CRITICAL, traceId);
 }
 
 /*----------------------------------------------------------------------------
@@ -191,6 +223,13 @@ void LuaEngine::deinit(void)
         }
     }
     libInitTableMutex.unlock();
+
+    /* Free compiled scripts */
+    chunkCacheMutex.lock();
+    {
+        chunkCache.clear();
+    }
+    chunkCacheMutex.unlock();
 }
 
 /*----------------------------------------------------------------------------
@@ -535,6 +574,89 @@ const char* LuaEngine::getResult (void)
     return NULL;
 }
 
+/*----------------------------------------------------------------------------
+ * reload
+ *
+ *  points an idle direct mode engine at a new script and argument; the
+ *  engine must have been created idle or successfully recycled
+ *----------------------------------------------------------------------------*/
+void LuaEngine::reload (const char* script, const char* arg, uint32_t trace_id)
+{
+    assert(mode == DIRECT_MODE);
+
+    engineSignal.lock();
+    {
+        /* Restart Trace */
+        if(traceId != ORIGIN) stop_trace(CRITICAL, traceId);
+        traceId = start_trace(CRITICAL, trace_id, "lua_engine", "{\"script\":\"%s\"}", script);
+        lua_pushnumber(L, traceId);
+        lua_setglobal(L, LUA_TRACEID);
+
+        /* Replace Script and Argument */
+        delete [] dInfo->script;
+        delete [] dInfo->arg;
+        dInfo->script = StringLib::duplicate(script);
+        dInfo->arg    = StringLib::duplicate(arg);
+    }
+    engineSignal.unlock();
+}
+
+/*----------------------------------------------------------------------------
+ * recycle
+ *
+ *  returns a completed direct mode engine to the state it was in when it was
+ *  created so that it can be reloaded; every table reachable from the globals
+ *  when the state was created (the globals themselves, loaded modules, and
+ *  library tables like string or core) gets back its original fields and
+ *  metatable, and whatever the script left behind is garbage collected
+ *
+ *  returns false if the engine cannot be reused (still running or protected
+ *  mode), in which case it should be deleted
+ *----------------------------------------------------------------------------*/
+bool LuaEngine::recycle (void)
+{
+    bool status = false;
+
+    engineSignal.lock();
+    {
+        if(mode == DIRECT_MODE && !engineActive)
+        {
+            /* Join Script Thread */
+            delete engineThread;
+            engineThread = NULL;
+
+            /* Clear Results */
+            lua_settop(L, 0);
+
+            /* Restore Base Tables */
+            lua_getfield(L, LUA_REGISTRYINDEX, LUA_BASETABLES);    // tables
+            lua_getfield(L, LUA_REGISTRYINDEX, LUA_BASEMETAS);     // tables, metas
+            lua_pushnil(L);                                         // tables, metas, nil
+            while(lua_next(L, 1) != 0)                              // tables, metas, table, copy
+            {
+                restoreTable(L, 3, 4);
+                lua_pop(L, 1);                                      // tables, metas, table
+                lua_pushvalue(L, 3);                                // tables, metas, table, table
+                lua_rawget(L, 2);                                   // tables, metas, table, metatable|nil
+                lua_setmetatable(L, 3);                             // tables, metas, table
+            }
+            lua_settop(L, 0);
+
+            /* Collect Everything Left Behind */
+            lua_gc(L, LUA_GCCOLLECT, 0);
+
+            /* Stop Trace */
+            stop_trace(CRITICAL, traceId);
+            traceId = ORIGIN;
+
+            status = true;
+        }
+    }
+    engineSignal.unlock();
+
+    return status;
+}
+
 /******************************************************************************
  * PRIVATE METHODS
  ******************************************************************************/
@@ -590,7 +712,7 @@ void* LuaEngine::directThread (void* parm)
         lua_setglobal(L, "arg");
 
         /* Execute Script */
-        int status = luaL_loadfile(L, d->script);
+        int status = loadScript(L, d->script);
         if(status == LUA_OK)
         {
             status = lua_pcall(L, 0, LUA_MULTRET, 0);
@@ -672,10 +794,197 @@ lua_State* LuaEngine::createState(luaStepHook hook)
     lua_setfield(l, -2, "path" ); // set the field "path" in table at -2 with value at top of stack
     lua_pop(l, 1 ); // get rid of package table from top of stack
 
+    /* Snapshot Globals, Libraries, and String Metatable (restored by recycle) */
+    lua_newtable(l);                    // tables
+    lua_newtable(l);                    // tables, metas
+    int top = lua_gettop(l);
+    lua_pushglobaltable(l);
+    snapshotTable(l, -1, top - 1, top);
+    lua_pop(l, 1);
+    lua_pushliteral(l, "");
+    if(lua_getmetatable(l, -1))
+    {
+        snapshotTable(l, -1, top - 1, top);
+        lua_pop(l, 1);
+    }
+    lua_pop(l, 1);
+    lua_setfield(l, LUA_REGISTRYINDEX, LUA_BASEMETAS);
+    lua_setfield(l, LUA_REGISTRYINDEX, LUA_BASETABLES);
+
     /* Return State */
     return l;
 }
 
+/*----------------------------------------------------------------------------
+ * loadScript
+ *
+ *  same as luaL_loadfile, but reuses the compiled chunk from a previous load
+ *  of the script as long as the file has not changed since
+ *----------------------------------------------------------------------------*/
+int LuaEngine::loadScript (lua_State* L, const char* script)
+{
+    /* Check Script on Disk */
+    struct stat st;
+    if(stat(script, &st) != 0)
+    {
+        return luaL_loadfile(L, script); // let lua report the error
+    }
+
+    /* Load Compiled Chunk */
+    FString chunkname("@%s", script);
+    bool cached = false;
+    int status = LUA_OK;
+    chunkCacheMutex.lock();
+    {
+        chunk_t* chunk = NULL;
+        if(chunkCache.find(script, &chunk) && (chunk->mtime == st.st_mtime) && (chunk->size == st.st_size))
+        {
+            cached = true;
+            status = luaL_loadbufferx(L, chunk->bytecode.data(), chunk->bytecode.size(), chunkname.c_str(), "b");
+        }
+    }
+    chunkCacheMutex.unlock();
+
+    /* Return Cached Chunk */
+    if(cached)
+    {
+        if(status == LUA_OK) return status;
+        lua_pop(L, 1); // error message; fall through and recompile
+    }
+
+    /* Compile Script */
+    status = luaL_loadfile(L, script);
+    if(status == LUA_OK)
+    {
+        chunk_t* chunk = new chunk_t;
+        chunk->mtime = st.st_mtime;
+        chunk->size = st.st_size;
+        if(lua_dump(L, chunkWriter, &chunk->bytecode, 0) == 0)
+        {
+            chunkCacheMutex.lock();
+            {
+                chunkCache.add(script, chunk);
+            }
+            chunkCacheMutex.unlock();
+        }
+        else
+        {
+            delete chunk;
+        }
+    }
+
+    return status;
+}
+
+/*----------------------------------------------------------------------------
+ * chunkWriter
+ *----------------------------------------------------------------------------*/
+int LuaEngine::chunkWriter (lua_State* L, const void* p, size_t sz, void* ud)
+{
+    (void)L;
+    std::string* bytecode = static_cast<std::string*>(ud);
+    bytecode->append(static_cast<const char*>(p), sz);
+    return 0;
+}
+
+/*----------------------------------------------------------------------------
+ * copyTable
+ *
+ *  pushes a shallow copy of the table at index
+ *----------------------------------------------------------------------------*/
+void LuaEngine::copyTable (lua_State* L, int index)
+{
+    index = lua_absindex(L, index);
+    lua_newtable(L);                        // copy
+    lua_pushnil(L);                         // copy, nil
+    while(lua_next(L, index) != 0)          // copy, key, value
+    {
+        lua_pushvalue(L, -2);               // copy, key, value, key
+        lua_insert(L, -2);                  // copy, key, key, value
+        lua_rawset(L, -4);                  // copy, key
+    }
+}
+
+/*----------------------------------------------------------------------------
+ * snapshotTable
+ *
+ *  records a shallow copy of the table at index, and of every table reachable
+ *  from it through keys, values, and metatables, in the tables table (keyed
+ *  by the original table); metatables are recorded in the metas table; both
+ *  tables and metas must be absolute indices
+ *----------------------------------------------------------------------------*/
+void LuaEngine::snapshotTable (lua_State* L, int index, int tables, int metas)
+{
+    index = lua_absindex(L, index);
+    luaL_checkstack(L, 8, "base tables nested too deeply");
+
+    /* Skip Visited Tables */
+    lua_pushvalue(L, index);                // table
+    if(lua_rawget(L, tables) != LUA_TNIL)   // copy
+    {
+        lua_pop(L, 1);
+        return;
+    }
+    lua_pop(L, 1);
+
+    /* Copy Table */
+    lua_pushvalue(L, index);                // table
+    copyTable(L, index);                    // table, copy
+    lua_rawset(L, tables);
+
+    /* Record Metatable */
+    if(lua_getmetatable(L, index))          // metatable
+    {
+        lua_pushvalue(L, index);            // metatable, table
+        lua_pushvalue(L, -2);               // metatable, table, metatable
+        lua_rawset(L, metas);               // metatable
+        snapshotTable(L, -1, tables, metas);
+        lua_pop(L, 1);
+    }
+
+    /* Walk Nested Tables */
+    lua_pushnil(L);                         // nil
+    while(lua_next(L, index) != 0)          // key, value
+    {
+        if(lua_type(L, -1) == LUA_TTABLE) snapshotTable(L, -1, tables, metas);
+        if(lua_type(L, -2) == LUA_TTABLE) snapshotTable(L, -2, tables, metas);
+        lua_pop(L, 1);                      // key
+    }
+}
+
+/*----------------------------------------------------------------------------
+ * restoreTable
+ *
+ *  makes the table at index match the shallow copy at baseline; both indices
+ *  must be absolute
+ *----------------------------------------------------------------------------*/
+void LuaEngine::restoreTable (lua_State* L, int index, int baseline)
+{
+    /* Remove Added and Changed Fields */
+    lua_pushnil(L);                         // nil
+    while(lua_next(L, index) != 0)          // key, value
+    {
+        lua_pushvalue(L, -2);               // key, value, key
+        lua_rawget(L, baseline);            // key, value, original
+        if(!lua_rawequal(L, -1, -2))
+        {
+            lua_pushvalue(L, -3);           // key, value, original, key
+            lua_pushnil(L);                 // key, value, original, key, nil
+            lua_rawset(L, index);           // key, value, original
+        }
+        lua_pop(L, 2);                      // key
+    }
+
+    /* Restore Original Fields */
+    lua_pushnil(L);                         // nil
+    while(lua_next(L, baseline) != 0)       // key, value
+    {
+        lua_pushvalue(L, -2);               // key, value, key
+        lua_insert(L, -2);                  // key, key, value
+        lua_rawset(L, index);               // key
+    }
+}
+
 /*----------------------------------------------------------------------------
  * logErrorMessage
  *----------------------------------------------------------------------------*/
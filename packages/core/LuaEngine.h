@@ -40,8 +40,10 @@
 #include "EventLib.h"
 #include "StringLib.h"
 #include "List.h"
+#include "Dictionary.h"
 
 #include <atomic>
+#include <string>
 
 extern "C"
 {
@@ -87,6 +89,7 @@ class LuaEngine
 
                             LuaEngine       (const char* name, int lua_argc, char lua_argv[][MAX_LUA_ARG], uint32_t trace_id=ORIGIN, luaStepHook hook=NULL, bool paused=false); // protected mode
                             LuaEngine       (const char* script, const char* arg, uint32_t trace_id=ORIGIN, luaStepHook hook=NULL, bool paused=false); // direct mode
+        explicit            LuaEngine       (luaStepHook hook); // direct mode, idle until reloaded
                             ~LuaEngine      (void);
 
         static void         init            (void);
@@ -115,6 +118,8 @@ class LuaEngine
         void                setFunction     (const char* name, lua_CFunction val);
         void                setObject       (const char* name, void* val);
         const char*         getResult       (void);
+        void                reload          (const char* script, const char* arg, uint32_t trace_id=ORIGIN);
+        bool                recycle         (void);
 
     private:
 
@@ -123,6 +128,8 @@ class LuaEngine
          *--------------------------------------------------------------------*/
 
         static const int ENGINE_EXIT_SIGNAL = 0;
+        static const char* LUA_BASETABLES;
+        static const char* LUA_BASEMETAS;
 
         /*--------------------------------------------------------------------
          * Types
@@ -150,6 +157,12 @@ class LuaEngine
             const char*     arg;
         } directThread_t;
 
+        typedef struct Chunk {
+            std::string     bytecode;   // output of lua_dump
+            time_t          mtime;      // modification time of script when compiled
+            off_t           size;       // size of script when compiled
+        } chunk_t;
+
         /*--------------------------------------------------------------------
          * Data
          *--------------------------------------------------------------------*/
@@ -162,6 +175,9 @@ class LuaEngine
 
         static std::atomic<uint64_t>    engineIds;
 
+        static Dictionary<chunk_t*>     chunkCache;
+        static Mutex                    chunkCacheMutex;
+
         lua_State*                      L;      // lua state variable
 
         uint64_t                        engineId;
@@ -181,6 +197,11 @@ class LuaEngine
         static void*    protectedThread     (void* parm);
         static void*    directThread        (void* parm);
         lua_State*      createState         (luaStepHook hook);
+        static int      loadScript          (lua_State* L, const char* script);
+        static int      chunkWriter         (lua_State* L, const void* p, size_t sz, void* ud);
+        static void     copyTable           (lua_State* L, int index);
+        static void     snapshotTable       (lua_State* L, int index, int tables, int metas);
+        static void     restoreTable        (lua_State* L, int index, int baseline);
                void     logErrorMessage     (void);
 
         /* Interpreter */
@@ -276,6 +276,195 @@ bool MathLib::inpoly (point_t* poly, int len, point_t point)
     return c == 1;
 }
 
+/*----------------------------------------------------------------------------
+ * coord2point - bulk
+ *
+ *  projects n coordinates held in separate longitude and latitude arrays;
+ *  produces the same points as the single coordinate version
+ *----------------------------------------------------------------------------*/
+void MathLib::coord2point (const double* lon, const double* lat, long n, proj_t projection, point_t* points)
+{
+    if(projection == NORTH_POLAR)
+    {
+        for(long k = 0; k < n; k++)
+        {
+            double lonrad = lon[k] * M_PI / 180.0;
+            double r = 2 * tan((M_PI / 4.0) - ((lat[k] * M_PI / 180.0) / 2.0));
+            points[k].x = r * cos(lonrad);
+            points[k].y = r * sin(lonrad);
+        }
+    }
+    else if(projection == SOUTH_POLAR)
+    {
+        for(long k = 0; k < n; k++)
+        {
+            double lonrad = lon[k] * M_PI / 180.0;
+            double r = -2 * tan(-(M_PI / 4.0) - ((lat[k] * M_PI / 180.0) / 2.0));
+            points[k].x = r * cos(-lonrad);
+            points[k].y = r * sin(-lonrad);
+        }
+    }
+    else if(projection == PLATE_CARREE)
+    {
+        for(long k = 0; k < n; k++)
+        {
+            points[k].x = EARTHRADIUS * (lon[k] * M_PI / 180.0);
+            points[k].y = EARTHRADIUS * (lat[k] * M_PI / 180.0);
+        }
+    }
+}
+
+/*----------------------------------------------------------------------------
+ * inpoly - bulk
+ *
+ *  sets inclusion[k] to whether points[k] is inside the indexed polygon
+ *----------------------------------------------------------------------------*/
+void MathLib::inpoly (const PolyIndex& poly, const point_t* points, long n, bool* inclusion)
+{
+    for(long k = 0; k < n; k++)
+    {
+        inclusion[k] = poly.includes(points[k]);
+    }
+}
+
+/*----------------------------------------------------------------------------
+ * PolyIndex Constructor - single ring
+ *----------------------------------------------------------------------------*/
+MathLib::PolyIndex::PolyIndex (const point_t* poly, int len)
+{
+    build(&poly, &len, 1);
+}
+
+/*----------------------------------------------------------------------------
+ * PolyIndex Constructor - multiple rings
+ *----------------------------------------------------------------------------*/
+MathLib::PolyIndex::PolyIndex (const point_t* const* rings, const int* lens, int num_rings)
+{
+    build(rings, lens, num_rings);
+}
+
+/*----------------------------------------------------------------------------
+ * PolyIndex Destructor
+ *----------------------------------------------------------------------------*/
+MathLib::PolyIndex::~PolyIndex (void)
+{
+    delete [] edges;
+    delete [] slabOffsets;
+    delete [] slabEdges;
+}
+
+/*----------------------------------------------------------------------------
+ * PolyIndex::includes
+ *
+ *  same crossing test as inpoly, applied only to the edges in the slab
+ *  of the point
+ *----------------------------------------------------------------------------*/
+bool MathLib::PolyIndex::includes (point_t point) const
+{
+    /* Check Bounding Box (no edge can be crossed outside of it) */
+    if(point.y < minY || point.y >= maxY || point.x >= maxX)
+    {
+        return false;
+    }
+
+    /* Count Crossings of Edges in Slab */
+    int c = 0;
+    long s = slab(point.y);
+    for(long e = slabOffsets[s]; e < slabOffsets[s + 1]; e++)
+    {
+        const edge_t& edge = edges[slabEdges[e]];
+        if((edge.p0.y > point.y) != (edge.p1.y > point.y))
+        {
+            double x_extent = (edge.p1.x - edge.p0.x) * (point.y - edge.p0.y) / (edge.p1.y - edge.p0.y) + edge.p0.x;
+            if(point.x < x_extent) c = !c;
+        }
+    }
+
+    return c == 1;
+}
+
+/*----------------------------------------------------------------------------
+ * PolyIndex::build
+ *----------------------------------------------------------------------------*/
+void MathLib::PolyIndex::build (const point_t* const* rings, const int* lens, int num_rings)
+{
+    /* Count Edges (horizontal edges are never crossed) */
+    long total_edges = 0;
+    for(int r = 0; r < num_rings; r++)
+    {
+        total_edges += lens[r];
+    }
+
+    /* Collect Edges and Bounds */
+    edges = new edge_t [total_edges > 0 ? total_edges : 1];
+    numEdges = 0;
+    minY = 0.0;
+    maxY = 0.0;
+    maxX = 0.0;
+    bool first_vertex = true;
+    for(int r = 0; r < num_rings; r++)
+    {
+        const point_t* poly = rings[r];
+        for(int i = 0, j = lens[r] - 1; i < lens[r]; j = i++)
+        {
+            if(first_vertex)
+            {
+                minY = maxY = poly[i].y;
+                maxX = poly[i].x;
+                first_vertex = false;
+            }
+            minY = MIN(minY, poly[i].y);
+            maxY = MAX(maxY, poly[i].y);
+            maxX = MAX(maxX, poly[i].x);
+            if(poly[i].y != poly[j].y)
+            {
+                edges[numEdges].p0 = poly[i];
+                edges[numEdges].p1 = poly[j];
+                numEdges++;
+            }
+        }
+    }
+
+    /* Size Slabs */
+    numSlabs = MAX(1, MIN(numEdges, (long)MAX_SLABS));
+    slabScale = (maxY > minY) ? (numSlabs / (maxY - minY)) : 0.0;
+
+    /* Count Edges in Each Slab */
+    slabOffsets = new long [numSlabs + 1];
+    memset(slabOffsets, 0, sizeof(long) * (numSlabs + 1));
+    for(long e = 0; e < numEdges; e++)
+    {
+        long s0 = slab(MIN(edges[e].p0.y, edges[e].p1.y));
+        long s1 = slab(MAX(edges[e].p0.y, edges[e].p1.y));
+        for(long s = s0; s <= s1; s++) slabOffsets[s + 1]++;
+    }
+    for(long s = 0; s < numSlabs; s++)
+    {
+        slabOffsets[s + 1] += slabOffsets[s];
+    }
+
+    /* Populate Slabs */
+    long* slab_fill = new long [numSlabs];
+    memcpy(slab_fill, slabOffsets, sizeof(long) * numSlabs);
+    slabEdges = new long [slabOffsets[numSlabs] > 0 ? slabOffsets[numSlabs] : 1];
+    for(long e = 0; e < numEdges; e++)
+    {
+        long s0 = slab(MIN(edges[e].p0.y, edges[e].p1.y));
+        long s1 = slab(MAX(edges[e].p0.y, edges[e].p1.y));
+        for(long s = s0; s <= s1; s++) slabEdges[slab_fill[s]++] = e;
+    }
+    delete [] slab_fill;
+}
+
+/*----------------------------------------------------------------------------
+ * PolyIndex::slab
+ *----------------------------------------------------------------------------*/
+long MathLib::PolyIndex::slab (double y) const
+{
+    long s = (long)((y - minY) * slabScale);
+    return MAX(0, MIN(s, numSlabs - 1));
+}
+
 /*----------------------------------------------------------------------------
  * b64encode
  *
@@ -77,6 +77,51 @@ class MathLib
             double  y;
         } point_t;
 
+        /*--------------------------------------------------------------------
+         * Polygon Index (subclass)
+         *
+         *  edges of one or more projected rings bucketed into horizontal
+         *  slabs so that a containment test only visits the edges that span
+         *  the slab of the point; rings are combined with the even-odd rule,
+         *  so holes are given as additional rings inside their polygon
+         *--------------------------------------------------------------------*/
+
+        class PolyIndex
+        {
+            public:
+
+                static const long MAX_SLABS = 0x10000;
+
+                            PolyIndex   (const point_t* poly, int len);
+                            PolyIndex   (const point_t* const* rings, const int* lens, int num_rings);
+                            ~PolyIndex  (void);
+
+                            PolyIndex   (const PolyIndex&) = delete; // owns its edge and slab arrays
+                PolyIndex&  operator=   (const PolyIndex&) = delete;
+
+                bool        includes    (point_t point) const;
+
+            private:
+
+                typedef struct {
+                    point_t p0; // current vertex
+                    point_t p1; // previous vertex
+                } edge_t;
+
+                void        build       (const point_t* const* rings, const int* lens, int num_rings);
+                long        slab        (double y) const;
+
+                edge_t*     edges;
+                long        numEdges;
+                long*       slabOffsets; // edges of slab i are slabEdges[slabOffsets[i]] to slabEdges[slabOffsets[i+1]-1]
+                long*       slabEdges;
+                long        numSlabs;
+                double      minY;
+                double      maxY;
+                double      maxX;
+                double      slabScale;
+        };
+
         /*--------------------------------------------------------------------
          * Methods
          *--------------------------------------------------------------------*/
@@ -85,6 +130,8 @@ class MathLib
         static point_t  coord2point (coord_t c, proj_t projection);
         static coord_t  point2coord (point_t p, proj_t projection);
         static bool     inpoly      (point_t* poly, int len, point_t point);
+        static void     coord2point (const double* lon, const double* lat, long n, proj_t projection, point_t* points);
+        static void     inpoly      (const PolyIndex& poly, const point_t* points, long n, bool* inclusion);
 
         static std::string b64encode(const void* data, const size_t &len);
         static std::string b64decode(const void* data, const size_t &len);
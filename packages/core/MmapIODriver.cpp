@@ -0,0 +1,233 @@
+/*
+ * Copyright (c) 2021, University of Washington
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the University of Washington nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE UNIVERSITY OF WASHINGTON AND CONTRIBUTORS
+ * “AS IS” AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE UNIVERSITY OF WASHINGTON OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <errno.h>
+
+#include "MmapIODriver.h"
+#include "OsApi.h"
+#include "Asset.h"
+
+/******************************************************************************
+ * STATIC DATA
+ ******************************************************************************/
+
+const char* MmapIODriver::FORMAT = "mmap";
+
+Mutex MmapIODriver::mappingMut;
+Dictionary<MmapIODriver::mapping_t*> MmapIODriver::mappings;
+
+/******************************************************************************
+ * MMAP IO DRIVER CLASS
+ ******************************************************************************/
+
+/*----------------------------------------------------------------------------
+ * create
+ *----------------------------------------------------------------------------*/
+Asset::IODriver* MmapIODriver::create (const Asset* _asset, const char* resource)
+{
+    return new MmapIODriver(_asset, resource);
+}
+
+/*----------------------------------------------------------------------------
+ * ioRead
+ *----------------------------------------------------------------------------*/
+int64_t MmapIODriver::ioRead (uint8_t* data, int64_t size, uint64_t pos)
+{
+    /* Check Position */
+    if(pos >= (uint64_t)mappingSize)
+    {
+        return 0;
+    }
+
+    /* Copy Data */
+    int64_t bytes = MIN(size, mappingSize - (int64_t)pos);
+    memcpy(data, &mapping[pos], bytes);
+    return bytes;
+}
+
+/*----------------------------------------------------------------------------
+ * ioMap
+ *----------------------------------------------------------------------------*/
+const uint8_t* MmapIODriver::ioMap (int64_t size, uint64_t pos)
+{
+    if((pos + size) > (uint64_t)mappingSize)
+    {
+        return NULL;
+    }
+
+    return &mapping[pos];
+}
+
+/*----------------------------------------------------------------------------
+ * ioAdvise
+ *----------------------------------------------------------------------------*/
+void MmapIODriver::ioAdvise (int64_t size, uint64_t pos, io_access_t access)
+{
+    /* Check Range */
+    if(pos >= (uint64_t)mappingSize)
+    {
+        return;
+    }
+
+    /* Get Advice
+     *  advising part of a mapping splits it into separate kernel areas, and the
+     *  mapping is shared by every reader of the file, so access patterns only
+     *  apply to the whole mapping while ranged requests just prefetch */
+    int advice;
+    if(size <= 0)
+    {
+        switch(access)
+        {
+            case IO_ACCESS_SEQUENTIAL:  advice = MADV_SEQUENTIAL;   break;
+            case IO_ACCESS_RANDOM:      advice = MADV_RANDOM;       break;
+            case IO_ACCESS_WILLNEED:    advice = MADV_WILLNEED;     break;
+            default:                    advice = MADV_NORMAL;       break;
+        }
+    }
+    else if(size >= MIN_ADVISE_SIZE && (access == IO_ACCESS_SEQUENTIAL || access == IO_ACCESS_WILLNEED))
+    {
+        advice = MADV_WILLNEED;
+    }
+    else
+    {
+        return;
+    }
+
+    /* Align Range to Pages */
+    static const uint64_t page_size = sysconf(_SC_PAGESIZE);
+    uint64_t start = (size > 0) ? pos - (pos % page_size) : 0;
+    uint64_t end = (size > 0) ? MIN(pos + size, (uint64_t)mappingSize) : mappingSize;
+
+    /* Advise Kernel (only a hint, so failures are ignored) */
+    if(madvise(&mapping[start], end - start, advice) != 0)
+    {
+        mlog(DEBUG, "Failed to advise access to %s: %s", asset->getName(), strerror(errno));
+    }
+}
+
+/*----------------------------------------------------------------------------
+ * Constructor
+ *----------------------------------------------------------------------------*/
+MmapIODriver::MmapIODriver (const Asset* _asset, const char* resource):
+    asset(_asset),
+    shared(NULL),
+    mappingKey(NULL),
+    mapping(NULL),
+    mappingSize(0)
+{
+    FString filepath("%s/%s", asset->getPath(), resource);
+
+    /* Open File */
+    int fd = open(filepath.c_str(), O_RDONLY);
+    if(fd < 0)
+    {
+        throw RunTimeException(CRITICAL, RTE_ERROR, "failed to open resource: %s", strerror(errno));
+    }
+
+    /* Get File Size */
+    struct stat st;
+    if(fstat(fd, &st) != 0)
+    {
+        int err = errno;
+        close(fd);
+        throw RunTimeException(CRITICAL, RTE_ERROR, "failed to stat resource: %s", strerror(err));
+    }
+
+    /* Build Mapping Key (a rewritten file gets a new mapping) */
+    FString key("%s#%lu#%ld#%ld", filepath.c_str(), (unsigned long)st.st_ino, (long)st.st_size, (long)st.st_mtime);
+    mappingKey = key.c_str(true);
+
+    /* Share or Create Mapping */
+    mappingMut.lock();
+    {
+        if(!mappings.find(mappingKey, &shared))
+        {
+            shared = new mapping_t;
+            if(st.st_size > 0)
+            {
+                /* Map File (the mapping remains valid after the file is closed) */
+                void* addr = mmap(NULL, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+                if(addr == MAP_FAILED)
+                {
+                    int err = errno;
+                    mappingMut.unlock();
+                    delete shared;
+                    delete [] mappingKey;
+                    close(fd);
+                    throw RunTimeException(CRITICAL, RTE_ERROR, "failed to map resource: %s", strerror(err));
+                }
+                shared->data = (uint8_t*)addr;
+                shared->size = st.st_size;
+            }
+            mappings.add(mappingKey, shared);
+        }
+        shared->refs++;
+        mapping = shared->data;
+        mappingSize = shared->size;
+    }
+    mappingMut.unlock();
+
+    close(fd);
+}
+
+/*----------------------------------------------------------------------------
+ * Destructor
+ *----------------------------------------------------------------------------*/
+MmapIODriver::~MmapIODriver (void)
+{
+    mappingMut.lock();
+    {
+        /* Last Reader Unmaps File (removal deletes the mapping) */
+        if(--shared->refs == 0)
+        {
+            mappings.remove(mappingKey);
+        }
+    }
+    mappingMut.unlock();
+
+    delete [] mappingKey;
+}
+
+/*----------------------------------------------------------------------------
+ * mapping_t Destructor
+ *----------------------------------------------------------------------------*/
+MmapIODriver::mapping_t::~mapping_t (void)
+{
+    if(data) munmap(data, size);
+}
@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) 2021, University of Washington
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the University of Washington nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE UNIVERSITY OF WASHINGTON AND CONTRIBUTORS
+ * “AS IS” AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE UNIVERSITY OF WASHINGTON OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __mmap_io_driver__
+#define __mmap_io_driver__
+
+/******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+
+#include "OsApi.h"
+#include "Asset.h"
+#include "Dictionary.h"
+
+/******************************************************************************
+ * MMAP IO DRIVER CLASS
+ ******************************************************************************/
+
+/*
+ * Maps local files into memory so that readers which support it (see
+ * Asset::IODriver::ioMap) can access the file contents in place rather
+ * than copying them through an intermediate buffer.
+ */
+class MmapIODriver: Asset::IODriver
+{
+    public:
+
+        /*--------------------------------------------------------------------
+         * Constants
+         *--------------------------------------------------------------------*/
+
+        static const char* FORMAT;
+        static const int64_t MIN_ADVISE_SIZE = 0x100000; // ranged advice below this is not worth a system call
+
+        /*--------------------------------------------------------------------
+         * Methods
+         *--------------------------------------------------------------------*/
+
+        static IODriver*    create      (const Asset* _asset, const char* resource);
+        int64_t             ioRead      (uint8_t* data, int64_t size, uint64_t pos) override;
+        const uint8_t*      ioMap       (int64_t size, uint64_t pos) override;
+        void                ioAdvise    (int64_t size, uint64_t pos, io_access_t access) override;
+
+    private:
+
+        /*--------------------------------------------------------------------
+         * Types
+         *--------------------------------------------------------------------*/
+
+        /* one mapping is shared by every driver reading the same version of a file */
+        struct mapping_t
+        {
+            uint8_t*    data;
+            int64_t     size;
+            int         refs;
+
+            mapping_t (void): data(NULL), size(0), refs(0) {}
+            ~mapping_t (void);
+        };
+
+        /*--------------------------------------------------------------------
+         * Methods
+         *--------------------------------------------------------------------*/
+
+        MmapIODriver (const Asset* _asset, const char* resource);
+        ~MmapIODriver (void);
+
+        /*--------------------------------------------------------------------
+         * Data
+         *--------------------------------------------------------------------*/
+
+        static Mutex                    mappingMut;
+        static Dictionary<mapping_t*>   mappings; // <path>#<inode>#<size>#<mtime> --> mapping
+
+        const Asset*    asset;
+        mapping_t*      shared;
+        const char*     mappingKey;
+        uint8_t*        mapping;
+        int64_t         mappingSize;
+};
+
+#endif  /* __mmap_io_driver__ */
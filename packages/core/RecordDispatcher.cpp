@@ -163,6 +163,7 @@ RecordDispatcher::RecordDispatcher( lua_State* L, const char* inputq_name,
     numThreads      = num_threads;
     threadsComplete = 0;
     recError        = false;
+    containerTypeId = RecordObject::getRecordTypeId(ContainerRecord::recType);
 
     /* Create Subscriber */
     inQ = new Subscriber(inputq_name, type);
@@ -211,6 +212,32 @@ RecordObject* RecordDispatcher::createRecord (unsigned char* buffer, int size)
     return new RecordInterface(buffer, size);
 }
 
+/*----------------------------------------------------------------------------
+ * countRecords
+ *
+ *  returns the number of records in a received message, or -1 if the
+ *  message is invalid; by default each message is one record
+ *----------------------------------------------------------------------------*/
+int RecordDispatcher::countRecords (unsigned char* msg, int len)
+{
+    (void)msg;
+    (void)len;
+    return 1;
+}
+
+/*----------------------------------------------------------------------------
+ * unpackRecord
+ *
+ *  returns the buffer of the record at index in a received message, or NULL
+ *  when the record is invalid
+ *----------------------------------------------------------------------------*/
+unsigned char* RecordDispatcher::unpackRecord (unsigned char* msg, int len, int index, int* size)
+{
+    if(index != 0) return NULL;
+    *size = len;
+    return msg;
+}
+
 /*----------------------------------------------------------------------------
  * luaRun - :run()
  *----------------------------------------------------------------------------*/
@@ -426,6 +453,8 @@ int RecordDispatcher::luaAbortOnTimeout (lua_State* L)
 void* RecordDispatcher::dispatcherThread(void* parm)
 {
     RecordDispatcher* dispatcher = static_cast<RecordDispatcher*>(parm);
+    dispatch_cache_t* cache = new dispatch_cache_t[RecordObject::MAX_TYPE_IDS];
+    for(int i = 0; i < RecordObject::MAX_TYPE_IDS; i++) cache[i].valid = false;
 
     /* Loop Forever */
     while(dispatcher->dispatcherActive)
@@ -438,36 +467,54 @@ void* RecordDispatcher::dispatcherThread(void* parm)
             unsigned char* msg = (unsigned char*)ref.data;
             int len = ref.size;
 
-            /* Dispatch Record */
+            /* Dispatch Records */
             if(len > 0)
             {
-                try
+                int num_records = dispatcher->countRecords(msg, len);
+                if(num_records < 0)
                 {
-                    /* Create & Dispatch Record */
-                    RecordObject* record = dispatcher->createRecord(msg, len);
-                    dispatcher->dispatchRecord(record);
-                    delete record;
+                    mlog(ERROR, "Invalid message of %d bytes received on %s", len, dispatcher->inQ->getName());
                 }
-                catch (const RunTimeException& e)
+
+                for(int index = 0; index < num_records; index++)
                 {
-                    if(!dispatcher->recError)
+                    /* Unpack Record */
+                    int size;
+                    unsigned char* buffer = dispatcher->unpackRecord(msg, len, index, &size);
+                    if(buffer == NULL)
+                    {
+                        mlog(ERROR, "Invalid record %d in message received on %s", index, dispatcher->inQ->getName());
+                        continue;
+                    }
+
+                    try
                     {
-                        int num_newlines = len / 16 + 3;
-                        char* msg_str = new char[len * 2 + num_newlines + 1];
-                        mlog(e.level(), "%s unable to create record from message: %s", dispatcher->ObjectType, e.what());
-                        int msg_index = 0;
-                        for(int i = 0; i < len; i++)
+                        /* Create & Dispatch Record */
+                        RecordObject* record = dispatcher->createRecord(buffer, size);
+                        dispatcher->dispatchRecord(record, cache);
+                        delete record;
+                    }
+                    catch (const RunTimeException& e)
+                    {
+                        if(!dispatcher->recError)
                         {
-                            sprintf(&msg_str[msg_index], "%02X", msg[i]);
-                            msg_index += 2;
-                            if(i % 16 == 15) msg_str[msg_index++] = '\n';
+                            int num_newlines = size / 16 + 3;
+                            char* msg_str = new char[size * 2 + num_newlines + 1];
+                            mlog(e.level(), "%s unable to create record from message: %s", dispatcher->ObjectType, e.what());
+                            int msg_index = 0;
+                            for(int i = 0; i < size; i++)
+                            {
+                                sprintf(&msg_str[msg_index], "%02X", buffer[i]);
+                                msg_index += 2;
+                                if(i % 16 == 15) msg_str[msg_index++] = '\n';
+                            }
+                            msg_str[msg_index++] = '\n';
+                            msg_str[msg_index++] = '\0';
+                            mlog(DEBUG, "%s", msg_str);
+                            delete [] msg_str;
                         }
-                        msg_str[msg_index++] = '\n';
-                        msg_str[msg_index++] = '\0';
-                        mlog(DEBUG, "%s", msg_str);
-                        delete [] msg_str;
+                        dispatcher->recError = true;
                     }
-                    dispatcher->recError = true;
                 }
             }
             else
@@ -505,6 +552,9 @@ void* RecordDispatcher::dispatcherThread(void* parm)
         }
     }
 
+    /* Free Dispatch Cache */
+    delete [] cache;
+
     /* Handle Termination */
     dispatcher->threadMut.lock();
     {
@@ -538,13 +588,13 @@ void* RecordDispatcher::dispatcherThread(void* parm)
 /*----------------------------------------------------------------------------
  * dispatchRecord
  *----------------------------------------------------------------------------*/
-void RecordDispatcher::dispatchRecord (RecordObject* record, DispatchObject::recVec_t* records)
+void RecordDispatcher::dispatchRecord (RecordObject* record, dispatch_cache_t* cache, DispatchObject::recVec_t* records)
 {
     /* Dispatch Dispatches */
     try
     {
-        const char* rec_type = record->getRecordType();
-        if(StringLib::match(rec_type, ContainerRecord::recType))
+        int type_id = record->getRecordTypeId();
+        if(type_id == containerTypeId && type_id != RecordObject::INVALID_TYPE_ID)
         {
             ContainerRecord::rec_t* container = (ContainerRecord::rec_t*)record->getRecordData();
             
@@ -562,13 +612,14 @@ void RecordDispatcher::dispatchRecord (RecordObject* record, DispatchObject::rec
             /* Dispatch Each Record */
             for(auto& rec: rec_list)
             {
-                dispatchRecord(rec, &rec_list);
+                dispatchRecord(rec, cache, &rec_list);
                 delete rec;
             }
         }
 
-        /* Get Record Type */
-        dispatch_t& dis = dispatchTable[rec_type];
+        /* Get Dispatches for Record Type */
+        dispatch_t dis = getDispatch(record, cache);
+        if(dis.size == 0) return; // no key needed when nothing receives the record
 
         /* Get Key */
         okey_t key = 0;
@@ -601,3 +652,32 @@ void RecordDispatcher::dispatchRecord (RecordObject* record, DispatchObject::rec
         (void)e;
     }
 }
+
+/*----------------------------------------------------------------------------
+ * getDispatch
+ *
+ *  returns the dispatches attached to the record type (an empty list if
+ *  there are none) checking the thread's cache before the dispatch table
+ *----------------------------------------------------------------------------*/
+RecordDispatcher::dispatch_t RecordDispatcher::getDispatch (RecordObject* record, dispatch_cache_t* cache)
+{
+    /* Check Cache */
+    int type_id = record->getRecordTypeId();
+    if(type_id != RecordObject::INVALID_TYPE_ID && cache[type_id].valid)
+    {
+        return cache[type_id].dispatch;
+    }
+
+    /* Look Up Dispatches */
+    dispatch_t dis = { NULL, 0 };
+    dispatchTable.find(record->getRecordType(), &dis);
+
+    /* Add to Cache */
+    if(type_id != RecordObject::INVALID_TYPE_ID)
+    {
+        cache[type_id].dispatch = dis;
+        cache[type_id].valid = true;
+    }
+
+    return dis;
+}
@@ -109,6 +109,8 @@ class RecordDispatcher: public LuaObject
                                                      int num_threads, MsgQ::subscriber_type_t type);
         virtual                 ~RecordDispatcher   (void);
         virtual RecordObject*   createRecord        (unsigned char* buffer, int size);
+        virtual int             countRecords        (unsigned char* msg, int len);
+        virtual unsigned char*  unpackRecord        (unsigned char* msg, int len, int index, int* size);
 
         static int              luaRun              (lua_State* L);
         static int              luaAttachDispatch   (lua_State* L);
@@ -127,6 +129,13 @@ class RecordDispatcher: public LuaObject
             int                 size;
         } dispatch_t;
 
+        /* dispatch table entry used by a dispatcher thread, indexed by record
+         * type id; valid because the table cannot change while running */
+        typedef struct {
+            bool                valid;
+            dispatch_t          dispatch;
+        } dispatch_cache_t;
+
         /*--------------------------------------------------------------------
          * Data
          *--------------------------------------------------------------------*/
@@ -146,13 +155,15 @@ class RecordDispatcher: public LuaObject
         const char*             keyField;       // used with FIELD_KEY_MODE
         calcFunc_f              keyFunc;        // used with CALCULATED_KEY_MODE
         bool                    recError;
+        int                     containerTypeId;
 
         /*--------------------------------------------------------------------
          * Methods
          *--------------------------------------------------------------------*/
 
         static void*    dispatcherThread    (void* parm);
-        void            dispatchRecord      (RecordObject* record, DispatchObject::recVec_t* records=NULL);
+        void            dispatchRecord      (RecordObject* record, dispatch_cache_t* cache, DispatchObject::recVec_t* records=NULL);
+        dispatch_t      getDispatch         (RecordObject* record, dispatch_cache_t* cache);
 
         void            startTdhreads        (void);
         void            stopThreads         (void);
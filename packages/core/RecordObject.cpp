@@ -46,6 +46,7 @@
 #include "Dictionary.h"
 
 #include <math.h>
+#include <type_traits>
 
 /******************************************************************************
  * STATIC DATA
@@ -53,6 +54,9 @@
 
 Dictionary<RecordObject::definition_t*> RecordObject::definitions;
 Mutex RecordObject::defMut;
+std::atomic<RecordObject::definition_t*> RecordObject::lastDefinition{NULL};
+RecordObject::definition_t* RecordObject::typeIds[MAX_TYPE_IDS];
+int RecordObject::numTypeIds = 0;
 
 const char* RecordObject::DEFAULT_DOUBLE_FORMAT = "%.6lf";
 const char* RecordObject::DEFAULT_LONG_FORMAT = "%ld";
@@ -411,6 +415,17 @@ const char* RecordObject::getRecordType(void) const
     return recordDefinition->type_name;
 }
 
+/*----------------------------------------------------------------------------
+ * getRecordTypeId
+ *
+ *  ids are assigned in the order records are defined and are only
+ *  meaningful within this process; they are never serialized
+ *----------------------------------------------------------------------------*/
+int RecordObject::getRecordTypeId(void) const
+{
+    return recordDefinition->type_id;
+}
+
 /*----------------------------------------------------------------------------
  * getRecordId
  *----------------------------------------------------------------------------*/
@@ -909,6 +924,164 @@ long RecordObject::getValueInteger(const field_t& f, int element)
     }
 }
 
+/*----------------------------------------------------------------------------
+ * copyColumn - local helper for getColumn
+ *----------------------------------------------------------------------------*/
+template <typename S, typename T>
+static inline void copyColumn(const unsigned char* src, int stride, int rows, T* values)
+{
+    if(std::is_same<S, T>::value && stride == (int)sizeof(T))
+    {
+        memcpy(values, src, rows * sizeof(T));
+    }
+    else
+    {
+        for(int row = 0; row < rows; row++)
+        {
+            S value;
+            memcpy(&value, src + ((long)row * stride), sizeof(S)); // rows are not necessarily aligned
+            values[row] = (T)value;
+        }
+    }
+}
+
+/*----------------------------------------------------------------------------
+ * getColumn
+ *
+ *  resolves the field once for all the rows; native scalar fields are
+ *  copied directly out of the record, everything else goes through the
+ *  element accessors
+ *----------------------------------------------------------------------------*/
+template <typename T>
+void RecordObject::getColumn(const field_t& f, int stride, int rows, T* values)
+{
+    if(rows <= 0) return;
+    if(stride < 0) throw RunTimeException(CRITICAL, RTE_ERROR, "Invalid column stride: %d", stride);
+
+    /* Check Column Extent (pointed to fields are checked when resolved) */
+    long start = TOBYTES(f.offset);
+    if(!(f.flags & POINTER))
+    {
+        long field_bytes = (f.type == BITFIELD) ? TOBYTES((f.offset % 8) + f.elements + 7) : FIELD_TYPE_BYTES[f.type];
+        long end = start + ((long)(rows - 1) * stride) + field_bytes;
+        if(start < 0 || end > getAllocatedDataSize()) throw RunTimeException(CRITICAL, RTE_ERROR, "Out of range access");
+    }
+
+    /* Direct Access */
+    if(!(f.flags & POINTER) && (f.type != BITFIELD) && (NATIVE_FLAGS == (f.flags & BIGENDIAN)))
+    {
+        const unsigned char* src = recordData + start;
+        switch(f.type)
+        {
+            case INT8:      copyColumn<int8_t>  (src, stride, rows, values); return;
+            case INT16:     copyColumn<int16_t> (src, stride, rows, values); return;
+            case INT32:     copyColumn<int32_t> (src, stride, rows, values); return;
+            case INT64:     copyColumn<int64_t> (src, stride, rows, values); return;
+            case UINT8:     copyColumn<uint8_t> (src, stride, rows, values); return;
+            case UINT16:    copyColumn<uint16_t>(src, stride, rows, values); return;
+            case UINT32:    copyColumn<uint32_t>(src, stride, rows, values); return;
+            case UINT64:    copyColumn<uint64_t>(src, stride, rows, values); return;
+            case FLOAT:     copyColumn<float>   (src, stride, rows, values); return;
+            case DOUBLE:    copyColumn<double>  (src, stride, rows, values); return;
+            case TIME8:     copyColumn<int64_t> (src, stride, rows, values); return;
+            default:        break;
+        }
+    }
+
+    /* Element Access */
+    field_t field = f;
+    for(int row = 0; row < rows; row++)
+    {
+        if(std::is_floating_point<T>::value)    values[row] = (T)getValueReal(field);
+        else                                    values[row] = (T)getValueInteger(field);
+        field.offset += stride * 8;
+    }
+}
+
+/*----------------------------------------------------------------------------
+ * getValueColumn
+ *
+ *  Notes:
+ *   1. stride is the number of bytes between consecutive rows of the batch
+ *   2. a stride of zero repeats the value of the field for every row
+ *----------------------------------------------------------------------------*/
+void RecordObject::getValueColumn(const field_t& field, int stride, int rows, double* values)
+{
+    getColumn(field, stride, rows, values);
+}
+
+/*----------------------------------------------------------------------------
+ * getValueColumn
+ *----------------------------------------------------------------------------*/
+void RecordObject::getValueColumn(const field_t& field, int stride, int rows, float* values)
+{
+    getColumn(field, stride, rows, values);
+}
+
+/*----------------------------------------------------------------------------
+ * getValueColumn
+ *----------------------------------------------------------------------------*/
+void RecordObject::getValueColumn(const field_t& field, int stride, int rows, int8_t* values)
+{
+    getColumn(field, stride, rows, values);
+}
+
+/*----------------------------------------------------------------------------
+ * getValueColumn
+ *----------------------------------------------------------------------------*/
+void RecordObject::getValueColumn(const field_t& field, int stride, int rows, int16_t* values)
+{
+    getColumn(field, stride, rows, values);
+}
+
+/*----------------------------------------------------------------------------
+ * getValueColumn
+ *----------------------------------------------------------------------------*/
+void RecordObject::getValueColumn(const field_t& field, int stride, int rows, int32_t* values)
+{
+    getColumn(field, stride, rows, values);
+}
+
+/*----------------------------------------------------------------------------
+ * getValueColumn
+ *----------------------------------------------------------------------------*/
+void RecordObject::getValueColumn(const field_t& field, int stride, int rows, int64_t* values)
+{
+    getColumn(field, stride, rows, values);
+}
+
+/*----------------------------------------------------------------------------
+ * getValueColumn
+ *----------------------------------------------------------------------------*/
+void RecordObject::getValueColumn(const field_t& field, int stride, int rows, uint8_t* values)
+{
+    getColumn(field, stride, rows, values);
+}
+
+/*----------------------------------------------------------------------------
+ * getValueColumn
+ *----------------------------------------------------------------------------*/
+void RecordObject::getValueColumn(const field_t& field, int stride, int rows, uint16_t* values)
+{
+    getColumn(field, stride, rows, values);
+}
+
+/*----------------------------------------------------------------------------
+ * getValueColumn
+ *----------------------------------------------------------------------------*/
+void RecordObject::getValueColumn(const field_t& field, int stride, int rows, uint32_t* values)
+{
+    getColumn(field, stride, rows, values);
+}
+
+/*----------------------------------------------------------------------------
+ * getValueColumn
+ *----------------------------------------------------------------------------*/
+void RecordObject::getValueColumn(const field_t& field, int stride, int rows, uint64_t* values)
+{
+    getColumn(field, stride, rows, values);
+}
+
 /*----------------------------------------------------------------------------
  * getValueType
  *----------------------------------------------------------------------------*/
@@ -985,6 +1158,27 @@ bool RecordObject::isType(unsigned char* buffer, int size, const char* rec_type)
     return false;
 }
 
+/*----------------------------------------------------------------------------
+ * getRecordTypeId
+ *----------------------------------------------------------------------------*/
+int RecordObject::getRecordTypeId(const char* rec_type)
+{
+    definition_t* def = getDefinition(rec_type);
+    if(def == NULL) return INVALID_TYPE_ID;
+    return def->type_id;
+}
+
+/*----------------------------------------------------------------------------
+ * getRecordTypeName
+ *----------------------------------------------------------------------------*/
+const char* RecordObject::getRecordTypeName(int type_id)
+{
+    if(type_id < 0 || type_id >= MAX_TYPE_IDS) return NULL;
+    definition_t* def = typeIds[type_id];
+    if(def == NULL) return NULL;
+    return def->type_name;
+}
+
 /*----------------------------------------------------------------------------
  * getRecords
  *----------------------------------------------------------------------------*/
@@ -1592,6 +1786,16 @@ RecordObject::recordDefErr_t RecordObject::addDefinition(definition_t** rec_def,
                 def = NULL;
                 status = REGERR_DEF;
             }
+            else if(numTypeIds < MAX_TYPE_IDS)
+            {
+                /* Intern Type */
+                def->type_id = numTypeIds;
+                typeIds[numTypeIds++] = def;
+            }
+            else
+            {
+                mlog(WARNING, "Unable to assign type id to %s, maximum of %d reached", rec_type, MAX_TYPE_IDS);
+            }
         }
         else
         {
@@ -1663,10 +1867,25 @@ RecordObject::recordDefErr_t RecordObject::addField(definition_t* def, const cha
  *----------------------------------------------------------------------------*/
 RecordObject::definition_t* RecordObject::getDefinition(const char* rec_type)
 {
-    definition_t* def = NULL;
-    try { def = definitions[rec_type]; }
-    catch (RunTimeException& e) { (void)e; }
-    return def;
+    /* Check Last Definition
+     *  records are typically processed in runs of the same type,
+     *  so this usually avoids hashing the type name; the load
+     *  pairs with the store below so the definition published by
+     *  another thread is seen fully initialized */
+    definition_t* def = lastDefinition.load(std::memory_order_acquire);
+    if(def && (def->type_name == rec_type || StringLib::match(def->type_name, rec_type)))
+    {
+        return def;
+    }
+
+    /* Look Up Definition */
+    if(definitions.find(rec_type, &def))
+    {
+        lastDefinition.store(def, std::memory_order_release);
+        return def;
+    }
+
+    return NULL;
 }
 
 /*----------------------------------------------------------------------------
@@ -36,6 +36,8 @@
  * INCLUDES
  ******************************************************************************/
 
+#include <atomic>
+
 #include "Dictionary.h"
 #include "StringLib.h"
 #include "MsgQ.h"
@@ -164,6 +166,8 @@ class RecordObject
         static const int    MAX_INITIALIZERS = 64;
         static const int    MAX_VAL_STR_SIZE = 64;
         static const int    CALC_MAX_FIELDS = -1;
+        static const int    MAX_TYPE_IDS = 1024;
+        static const int    INVALID_TYPE_ID = -1;
 
         static const char   IMMEDIATE_FIELD_SYMBOL = '$';
         static const char   ARCHITECTURE_TYPE_SYMBOL = '@';
@@ -219,6 +223,7 @@ class RecordObject
         /* Attribute Methods */
         bool                    isRecordType        (const char* rec_type) const;
         const char*             getRecordType       (void) const; // used to identify type of records (used for parsing)
+        int                     getRecordTypeId     (void) const; // interned type, local to this process
         long                    getRecordId         (void); // used to identify records of the same type (used for filtering))
         unsigned char*          getRecordData       (void) const;
         int                     getRecordTypeSize   (void) const;
@@ -241,6 +246,18 @@ class RecordObject
         double                  getValueReal        (const field_t& field, int element=0);
         long                    getValueInteger     (const field_t& field, int element=0);
 
+        /* Column Methods - values of a field across the rows of a batch record */
+        void                    getValueColumn      (const field_t& field, int stride, int rows, double* values);
+        void                    getValueColumn      (const field_t& field, int stride, int rows, float* values);
+        void                    getValueColumn      (const field_t& field, int stride, int rows, int8_t* values);
+        void                    getValueColumn      (const field_t& field, int stride, int rows, int16_t* values);
+        void                    getValueColumn      (const field_t& field, int stride, int rows, int32_t* values);
+        void                    getValueColumn      (const field_t& field, int stride, int rows, int64_t* values);
+        void                    getValueColumn      (const field_t& field, int stride, int rows, uint8_t* values);
+        void                    getValueColumn      (const field_t& field, int stride, int rows, uint16_t* values);
+        void                    getValueColumn      (const field_t& field, int stride, int rows, uint32_t* values);
+        void                    getValueColumn      (const field_t& field, int stride, int rows, uint64_t* values);
+
         /* Definition Static Methods */
         static field_t          getDefinedField     (const char* rec_type, const char* field_name);
         static valType_t        getValueType        (const field_t& field);
@@ -250,6 +267,8 @@ class RecordObject
         /* Utility Static Methods */
         static bool             isRecord            (const char* rec_type);
         static bool             isType              (unsigned char* buffer, int size, const char* rec_type);
+        static int              getRecordTypeId     (const char* rec_type);
+        static const char*      getRecordTypeName   (int type_id);
         static int              getRecords          (char*** rec_types);
         static const char*      getRecordIdField    (const char* rec_type); // returns name of field
         static int              getRecordSize       (const char* rec_type);
@@ -284,6 +303,7 @@ class RecordObject
         {
             const char*             type_name;      // the name of the type of record
             const char*             id_field;       // field name for id
+            int                     type_id;        // interned type, index into typeIds
             int                     type_size;      // size in bytes of type name string including null termination
             int                     data_size;      // number of bytes of binary data
             int                     record_size;    // total size of memory allocated for record
@@ -294,6 +314,7 @@ class RecordObject
                 { type_name = StringLib::duplicate(_type_name);
                   type_size = (int)StringLib::size(_type_name) + 1;
                   id_field = StringLib::duplicate(_id_field);
+                  type_id = INVALID_TYPE_ID;
                   data_size = _data_size;
                   record_size = sizeof(rec_hdr_t) + type_size + _data_size; }
             ~definition_t(void)
@@ -307,6 +328,9 @@ class RecordObject
 
         static Dictionary<definition_t*>    definitions;
         static Mutex                        defMut;
+        static std::atomic<definition_t*>   lastDefinition; // most recently looked up, definitions are never freed
+        static definition_t*                typeIds[MAX_TYPE_IDS];
+        static int                          numTypeIds;
 
         definition_t*   recordDefinition;
         unsigned char*  recordMemory;       // block of allocated memory <record type as null terminated string><record data as binary>
@@ -323,6 +347,8 @@ class RecordObject
 
         /* Regular Methods */
         field_t                 getPointedToField   (field_t field, bool allow_null, int element=0);
+        template <typename T>
+        void                    getColumn           (const field_t& f, int stride, int rows, T* values);
         static field_t          getUserField        (definition_t* def, const char* field_name);
         static recordDefErr_t   addDefinition       (definition_t** rec_def, const char* rec_type, const char* id_field, int data_size, const fieldDef_t* fields, int num_fields, int max_fields);
         static recordDefErr_t   addField            (definition_t* def, const char* field_name, fieldType_t type, int offset, int elements, const char* exttype, unsigned int flags);
@@ -0,0 +1,357 @@
+/*
+ * Copyright (c) 2021, University of Washington
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the University of Washington nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE UNIVERSITY OF WASHINGTON AND CONTRIBUTORS
+ * “AS IS” AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE UNIVERSITY OF WASHINGTON OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+
+#include "StreamEncoder.h"
+#include "core.h"
+
+#ifdef STREAM_ENCODER_GZIP
+#include <zlib.h>
+#endif
+
+#ifdef STREAM_ENCODER_ZSTD
+#include <zstd.h>
+#endif
+
+/******************************************************************************
+ * PUBLIC METHODS
+ ******************************************************************************/
+
+/*----------------------------------------------------------------------------
+ * negotiate
+ *
+ *  returns the preferred encoding supported by the server out of the encodings
+ *  listed in an Accept-Encoding header (e.g. "gzip, deflate, zstd;q=0.5"); an
+ *  encoding with a zero quality value is treated as not accepted
+ *----------------------------------------------------------------------------*/
+StreamEncoder::encoding_t StreamEncoder::negotiate (const char* accept_encoding)
+{
+    bool gzip_accepted = false;
+    bool zstd_accepted = false;
+
+    if(accept_encoding)
+    {
+        List<string*>* tokens = StringLib::split(accept_encoding, StringLib::size(accept_encoding), ',');
+        for(int i = 0; i < tokens->length(); i++)
+        {
+            /* Separate Coding from Parameters */
+            char coding[MAX_STR_SIZE];
+            StringLib::copy(coding, (*tokens)[i]->c_str(), MAX_STR_SIZE);
+            char* params = StringLib::find(coding, ';');
+            if(params) *params++ = '\0';
+
+            /* Check Quality Value */
+            if(params)
+            {
+                char* qvalue = StringLib::find(params, '=');
+                double q = 1.0;
+                if(qvalue && StringLib::str2double(qvalue + 1, &q) && q <= 0.0) continue;
+            }
+
+            /* Strip Trailing Spaces from Coding */
+            int len = StringLib::size(coding);
+            while(len > 0 && isspace(coding[len - 1])) coding[--len] = '\0';
+
+            /* Check Coding */
+            StringLib::convertLower(coding);
+            if(StringLib::match(coding, "gzip") || StringLib::match(coding, "x-gzip")) gzip_accepted = true;
+            else if(StringLib::match(coding, "zstd")) zstd_accepted = true;
+        }
+        delete tokens;
+    }
+
+    #ifdef STREAM_ENCODER_ZSTD
+    if(zstd_accepted) return ZSTD;
+    #else
+    (void)zstd_accepted;
+    #endif
+
+    #ifdef STREAM_ENCODER_GZIP
+    if(gzip_accepted) return GZIP;
+    #else
+    (void)gzip_accepted;
+    #endif
+
+    return IDENTITY;
+}
+
+/*----------------------------------------------------------------------------
+ * encoding2str
+ *----------------------------------------------------------------------------*/
+const char* StreamEncoder::encoding2str (encoding_t encoding)
+{
+    switch(encoding)
+    {
+        case GZIP:  return "gzip";
+        case ZSTD:  return "zstd";
+        default:    return "identity";
+    }
+}
+
+/*----------------------------------------------------------------------------
+ * Constructor
+ *----------------------------------------------------------------------------*/
+StreamEncoder::StreamEncoder (encoding_t _encoding):
+    encoding(_encoding),
+    stream(NULL),
+    outBuf(NULL),
+    outSize(0),
+    outMax(0),
+    bytesIn(0),
+    bytesOut(0),
+    flushed(true)
+{
+    #ifdef STREAM_ENCODER_GZIP
+    if(encoding == GZIP)
+    {
+        z_stream* zs = new z_stream;
+        memset(zs, 0, sizeof(z_stream));
+        if(deflateInit2(zs, GZIP_LEVEL, Z_DEFLATED, MAX_WBITS + 16, 8, Z_DEFAULT_STRATEGY) != Z_OK) // +16 for gzip wrapper
+        {
+            delete zs;
+            throw RunTimeException(CRITICAL, RTE_ERROR, "failed to initialize gzip stream");
+        }
+        stream = zs;
+    }
+    #endif
+
+    #ifdef STREAM_ENCODER_ZSTD
+    if(encoding == ZSTD)
+    {
+        ZSTD_CCtx* cctx = ZSTD_createCCtx();
+        if(!cctx) throw RunTimeException(CRITICAL, RTE_ERROR, "failed to initialize zstd stream");
+        ZSTD_CCtx_setParameter(cctx, ZSTD_c_compressionLevel, ZSTD_LEVEL);
+        stream = cctx;
+    }
+    #endif
+
+    if(!stream)
+    {
+        throw RunTimeException(CRITICAL, RTE_ERROR, "unsupported stream encoding: %s", encoding2str(encoding));
+    }
+
+    reserve(INITIAL_OUTPUT_SIZE);
+}
+
+/*----------------------------------------------------------------------------
+ * Destructor
+ *----------------------------------------------------------------------------*/
+StreamEncoder::~StreamEncoder (void)
+{
+    #ifdef STREAM_ENCODER_GZIP
+    if(encoding == GZIP)
+    {
+        z_stream* zs = static_cast<z_stream*>(stream);
+        deflateEnd(zs);
+        delete zs;
+    }
+    #endif
+
+    #ifdef STREAM_ENCODER_ZSTD
+    if(encoding == ZSTD)
+    {
+        ZSTD_freeCCtx(static_cast<ZSTD_CCtx*>(stream));
+    }
+    #endif
+
+    delete [] outBuf;
+}
+
+/*----------------------------------------------------------------------------
+ * write
+ *
+ *  compresses data into the output buffer; output is produced as the
+ *  compressor fills blocks, so not everything written is in the output
+ *  until the stream is flushed
+ *----------------------------------------------------------------------------*/
+bool StreamEncoder::write (const void* data, long size)
+{
+    bytesIn += size;
+    flushed = false;
+    return compress(data, size, CONTINUE);
+}
+
+/*----------------------------------------------------------------------------
+ * flush
+ *
+ *  moves everything written so far into the output buffer; when finishing,
+ *  the end of the stream is written and nothing more can be written
+ *----------------------------------------------------------------------------*/
+bool StreamEncoder::flush (bool finish)
+{
+    flushed = true;
+    return compress(NULL, 0, finish ? FINISH : FLUSH);
+}
+
+/*----------------------------------------------------------------------------
+ * getOutput
+ *----------------------------------------------------------------------------*/
+const uint8_t* StreamEncoder::getOutput (long* size) const
+{
+    *size = outSize;
+    return outBuf;
+}
+
+/*----------------------------------------------------------------------------
+ * clearOutput
+ *----------------------------------------------------------------------------*/
+void StreamEncoder::clearOutput (void)
+{
+    outSize = 0;
+}
+
+/*----------------------------------------------------------------------------
+ * isFlushed
+ *----------------------------------------------------------------------------*/
+bool StreamEncoder::isFlushed (void) const
+{
+    return flushed;
+}
+
+/*----------------------------------------------------------------------------
+ * getEncoding
+ *----------------------------------------------------------------------------*/
+StreamEncoder::encoding_t StreamEncoder::getEncoding (void) const
+{
+    return encoding;
+}
+
+/*----------------------------------------------------------------------------
+ * getBytesIn
+ *----------------------------------------------------------------------------*/
+long StreamEncoder::getBytesIn (void) const
+{
+    return bytesIn;
+}
+
+/*----------------------------------------------------------------------------
+ * getBytesOut
+ *----------------------------------------------------------------------------*/
+long StreamEncoder::getBytesOut (void) const
+{
+    return bytesOut;
+}
+
+/******************************************************************************
+ * PRIVATE METHODS
+ ******************************************************************************/
+
+/*----------------------------------------------------------------------------
+ * compress
+ *----------------------------------------------------------------------------*/
+bool StreamEncoder::compress (const void* data, long size, mode_t mode)
+{
+    long start_size = outSize;
+    bool status = false;
+
+    #ifdef STREAM_ENCODER_GZIP
+    if(encoding == GZIP)
+    {
+        z_stream* zs = static_cast<z_stream*>(stream);
+        int flush_mode = (mode == FINISH) ? Z_FINISH : ((mode == FLUSH) ? Z_SYNC_FLUSH : Z_NO_FLUSH);
+        zs->next_in = (Bytef*)data;
+        zs->avail_in = size;
+        status = true;
+        while(true)
+        {
+            /* Deflate into Free Space */
+            reserve(MIN_OUTPUT_SPACE);
+            zs->next_out = &outBuf[outSize];
+            zs->avail_out = outMax - outSize;
+            int rc = deflate(zs, flush_mode);
+            outSize = outMax - zs->avail_out;
+            if(rc == Z_STREAM_ERROR)
+            {
+                status = false;
+                break;
+            }
+
+            /* Done when all input consumed and output not full
+             *  (a finish returns Z_STREAM_END under the same condition) */
+            if(zs->avail_in == 0 && zs->avail_out != 0) break;
+        }
+    }
+    #endif
+
+    #ifdef STREAM_ENCODER_ZSTD
+    if(encoding == ZSTD)
+    {
+        ZSTD_CCtx* cctx = static_cast<ZSTD_CCtx*>(stream);
+        ZSTD_EndDirective directive = (mode == FINISH) ? ZSTD_e_end : ((mode == FLUSH) ? ZSTD_e_flush : ZSTD_e_continue);
+        ZSTD_inBuffer input = {data, (size_t)size, 0};
+        status = true;
+        while(true)
+        {
+            /* Compress into Free Space */
+            reserve(MIN_OUTPUT_SPACE);
+            ZSTD_outBuffer output = {&outBuf[outSize], (size_t)(outMax - outSize), 0};
+            size_t remaining = ZSTD_compressStream2(cctx, &output, &input, directive);
+            outSize += output.pos;
+            if(ZSTD_isError(remaining))
+            {
+                status = false;
+                break;
+            }
+
+            /* Done when all input consumed (and for a flush or finish, nothing left to write) */
+            if(input.pos == input.size && (directive == ZSTD_e_continue || remaining == 0)) break;
+        }
+    }
+    #endif
+
+    (void)data;
+    (void)size;
+    (void)mode;
+
+    bytesOut += outSize - start_size;
+    return status;
+}
+
+/*----------------------------------------------------------------------------
+ * reserve
+ *
+ *  makes sure there is at least space bytes free at the end of the output
+ *----------------------------------------------------------------------------*/
+void StreamEncoder::reserve (long space)
+{
+    if(outMax - outSize < space)
+    {
+        long new_max = MAX(outMax * 2, outSize + space);
+        uint8_t* new_buf = new uint8_t [new_max];
+        if(outSize > 0) memcpy(new_buf, outBuf, outSize);
+        delete [] outBuf;
+        outBuf = new_buf;
+        outMax = new_max;
+    }
+}
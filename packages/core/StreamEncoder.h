@@ -0,0 +1,120 @@
+/*
+ * Copyright (c) 2021, University of Washington
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the University of Washington nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE UNIVERSITY OF WASHINGTON AND CONTRIBUTORS
+ * “AS IS” AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE UNIVERSITY OF WASHINGTON OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __stream_encoder__
+#define __stream_encoder__
+
+/******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+
+#include "OsApi.h"
+
+/******************************************************************************
+ * STREAM ENCODER CLASS
+ ******************************************************************************/
+
+class StreamEncoder
+{
+    public:
+
+        /*--------------------------------------------------------------------
+         * Types
+         *--------------------------------------------------------------------*/
+
+        typedef enum {
+            IDENTITY = 0,
+            GZIP = 1,
+            ZSTD = 2
+        } encoding_t;
+
+        /*--------------------------------------------------------------------
+         * Constants
+         *--------------------------------------------------------------------*/
+
+        static const int GZIP_LEVEL = 3;
+        static const int ZSTD_LEVEL = 3;
+        static const long INITIAL_OUTPUT_SIZE = 0x10000;
+        static const long MIN_OUTPUT_SPACE = 0x4000;
+
+        /*--------------------------------------------------------------------
+         * Methods
+         *--------------------------------------------------------------------*/
+
+        static encoding_t   negotiate       (const char* accept_encoding);
+        static const char*  encoding2str    (encoding_t encoding);
+
+        explicit            StreamEncoder   (encoding_t _encoding);
+                            ~StreamEncoder  (void);
+
+        bool                write           (const void* data, long size);
+        bool                flush           (bool finish);
+        const uint8_t*      getOutput       (long* size) const;
+        void                clearOutput     (void);
+        bool                isFlushed       (void) const;
+        encoding_t          getEncoding     (void) const;
+        long                getBytesIn      (void) const;
+        long                getBytesOut     (void) const;
+
+    private:
+
+        /*--------------------------------------------------------------------
+         * Types
+         *--------------------------------------------------------------------*/
+
+        typedef enum {
+            CONTINUE,
+            FLUSH,
+            FINISH
+        } mode_t;
+
+        /*--------------------------------------------------------------------
+         * Data
+         *--------------------------------------------------------------------*/
+
+        encoding_t          encoding;
+        void*               stream;         // z_stream or ZSTD_CCtx
+        uint8_t*            outBuf;
+        long                outSize;
+        long                outMax;
+        long                bytesIn;
+        long                bytesOut;
+        bool                flushed;        // nothing written since last flush
+
+        /*--------------------------------------------------------------------
+         * Methods
+         *--------------------------------------------------------------------*/
+
+        bool                compress        (const void* data, long size, mode_t mode);
+        void                reserve         (long space);
+};
+
+#endif  /* __stream_encoder__ */
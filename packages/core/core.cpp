@@ -95,6 +95,9 @@ static int core_open (lua_State *L)
         {"csv",             CsvDispatch::luaCreate},
         {"bridge",          MsgBridge::luaCreate},
         {"asset",           Asset::luaCreate},
+        {"blockcache",      BlockCacheIODriver::luaCreateCache},
+        {"blockuncache",    BlockCacheIODriver::luaUncacheFormat},
+        {"blockstats",      BlockCacheIODriver::luaCacheStats},
         {"pointindex",      PointIndex::luaCreate},
         {"intervalindex",   IntervalIndex::luaCreate},
         {"spatialindex",    SpatialIndex::luaCreate},
@@ -174,6 +177,7 @@ void initcore (void)
     /* Register IO Drivers */
     Asset::registerDriver("nil", Asset::IODriver::create);
     Asset::registerDriver(FileIODriver::FORMAT, FileIODriver::create);
+    Asset::registerDriver(MmapIODriver::FORMAT, MmapIODriver::create);
 
     /* Initialize Modules */
     LuaEndpoint::init();
@@ -204,6 +208,7 @@ void initcore (void)
 void deinitcore (void)
 {
     print2term("Exiting... ");
+    BlockCacheIODriver::deinit();
     LuaEngine::deinit();
     EventLib::deinit();
     TimeLib::deinit();
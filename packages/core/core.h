@@ -40,6 +40,7 @@
 
 #include "Asset.h"
 #include "AssetIndex.h"
+#include "BlockCacheIODriver.h"
 #include "CaptureDispatch.h"
 #include "ClusterSocket.h"
 #include "ContainerRecord.h"
@@ -70,6 +71,7 @@
 #include "MathLib.h"
 #include "MetricDispatch.h"
 #include "MetricRecord.h"
+#include "MmapIODriver.h"
 #include "Monitor.h"
 #include "MsgBridge.h"
 #include "MsgProcessor.h"
@@ -81,6 +83,7 @@
 #include "RecordDispatcher.h"
 #include "ReportDispatch.h"
 #include "SpatialIndex.h"
+#include "StreamEncoder.h"
 #include "StringLib.h"
 #include "Table.h"
 #include "TcpSocket.h"
@@ -34,6 +34,7 @@
  ******************************************************************************/
 
 #include "RasterSample.h"
+#include "RasterBlockCache.h"
 #include "GdalRaster.h"
 
 #ifdef __aws__
@@ -70,7 +71,8 @@ GdalRaster::GdalRaster(GeoParms* _parms, const std::string& _fileName, double _g
    cellSize   (0),
    bbox       (),
    radiusInPixels(0),
-   ssError    (SS_NO_ERRORS)
+   ssError    (SS_NO_ERRORS),
+   cacheBlocks(fileName.rfind("/vsimem/", 0) != 0) // in memory rasters are not worth caching
 {
 }
 
@@ -131,7 +133,7 @@ void GdalRaster::open(void)
                                parms->sampling_radius, MAX_SAMPLING_RADIUS_IN_PIXELS * static_cast<int>(cellSize));
     }
 
-    band = dset->GetRasterBand(1);
+    band = dset->GetRasterBand(BAND_NUMBER);
     CHECKPTR(band);
 
     /* Create coordinates transform for raster */
@@ -490,105 +492,50 @@ void GdalRaster::readPixel(const OGRPoint* poi, RasterSample* sample)
         int xblk = x / xBlockSize;
         int yblk = y / yBlockSize;
 
-        GDALRasterBlock* block = NULL;
-        int cnt = 1;
-        do
-        {
-            /* Retry read if error */
-            block = band->GetLockedBlockRef(xblk, yblk, false);
-        } while(block == NULL && cnt-- && s3sleep());
-        CHECKPTR(block);
-
-        /* Get data block pointer, no memory copied but block is locked */
-        void* data = block->GetDataRef();
-        if (data == NULL)
-        {
-            /* Before bailing release the block... */
-            block->DropLock();
-            CHECKPTR(data);
-        }
-
         /* Calculate x, y inside of block */
         int _x = x % xBlockSize;
         int _y = y % yBlockSize;
         int offset = _y * xBlockSize + _x;
 
-        /* Be carefull using offset based on the pixel data type */
-        switch(band->GetRasterDataType())
+        /* Read from SlideRule's block cache, which outlives this dataset */
+        if(!cacheBlocks || !RasterBlockCache::getValue(fileName, BAND_NUMBER, xblk, yblk, offset, sample->value))
         {
-            case GDT_Byte:
-            {
-                uint8_t* p   = static_cast<uint8_t*>(data);
-                sample->value = p[offset];
-            }
-            break;
-
-            case GDT_UInt16:
-            {
-                uint16_t* p  = static_cast<uint16_t*>(data);
-                sample->value = p[offset];
-            }
-            break;
-
-            case GDT_Int16:
-            {
-                int16_t* p   = static_cast<int16_t*>(data);
-                sample->value = p[offset];
-            }
-            break;
-
-            case GDT_UInt32:
-            {
-                uint32_t* p  = static_cast<uint32_t*>(data);
-                sample->value = p[offset];
-            }
-            break;
-
-            case GDT_Int32:
-            {
-                int32_t* p   = static_cast<int32_t*>(data);
-                sample->value = p[offset];
-            }
-            break;
-
-            case GDT_Int64:
+            GDALRasterBlock* block = NULL;
+            int cnt = 1;
+            do
             {
-                int64_t* p   = static_cast<int64_t*>(data);
-                sample->value = p[offset];
-            }
-            break;
-
-            case GDT_UInt64:
+                /* Retry read if error */
+                block = band->GetLockedBlockRef(xblk, yblk, false);
+            } while(block == NULL && cnt-- && s3sleep());
+            CHECKPTR(block);
+
+            /* Get data block pointer, no memory copied but block is locked */
+            void* data = block->GetDataRef();
+            if (data == NULL)
             {
-                uint64_t* p  = static_cast<uint64_t*>(data);
-                sample->value = p[offset];
+                /* Before bailing release the block... */
+                block->DropLock();
+                CHECKPTR(data);
             }
-            break;
 
-            case GDT_Float32:
+            GDALDataType dtype = band->GetRasterDataType();
+            if(!RasterBlockCache::blockValue(data, dtype, offset, sample->value))
             {
-                float* p     = static_cast<float*>(data);
-                sample->value = p[offset];
+                block->DropLock();
+                throw RunTimeException(CRITICAL, RTE_ERROR, "Unsuported data type in raster: %s:", fileName.c_str());
             }
-            break;
 
-            case GDT_Float64:
+            /* Cache decoded block for neighbouring points */
+            if(cacheBlocks)
             {
-                double* p    = static_cast<double*>(data);
-                sample->value = p[offset];
+                long block_size = static_cast<long>(xBlockSize) * yBlockSize * GDALGetDataTypeSizeBytes(dtype);
+                RasterBlockCache::addBlock(fileName, BAND_NUMBER, xblk, yblk, dtype, data, block_size);
             }
-            break;
 
-            default:
-                /*
-                 * Complex numbers are supported but not needed at this point.
-                 */
-                block->DropLock();
-                throw RunTimeException(CRITICAL, RTE_ERROR, "Unsuported data type in raster: %s:", fileName.c_str());
+            /* Done reading, release block lock */
+            block->DropLock();
         }
 
-        /* Done reading, release block lock */
-        block->DropLock();
         if(nodataCheck(sample) && dataIsElevation)
         {
             sample->value += sample->verticalShift;
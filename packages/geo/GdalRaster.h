@@ -82,6 +82,7 @@ class GdalRaster
 
         static const int MAX_SAMPLING_RADIUS_IN_PIXELS = 50;
         static const int SLIDERULE_EPSG                = 7912;
+        static const int BAND_NUMBER                   = 1;
 
         /*--------------------------------------------------------------------
          * Typedefs
@@ -152,6 +153,7 @@ class GdalRaster
         double          geoTransform[6];
         double          invGeoTransform[6];
         uint32_t        ssError;
+        bool            cacheBlocks; /* use RasterBlockCache for pixel reads */
 
         /*--------------------------------------------------------------------
         * Methods
@@ -36,6 +36,7 @@
 #include "GeoIndexedRaster.h"
 
 #include <algorithm>
+#include <set>
 #include <gdal.h>
 #include <gdalwarper.h>
 #include <gdal_priv.h>
@@ -50,53 +51,70 @@
 const char* GeoIndexedRaster::FLAGS_TAG = "Fmask";
 const char* GeoIndexedRaster::VALUE_TAG = "Value";
 
+Publisher*  GeoIndexedRaster::readerPub = NULL;
+Subscriber* GeoIndexedRaster::readerSub = NULL;
+bool        GeoIndexedRaster::readerActive = false;
+Thread**    GeoIndexedRaster::readerPids = NULL;
+int         GeoIndexedRaster::readerPoolSize = 0;
+
 /******************************************************************************
  * PUBLIC METHODS
  ******************************************************************************/
 
 /*----------------------------------------------------------------------------
- * Reader Constructor
+ * init
  *----------------------------------------------------------------------------*/
-GeoIndexedRaster::Reader::Reader (GeoIndexedRaster* raster):
-    obj(raster),
-    geo(NULL),
-    entry(NULL),
-    sync(NUM_SYNC_SIGNALS),
-    run(true)
+void GeoIndexedRaster::init (void)
 {
-    thread = new Thread(GeoIndexedRaster::readingThread, this);
 }
 
 /*----------------------------------------------------------------------------
- * Reader Destructor
+ * deinit
  *----------------------------------------------------------------------------*/
-GeoIndexedRaster::Reader::~Reader (void)
+void GeoIndexedRaster::deinit (void)
 {
-    sync.lock();
-    {
-        run = false; /* Set run flag to false */
-        sync.signal(DATA_TO_SAMPLE, Cond::NOTIFY_ONE);
-    }
-    sync.unlock();
-
-    delete thread; /* delete thread waits on thread to join */
-
-    /* geometry geo is cloned not 'newed' on GDAL heap. Use this call to free it */
-    if(geo) OGR_G_DestroyGeometry(geo);
 }
 
 /*----------------------------------------------------------------------------
- * init
+ * initReaders
+ *
+ *  starts the pool of reader threads shared by all indexed rasters; with no
+ *  threads, rasters are read by the thread doing the sampling
  *----------------------------------------------------------------------------*/
-void GeoIndexedRaster::init (void)
+void GeoIndexedRaster::initReaders (int num_threads)
 {
+    readerPub = new Publisher(NULL);
+
+    if(num_threads > 0)
+    {
+        readerActive = true;
+        readerSub = new Subscriber(*readerPub);
+        readerPoolSize = num_threads;
+        readerPids = new Thread* [readerPoolSize];
+        for(int t = 0; t < readerPoolSize; t++)
+        {
+            readerPids[t] = new Thread(readerThread, NULL);
+        }
+    }
 }
 
 /*----------------------------------------------------------------------------
- * deinit
+ * deinitReaders
  *----------------------------------------------------------------------------*/
-void GeoIndexedRaster::deinit (void)
+void GeoIndexedRaster::deinitReaders (void)
 {
+    if(readerActive)
+    {
+        readerActive = false;
+        for(int t = 0; t < readerPoolSize; t++)
+        {
+            delete readerPids[t];
+        }
+        delete [] readerPids;
+        delete readerSub;
+    }
+
+    delete readerPub;
 }
 
 
@@ -157,6 +175,110 @@ uint32_t GeoIndexedRaster::getSamples(OGRGeometry* geo, int64_t gps, std::vector
     return ssError;
 }
 
+/*----------------------------------------------------------------------------
+ * getBatchSamples
+ *
+ *  Points are grouped by the rasters they intersect so that each raster is
+ *  opened once and samples all of its points in a single reader task.
+ *  Consecutive points share a wave of up to MAX_CACHED_RASTERS rasters;
+ *  when the next point would exceed it the wave is sampled and a new one is
+ *  started, which for points ordered along a track keeps tiles cached.
+ *----------------------------------------------------------------------------*/
+uint32_t GeoIndexedRaster::getBatchSamples(const std::vector<point_info_t>& points, std::vector<std::vector<RasterSample*>>& sllist, void* param)
+{
+    std::ignore = param;
+
+    samplingMutex.lock();
+    try
+    {
+        ssError = SS_NO_ERRORS;
+        sllist.resize(points.size());
+
+        std::vector<batch_point_t> batch;
+        int waveRasters = 0;
+        resetBatch();
+
+        for(uint32_t i = 0; i < points.size(); i++)
+        {
+            const OGRGeometry* geo = &points[i].point;
+
+            /* Find raster groups for this point */
+            groupList.clear();
+            if(geoIndexPoly.IsEmpty() || !geoIndexPoly.Contains(geo))
+            {
+                if(!openGeoIndex(geo))
+                    continue;
+            }
+            if(!findRasters(geo) || !filterRasters(points[i].gps))
+                continue;
+
+            /* Count rasters needed by point and those not yet in the wave */
+            std::set<std::string> pointRasters;
+            int newRasters = 0;
+            GroupOrdering::Iterator group_iter(groupList);
+            for(int j = 0; j < group_iter.length; j++)
+            {
+                for(const auto& rinfo: group_iter[j].value->infovect)
+                {
+                    if(pointRasters.insert(rinfo.fileName).second)
+                    {
+                        cacheitem_t* item;
+                        if(!cache.find(rinfo.fileName.c_str(), &item) || !item->enabled)
+                            newRasters++;
+                    }
+                }
+            }
+
+            /* Sample current wave if point does not fit in it */
+            int numRasters = pointRasters.size();
+            if(waveRasters > 0 && waveRasters + newRasters > MAX_CACHED_RASTERS)
+            {
+                sampleBatch(points, batch, sllist);
+                batch.clear();
+                waveRasters = 0;
+                newRasters = numRasters;
+            }
+
+            /* Add point to wave */
+            batch.emplace_back();
+            batch_point_t& bp = batch.back();
+            bp.index = i;
+            for(int j = 0; j < group_iter.length; j++)
+            {
+                const rasters_group_t* rgroup = group_iter[j].value;
+                bp.groups.push_back(*rgroup);
+                for(const auto& rinfo: rgroup->infovect)
+                {
+                    cacheitem_t* item = getCacheItem(rgroup, rinfo);
+                    item->enabled = true;
+                    if(item->batchPoints.empty() || item->batchPoints.back() != i)
+                    {
+                        item->batchPoints.push_back(i);
+                        bp.slots.push_back({item, static_cast<uint32_t>(item->batchPoints.size() - 1)});
+                    }
+                }
+            }
+            waveRasters += newRasters;
+        }
+
+        /* Sample last wave */
+        if(!batch.empty())
+        {
+            sampleBatch(points, batch, sllist);
+        }
+    }
+    catch (const RunTimeException &e)
+    {
+        mlog(e.level(), "Error getting batch samples: %s", e.what());
+    }
+
+    /* Free Unreturned Results */
+    resetBatch();
+    samplingMutex.unlock();
+
+    return ssError;
+}
+
 /*----------------------------------------------------------------------------
  * getSubset
  *----------------------------------------------------------------------------*/
@@ -207,7 +329,7 @@ GeoIndexedRaster::~GeoIndexedRaster(void)
  *----------------------------------------------------------------------------*/
 GeoIndexedRaster::GeoIndexedRaster(lua_State *L, GeoParms* _parms, GdalRaster::overrideCRS_t cb):
     RasterObject (L, _parms),
-    cache        (MAX_READER_THREADS),
+    cache        (MAX_CACHED_RASTERS),
     ssError      (SS_NO_ERRORS),
     crscb        (cb),
     bbox         {0, 0, 0, 0},
@@ -428,44 +550,48 @@ bool GeoIndexedRaster::openGeoIndex(const OGRGeometry* geo)
 
 /*----------------------------------------------------------------------------
  * sampleRasters
+ *
+ *  queues one task per cached raster to the shared reader pool and waits for
+ *  all of them to complete
  *----------------------------------------------------------------------------*/
-void GeoIndexedRaster::sampleRasters(OGRGeometry* geo)
+void GeoIndexedRaster::sampleRasters(OGRGeometry* geo, const std::vector<point_info_t>* points)
 {
-    /* Create additional reader threads if needed */
-    createThreads();
+    reader_sync_t sync;
+    sync.pending = 0;
 
-    /* For each raster which is marked to be sampled, give it to the reader thread */
-    int signaledReaders = 0;
-    int i = 0;
     cacheitem_t* item;
-
     const char* key = cache.first(&item);
     while(key != NULL)
     {
-        reader_t* reader = readers[i++];
-        reader->sync.lock();
+        reader_task_t task = {
+            .entry  = item,
+            .geo    = geo,
+            .points = points,
+            .sync   = &sync
+        };
+
+        sync.cond.lock();
         {
-            reader->entry = item;
-            if(reader->geo) OGR_G_DestroyGeometry(reader->geo);
-            reader->geo = geo->clone();
-            reader->sync.signal(DATA_TO_SAMPLE, Cond::NOTIFY_ONE);
-            signaledReaders++;
+            sync.pending++;
         }
-        reader->sync.unlock();
+        sync.cond.unlock();
+
+        if(!readerActive || readerPub->postCopy(&task, sizeof(reader_task_t), IO_CHECK) <= 0)
+        {
+            /* No reader available, read raster on this thread */
+            readRaster(task);
+        }
+
         key = cache.next(&item);
     }
 
     /* Wait for readers to finish sampling */
-    for(int j = 0; j < signaledReaders; j++)
+    sync.cond.lock();
     {
-        reader_t* reader = readers[j];
-        reader->sync.lock();
-        {
-            while(reader->entry != NULL)
-                reader->sync.wait(DATA_SAMPLED, SYS_TIMEOUT);
-        }
-        reader->sync.unlock();
+        while(sync.pending > 0)
+            sync.cond.wait(0, SYS_TIMEOUT);
     }
+    sync.cond.unlock();
 }
 
 
@@ -486,8 +612,9 @@ bool GeoIndexedRaster::sample(OGRGeometry* geo, int64_t gps)
             return status;
     }
 
-    if(findRasters(geo) && filterRasters(gps) && updateCache())
+    if(findRasters(geo) && filterRasters(gps))
     {
+        updateCache();
         sampleRasters(geo);
         status = true;
     }
@@ -607,37 +734,24 @@ int GeoIndexedRaster::luaCellSize(lua_State *L)
 }
 
 /*----------------------------------------------------------------------------
- * readingThread
+ * readerThread
  *----------------------------------------------------------------------------*/
-void* GeoIndexedRaster::readingThread(void *param)
+void* GeoIndexedRaster::readerThread(void *param)
 {
-    reader_t *reader = (reader_t*)param;
+    (void)param;
 
-    while(reader->run)
+    while(readerActive)
     {
-        reader->sync.lock();
+        reader_task_t task;
+        int recv_status = readerSub->receiveCopy(&task, sizeof(reader_task_t), SYS_TIMEOUT);
+        if(recv_status > 0)
         {
-            /* Wait for raster to work on */
-            while((reader->entry == NULL) && reader->run)
-                reader->sync.wait(DATA_TO_SAMPLE, SYS_TIMEOUT);
+            readRaster(task);
         }
-        reader->sync.unlock();
-
-        cacheitem_t* entry = reader->entry;
-        if(entry != NULL)
+        else if(recv_status != MsgQ::STATE_TIMEOUT)
         {
-            if(GdalRaster::ispoint(reader->geo))
-                entry->sample = entry->raster->samplePOI((OGRPoint*)reader->geo);
-            else if(GdalRaster::ispoly(reader->geo))
-                entry->subset = entry->raster->subsetAOI((OGRPolygon*)reader->geo);
-            entry->enabled = false; /* raster samples/subsetted */
-
-            reader->sync.lock();
-            {
-                reader->entry = NULL; /* Done with this raster */
-                reader->sync.signal(DATA_SAMPLED, Cond::NOTIFY_ONE);
-            }
-            reader->sync.unlock();
+            mlog(CRITICAL, "Failed to receive raster reader task: %d", recv_status);
+            break;
         }
     }
 
@@ -645,29 +759,54 @@ void* GeoIndexedRaster::readingThread(void *param)
 }
 
 /*----------------------------------------------------------------------------
- * createThreads
+ * readRaster
  *----------------------------------------------------------------------------*/
-void GeoIndexedRaster::createThreads(void)
+void GeoIndexedRaster::readRaster(const reader_task_t& task)
 {
-    int threadsNeeded = cache.length();
-    int threadsNow    = readers.length();
-    int newThreadsCnt = threadsNeeded - threadsNow;
+    cacheitem_t* entry = task.entry;
 
-    if(threadsNeeded <= threadsNow)
-        return;
+    try
+    {
+        if(task.points)
+        {
+            for(uint32_t index: entry->batchPoints)
+            {
+                /* samplePOI transforms the point it is given */
+                OGRPoint poi((*task.points)[index].point);
+                entry->batchSamples.push_back(entry->raster->samplePOI(&poi));
+            }
+        }
+        else
+        {
+            /* geometry is cloned not 'newed' on GDAL heap, samplePOI/subsetAOI transform it */
+            OGRGeometry* geo = task.geo->clone();
+            if(GdalRaster::ispoint(geo))
+                entry->sample = entry->raster->samplePOI((OGRPoint*)geo);
+            else if(GdalRaster::ispoly(geo))
+                entry->subset = entry->raster->subsetAOI((OGRPolygon*)geo);
+            OGR_G_DestroyGeometry(geo);
+        }
+    }
+    catch (const RunTimeException &e)
+    {
+        mlog(e.level(), "Error reading raster %s: %s", entry->raster->getFileName().c_str(), e.what());
+    }
+    entry->enabled = false; /* raster samples/subsetted */
 
-    for(int i = 0; i < newThreadsCnt; i++)
+    /* Done with this raster */
+    task.sync->cond.lock();
     {
-        Reader* r = new Reader(this);
-        readers.add(r);
+        task.sync->pending--;
+        if(task.sync->pending == 0)
+            task.sync->cond.signal(0, Cond::NOTIFY_ONE);
     }
-    assert(readers.length() == threadsNeeded);
+    task.sync->cond.unlock();
 }
 
 /*----------------------------------------------------------------------------
  * updateCache
  *----------------------------------------------------------------------------*/
-bool GeoIndexedRaster::updateCache(void)
+void GeoIndexedRaster::updateCache(void)
 {
     /* Cache contains items/rasters from previous sample run */
     GroupOrdering::Iterator group_iter(groupList);
@@ -676,35 +815,52 @@ bool GeoIndexedRaster::updateCache(void)
         const rasters_group_t* rgroup = group_iter[i].value;
         for(const auto& rinfo : rgroup->infovect)
         {
-            const char* key = rinfo.fileName.c_str();
-            cacheitem_t* item;
-            bool inCache = cache.find(key, &item);
-            if(!inCache)
-            {
-                /* Limit area of interest to the extent of vector index file */
-                parms->aoi_bbox = bbox;
-
-                /* Create new cache item with raster */
-                item = new cacheitem_t;
-                item->raster = new GdalRaster(parms, rinfo.fileName,
-                                              static_cast<double>(rgroup->gpsTime / 1000),
-                                              fileDictAdd(rinfo.fileName),
-                                              rinfo.dataIsElevation, crscb);
-                item->sample = NULL;
-                item->subset = NULL;
-                bool status = cache.add(key, item);
-                assert(status); (void)status; // cannot fail; prevents linter warnings
-            }
+            cacheitem_t* item = getCacheItem(rgroup, rinfo);
 
             /* Mark as Enabled */
             item->enabled = true;
         }
     }
 
-    /*
-     * Maintain cache from getting too big.
-     * Find all cache items not needed for this sample run.
-     */
+    /* Maintain cache from getting too big */
+    trimCache();
+}
+
+/*----------------------------------------------------------------------------
+ * getCacheItem
+ *----------------------------------------------------------------------------*/
+GeoIndexedRaster::cacheitem_t* GeoIndexedRaster::getCacheItem(const rasters_group_t* rgroup, const raster_info_t& rinfo)
+{
+    const char* key = rinfo.fileName.c_str();
+    cacheitem_t* item;
+    bool inCache = cache.find(key, &item);
+    if(!inCache)
+    {
+        /* Limit area of interest to the extent of vector index file */
+        parms->aoi_bbox = bbox;
+
+        /* Create new cache item with raster */
+        item = new cacheitem_t;
+        item->raster = new GdalRaster(parms, rinfo.fileName,
+                                      static_cast<double>(rgroup->gpsTime / 1000),
+                                      fileDictAdd(rinfo.fileName),
+                                      rinfo.dataIsElevation, crscb);
+        item->enabled = false;
+        item->sample = NULL;
+        item->subset = NULL;
+        bool status = cache.add(key, item);
+        assert(status); (void)status; // cannot fail; prevents linter warnings
+    }
+
+    return item;
+}
+
+/*----------------------------------------------------------------------------
+ * trimCache
+ *----------------------------------------------------------------------------*/
+void GeoIndexedRaster::trimCache(void)
+{
+    /* Find all cache items not needed for this sample run */
     std::vector<const char*> keys_to_remove;
     {
         cacheitem_t* item;
@@ -724,16 +880,68 @@ bool GeoIndexedRaster::updateCache(void)
     {
         cache.remove(key);
     }
+}
+
+/*----------------------------------------------------------------------------
+ * sampleBatch
+ *----------------------------------------------------------------------------*/
+void GeoIndexedRaster::sampleBatch(const std::vector<point_info_t>& points, std::vector<batch_point_t>& batch, std::vector<std::vector<RasterSample*>>& sllist)
+{
+    /* Sample every raster in the wave with all of its points */
+    trimCache();
+    sampleRasters(NULL, &points);
 
-    /* Check for max limit of concurent reading raster threads */
-    if(cache.length() > MAX_READER_THREADS)
+    /* Regroup samples by point */
+    for(const batch_point_t& bp: batch)
     {
-        ssError |= SS_THREADS_LIMIT_ERROR;
-        mlog(ERROR, "Too many rasters to read: %d, max allowed: %d", cache.length(), MAX_READER_THREADS);
-        return false;
+        for(const batch_slot_t& bs: bp.slots)
+        {
+            bs.item->sample = bs.item->batchSamples[bs.slot];
+            bs.item->batchSamples[bs.slot] = NULL;
+        }
+
+        for(const rasters_group_t& rgroup: bp.groups)
+        {
+            uint32_t flags = 0;
+
+            /* Get flags value for this group of rasters */
+            if(parms->flags_file)
+                flags = getGroupFlags(&rgroup);
+
+            getGroupSamples(&rgroup, sllist[bp.index], flags);
+        }
+
+        /* Free Unreturned Results */
+        for(const batch_slot_t& bs: bp.slots)
+        {
+            delete bs.item->sample;
+            bs.item->sample = NULL;
+        }
     }
 
-    return true;
+    resetBatch();
+}
+
+/*----------------------------------------------------------------------------
+ * resetBatch
+ *----------------------------------------------------------------------------*/
+void GeoIndexedRaster::resetBatch(void)
+{
+    cacheitem_t* item;
+    const char* key = cache.first(&item);
+    while(key != NULL)
+    {
+        delete item->sample;
+        item->sample = NULL;
+        for(RasterSample* sample: item->batchSamples)
+        {
+            delete sample;
+        }
+        item->batchSamples.clear();
+        item->batchPoints.clear();
+        item->enabled = false;
+        key = cache.next(&item);
+    }
 }
 
 /*----------------------------------------------------------------------------
@@ -39,6 +39,7 @@
 #include "GdalRaster.h"
 #include "RasterObject.h"
 #include "Ordering.h"
+#include "MsgQ.h"
 
 
 /******************************************************************************
@@ -53,7 +54,7 @@ class GeoIndexedRaster: public RasterObject
          * Constants
          *--------------------------------------------------------------------*/
 
-        static const int   MAX_READER_THREADS = 200;
+        static const int   MAX_CACHED_RASTERS = 200; // rasters sampled together in one batch wave
 
         static const char* FLAGS_TAG;
         static const char* VALUE_TAG;
@@ -76,31 +77,25 @@ class GeoIndexedRaster: public RasterObject
         } rasters_group_t;
 
         typedef struct CacheItem {
-            bool            enabled;
-            RasterSample*   sample;
-            RasterSubset*   subset;
-            GdalRaster*     raster;
+            bool                        enabled;
+            RasterSample*               sample;
+            RasterSubset*               subset;
+            GdalRaster*                 raster;
+            std::vector<uint32_t>       batchPoints;  // indices of batch points sampled by this raster
+            std::vector<RasterSample*>  batchSamples; // one sample (or NULL) per entry in batchPoints
             ~CacheItem(void) {delete raster;}
         } cacheitem_t;
 
-        typedef struct Reader {
-            GeoIndexedRaster*   obj;
-            OGRGeometry*        geo;
-            Thread*             thread;
-            cacheitem_t*        entry;
-            Cond                sync;
-            bool                run;
-            explicit Reader(GeoIndexedRaster* raster);
-            ~Reader(void);
-        } reader_t;
-
         /*--------------------------------------------------------------------
          * Methods
          *--------------------------------------------------------------------*/
 
         static void     init              (void);
         static void     deinit            (void);
+        static void     initReaders       (int num_threads);
+        static void     deinitReaders     (void);
         uint32_t        getSamples        (OGRGeometry* geo, int64_t gps, std::vector<RasterSample*>& slist, void* param=NULL) final;
+        uint32_t        getBatchSamples   (const std::vector<point_info_t>& points, std::vector<std::vector<RasterSample*>>& sllist, void* param=NULL) final;
         uint32_t        getSubsets        (OGRGeometry* geo, int64_t gps, std::vector<RasterSubset*>& slist, void* param=NULL) final;
         virtual        ~GeoIndexedRaster  (void);
 
@@ -118,7 +113,7 @@ class GeoIndexedRaster: public RasterObject
         virtual bool    openGeoIndex          (const OGRGeometry* geo);
         virtual void    getIndexFile          (const OGRGeometry* geo, std::string& file) = 0;
         virtual bool    findRasters           (const OGRGeometry* geo) = 0;
-        void            sampleRasters         (OGRGeometry* geo);
+        void            sampleRasters         (OGRGeometry* geo, const std::vector<point_info_t>* points=NULL);
         bool            sample                (OGRGeometry* geo, int64_t gps);
         void            emptyFeaturesList     (void);
 
@@ -146,15 +141,43 @@ class GeoIndexedRaster: public RasterObject
          * Constants
          *--------------------------------------------------------------------*/
 
-        static const int DATA_TO_SAMPLE   = 0;
-        static const int DATA_SAMPLED     = 1;
-        static const int NUM_SYNC_SIGNALS = 2;
+        /*--------------------------------------------------------------------
+         * Types
+         *--------------------------------------------------------------------*/
+
+        typedef struct {
+            Cond            cond;
+            int             pending;    // tasks posted and not yet completed
+        } reader_sync_t;
+
+        typedef struct {
+            cacheitem_t*                        entry;
+            const OGRGeometry*                  geo;    // NULL when sampling a batch
+            const std::vector<point_info_t>*    points; // set when sampling a batch
+            reader_sync_t*                      sync;
+        } reader_task_t;
+
+        typedef struct {
+            cacheitem_t*    item;
+            uint32_t        slot;       // index into item's batchSamples
+        } batch_slot_t;
+
+        typedef struct {
+            uint32_t                        index;  // index into caller's points
+            std::vector<rasters_group_t>    groups; // raster groups found for the point
+            std::vector<batch_slot_t>       slots;  // one per unique raster in groups
+        } batch_point_t;
 
         /*--------------------------------------------------------------------
          * Data
          *--------------------------------------------------------------------*/
 
-        List<reader_t*>           readers;
+        static Publisher*         readerPub;
+        static Subscriber*        readerSub;
+        static bool               readerActive;
+        static Thread**           readerPids; // thread pool shared by all indexed rasters
+        static int                readerPoolSize;
+
         GdalRaster::overrideCRS_t crscb;
 
         std::string               indexFile;
@@ -170,10 +193,14 @@ class GeoIndexedRaster: public RasterObject
         static int      luaBoundingBox  (lua_State* L);
         static int      luaCellSize     (lua_State* L);
 
-        static void*    readingThread   (void *param);
+        static void*    readerThread    (void *param);
+        static void     readRaster      (const reader_task_t& task);
 
-        void            createThreads   (void);
-        bool            updateCache     (void);
+        cacheitem_t*    getCacheItem    (const rasters_group_t* rgroup, const raster_info_t& rinfo);
+        void            trimCache       (void);
+        void            updateCache     (void);
+        void            sampleBatch     (const std::vector<point_info_t>& points, std::vector<batch_point_t>& batch, std::vector<std::vector<RasterSample*>>& sllist);
+        void            resetBatch      (void);
         bool            filterRasters   (int64_t gps);
 };
 
@@ -62,6 +62,36 @@ uint32_t GeoRaster::getSamples(OGRGeometry* geo, int64_t gps, std::vector<Raster
     return raster.getSSerror();
 }
 
+/*----------------------------------------------------------------------------
+ * getBatchSamples
+ *----------------------------------------------------------------------------*/
+uint32_t GeoRaster::getBatchSamples(const std::vector<point_info_t>& points, std::vector<std::vector<RasterSample*>>& sllist, void* param)
+{
+    std::ignore = param;
+
+    uint32_t errors = SS_NO_ERRORS;
+    sllist.resize(points.size());
+
+    samplingMutex.lock();
+    try
+    {
+        for(size_t i = 0; i < points.size(); i++)
+        {
+            OGRPoint poi(points[i].point);
+            RasterSample* sample = raster.samplePOI(&poi);
+            if(sample) sllist[i].push_back(sample);
+            errors |= raster.getSSerror();
+        }
+    }
+    catch (const RunTimeException &e)
+    {
+        mlog(e.level(), "Error getting samples: %s", e.what());
+    }
+    samplingMutex.unlock();
+
+    return errors;
+}
+
 /*----------------------------------------------------------------------------
  * getSubsets
  *----------------------------------------------------------------------------*/
@@ -0,0 +1,303 @@
+/*
+ * Copyright (c) 2021, University of Washington
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the University of Washington nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE UNIVERSITY OF WASHINGTON AND CONTRIBUTORS
+ * “AS IS” AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE UNIVERSITY OF WASHINGTON OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+
+#include "RasterBlockCache.h"
+#include "LuaObject.h"
+
+/******************************************************************************
+ * STATIC DATA
+ ******************************************************************************/
+
+Mutex                                       RasterBlockCache::cacheMut;
+Dictionary<RasterBlockCache::block_t*>      RasterBlockCache::blocks;
+RasterBlockCache::block_t*                  RasterBlockCache::newest = NULL;
+RasterBlockCache::block_t*                  RasterBlockCache::oldest = NULL;
+long                                        RasterBlockCache::cacheBytes = 0;
+long                                        RasterBlockCache::maxBytes = DEFAULT_MAX_BYTES;
+uint64_t                                    RasterBlockCache::hits = 0;
+uint64_t                                    RasterBlockCache::misses = 0;
+uint64_t                                    RasterBlockCache::evictions = 0;
+
+/******************************************************************************
+ * PUBLIC METHODS
+ ******************************************************************************/
+
+/*----------------------------------------------------------------------------
+ * init
+ *----------------------------------------------------------------------------*/
+void RasterBlockCache::init (void)
+{
+}
+
+/*----------------------------------------------------------------------------
+ * deinit
+ *----------------------------------------------------------------------------*/
+void RasterBlockCache::deinit (void)
+{
+    cacheMut.lock();
+    {
+        blocks.clear();
+        newest = NULL;
+        oldest = NULL;
+        cacheBytes = 0;
+    }
+    cacheMut.unlock();
+}
+
+/*----------------------------------------------------------------------------
+ * getValue
+ *
+ *  returns true and the pixel value at offset if the block is cached
+ *----------------------------------------------------------------------------*/
+bool RasterBlockCache::getValue (const std::string& file, int band, int xblk, int yblk, int offset, double& value)
+{
+    bool status = false;
+    std::string key = makeKey(file, band, xblk, yblk);
+
+    cacheMut.lock();
+    {
+        block_t* block;
+        if(maxBytes <= 0)
+        {
+            /* Cache disabled, not a miss */
+        }
+        else if(blocks.find(key.c_str(), &block))
+        {
+            makeNewest(block);
+            status = blockValue(block->data, block->type, offset, value);
+            hits++;
+        }
+        else
+        {
+            misses++;
+        }
+    }
+    cacheMut.unlock();
+
+    return status;
+}
+
+/*----------------------------------------------------------------------------
+ * addBlock
+ *
+ *  copies a decoded block into the cache, evicting the least recently used
+ *  blocks needed to stay within the byte budget
+ *----------------------------------------------------------------------------*/
+void RasterBlockCache::addBlock (const std::string& file, int band, int xblk, int yblk, GDALDataType type, const void* data, long size)
+{
+    std::string key = makeKey(file, band, xblk, yblk);
+
+    cacheMut.lock();
+    {
+        if(size <= maxBytes && !blocks.find(key.c_str()))
+        {
+            evict(size);
+
+            block_t* block = new block_t;
+            block->key = key;
+            block->type = type;
+            block->size = size;
+            block->data = new uint8_t [size];
+            memcpy(block->data, data, size);
+            block->newer = NULL;
+            block->older = NULL;
+            makeNewest(block);
+
+            blocks.add(key.c_str(), block);
+            cacheBytes += size;
+        }
+    }
+    cacheMut.unlock();
+}
+
+/*----------------------------------------------------------------------------
+ * blockValue
+ *
+ *  returns false for data types that are not supported
+ *----------------------------------------------------------------------------*/
+bool RasterBlockCache::blockValue (const void* data, GDALDataType type, int offset, double& value)
+{
+    /* Be carefull using offset based on the pixel data type */
+    switch(type)
+    {
+        case GDT_Byte:      value = static_cast<const uint8_t*>(data)[offset];  break;
+        case GDT_UInt16:    value = static_cast<const uint16_t*>(data)[offset]; break;
+        case GDT_Int16:     value = static_cast<const int16_t*>(data)[offset];  break;
+        case GDT_UInt32:    value = static_cast<const uint32_t*>(data)[offset]; break;
+        case GDT_Int32:     value = static_cast<const int32_t*>(data)[offset];  break;
+        case GDT_Int64:     value = static_cast<const int64_t*>(data)[offset];  break;
+        case GDT_UInt64:    value = static_cast<const uint64_t*>(data)[offset]; break;
+        case GDT_Float32:   value = static_cast<const float*>(data)[offset];    break;
+        case GDT_Float64:   value = static_cast<const double*>(data)[offset];   break;
+        default:
+            /*
+             * Complex numbers are supported but not needed at this point.
+             */
+            return false;
+    }
+
+    return true;
+}
+
+/*----------------------------------------------------------------------------
+ * getStats
+ *----------------------------------------------------------------------------*/
+void RasterBlockCache::getStats (stats_t& stats)
+{
+    cacheMut.lock();
+    {
+        stats.hits = hits;
+        stats.misses = misses;
+        stats.evictions = evictions;
+        stats.blocks = blocks.length();
+        stats.bytes = cacheBytes;
+        stats.max_bytes = maxBytes;
+    }
+    cacheMut.unlock();
+}
+
+/*----------------------------------------------------------------------------
+ * luaStats - geo.rastercache([<max bytes>]) --> status, stats table
+ *
+ *  setting max bytes to zero disables the cache
+ *----------------------------------------------------------------------------*/
+int RasterBlockCache::luaStats (lua_State* L)
+{
+    bool status = false;
+    int num_ret = 1;
+
+    try
+    {
+        /* Set Byte Budget */
+        bool provided = false;
+        long max_bytes = LuaObject::getLuaInteger(L, 1, true, 0, &provided);
+        if(provided)
+        {
+            if(max_bytes < 0)
+            {
+                throw RunTimeException(CRITICAL, RTE_ERROR, "invalid block cache size: %ld", max_bytes);
+            }
+
+            cacheMut.lock();
+            {
+                maxBytes = max_bytes;
+                evict(0);
+            }
+            cacheMut.unlock();
+        }
+
+        /* Create Statistics Table */
+        stats_t stats;
+        getStats(stats);
+        lua_newtable(L);
+        LuaEngine::setAttrInt(L, "cache_hit",       stats.hits);
+        LuaEngine::setAttrInt(L, "cache_miss",      stats.misses);
+        LuaEngine::setAttrInt(L, "cache_evict",     stats.evictions);
+        LuaEngine::setAttrInt(L, "cache_blocks",    stats.blocks);
+        LuaEngine::setAttrInt(L, "cache_bytes",     stats.bytes);
+        LuaEngine::setAttrInt(L, "cache_max",       stats.max_bytes);
+        num_ret++;
+
+        /* Set Success */
+        status = true;
+    }
+    catch(const RunTimeException& e)
+    {
+        mlog(e.level(), "Error getting raster block cache statistics: %s", e.what());
+    }
+
+    /* Return Status */
+    return LuaObject::returnLuaStatus(L, status, num_ret);
+}
+
+/******************************************************************************
+ * PRIVATE METHODS
+ ******************************************************************************/
+
+/*----------------------------------------------------------------------------
+ * makeKey
+ *----------------------------------------------------------------------------*/
+std::string RasterBlockCache::makeKey (const std::string& file, int band, int xblk, int yblk)
+{
+    return file + ":" + std::to_string(band) + ":" + std::to_string(xblk) + ":" + std::to_string(yblk);
+}
+
+/*----------------------------------------------------------------------------
+ * unlink
+ *----------------------------------------------------------------------------*/
+void RasterBlockCache::unlink (block_t* block)
+{
+    if(block->newer)    block->newer->older = block->older;
+    else if(newest == block) newest = block->older;
+
+    if(block->older)    block->older->newer = block->newer;
+    else if(oldest == block) oldest = block->newer;
+
+    block->newer = NULL;
+    block->older = NULL;
+}
+
+/*----------------------------------------------------------------------------
+ * makeNewest
+ *----------------------------------------------------------------------------*/
+void RasterBlockCache::makeNewest (block_t* block)
+{
+    if(newest == block) return;
+
+    unlink(block);
+    block->older = newest;
+    if(newest)  newest->newer = block;
+    else        oldest = block;
+    newest = block;
+}
+
+/*----------------------------------------------------------------------------
+ * evict
+ *
+ *  removes least recently used blocks until bytes_needed more fit
+ *----------------------------------------------------------------------------*/
+void RasterBlockCache::evict (long bytes_needed)
+{
+    while(oldest && (cacheBytes + bytes_needed > maxBytes))
+    {
+        block_t* block = oldest;
+        std::string key = block->key;
+        unlink(block);
+        cacheBytes -= block->size;
+        evictions++;
+        blocks.remove(key.c_str()); // deletes block
+    }
+}
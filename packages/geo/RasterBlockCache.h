@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) 2021, University of Washington
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the University of Washington nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE UNIVERSITY OF WASHINGTON AND CONTRIBUTORS
+ * “AS IS” AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE UNIVERSITY OF WASHINGTON OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef __raster_block_cache__
+#define __raster_block_cache__
+
+/******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+
+#include "OsApi.h"
+#include "Dictionary.h"
+#include "LuaEngine.h"
+#include <gdal.h>
+#include <string>
+
+/******************************************************************************
+ * RASTER BLOCK CACHE CLASS
+ *
+ *  Process wide, byte budgeted, least recently used cache of decoded raster
+ *  blocks keyed by file, band, and block.  Unlike GDAL's block cache, cached
+ *  blocks outlive the dataset they were read from, so they are shared across
+ *  raster objects and requests.
+ ******************************************************************************/
+
+class RasterBlockCache
+{
+    public:
+
+        /*--------------------------------------------------------------------
+         * Constants
+         *--------------------------------------------------------------------*/
+
+        static const long DEFAULT_MAX_BYTES = 0x10000000; // 256MB
+
+        /*--------------------------------------------------------------------
+         * Typedefs
+         *--------------------------------------------------------------------*/
+
+        typedef struct {
+            uint64_t    hits;
+            uint64_t    misses;
+            uint64_t    evictions;
+            long        blocks;
+            long        bytes;
+            long        max_bytes;
+        } stats_t;
+
+        /*--------------------------------------------------------------------
+         * Methods
+         *--------------------------------------------------------------------*/
+
+        static void init        (void);
+        static void deinit      (void);
+        static bool getValue    (const std::string& file, int band, int xblk, int yblk, int offset, double& value);
+        static void addBlock    (const std::string& file, int band, int xblk, int yblk, GDALDataType type, const void* data, long size);
+        static bool blockValue  (const void* data, GDALDataType type, int offset, double& value);
+        static void getStats    (stats_t& stats);
+        static int  luaStats    (lua_State* L);
+
+    private:
+
+        /*--------------------------------------------------------------------
+         * Typedefs
+         *--------------------------------------------------------------------*/
+
+        typedef struct Block {
+            std::string     key;
+            GDALDataType    type;
+            long            size;
+            uint8_t*        data;
+            struct Block*   newer;
+            struct Block*   older;
+            ~Block(void) {delete [] data;}
+        } block_t;
+
+        /*--------------------------------------------------------------------
+         * Methods
+         *--------------------------------------------------------------------*/
+
+        static std::string  makeKey     (const std::string& file, int band, int xblk, int yblk);
+        static void         unlink      (block_t* block);
+        static void         makeNewest  (block_t* block);
+        static void         evict       (long bytes_needed);
+
+        /*--------------------------------------------------------------------
+         * Data
+         *--------------------------------------------------------------------*/
+
+        static Mutex                    cacheMut;
+        static Dictionary<block_t*>     blocks;
+        static block_t*                 newest;
+        static block_t*                 oldest;
+        static long                     cacheBytes;
+        static long                     maxBytes;
+        static uint64_t                 hits;
+        static uint64_t                 misses;
+        static uint64_t                 evictions;
+};
+
+#endif  /* __raster_block_cache__ */
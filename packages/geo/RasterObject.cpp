@@ -147,6 +147,26 @@ uint32_t RasterObject::getPixels(uint32_t ulx, uint32_t uly, uint32_t xsize, uin
     return 0;
 }
 
+/*----------------------------------------------------------------------------
+ * getBatchSamples
+ *
+ *  sllist[i] receives the samples of points[i]; rasters that can sample many
+ *  points more efficiently than one at a time override this
+ *----------------------------------------------------------------------------*/
+uint32_t RasterObject::getBatchSamples(const std::vector<point_info_t>& points, std::vector<std::vector<RasterSample*>>& sllist, void* param)
+{
+    uint32_t errors = SS_NO_ERRORS;
+
+    sllist.resize(points.size());
+    for(size_t i = 0; i < points.size(); i++)
+    {
+        OGRPoint poi(points[i].point);
+        errors |= getSamples(&poi, points[i].gps, sllist[i], param);
+    }
+
+    return errors;
+}
+
 /*----------------------------------------------------------------------------
  * Destructor
  *----------------------------------------------------------------------------*/
@@ -219,22 +239,15 @@ int RasterObject::luaSamples(lua_State *L)
         }
 
         /* Get samples */
-        bool listvalid = true;
         OGRPoint poi(lon, lat, height);
         err = lua_obj->getSamples(&poi, gps, slist, NULL);
 
-        if(err & SS_THREADS_LIMIT_ERROR)
-        {
-            listvalid = false;
-            mlog(CRITICAL, "Too many rasters to sample, max allowed: %d, limit your AOI/temporal range or use filters", GeoIndexedRaster::MAX_READER_THREADS);
-        }
-
         /* Create return table */
         lua_createtable(L, slist.size(), 0);
         num_ret++;
 
         /* Populate samples */
-        if(listvalid && !slist.empty())
+        if(!slist.empty())
         {
             for(uint32_t i = 0; i < slist.size(); i++)
             {
@@ -398,12 +411,6 @@ int RasterObject::slist2table(const std::vector<RasterSubset*>& slist, uint32_t
     int num_ret = 0;
 
     bool listvalid = true;
-    if(errors & SS_THREADS_LIMIT_ERROR)
-    {
-        listvalid = false;
-        mlog(CRITICAL, "Too many rasters to subset, max allowed: %d, limit your AOI/temporal range or use filters", GeoIndexedRaster::MAX_READER_THREADS);
-    }
-
     if(errors & SS_MEMPOOL_ERROR)
     {
         listvalid = false;
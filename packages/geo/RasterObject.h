@@ -69,6 +69,11 @@ class RasterObject: public LuaObject
             factory_f   create;
         } factory_t;
 
+        typedef struct {
+            OGRPoint    point;
+            int64_t     gps;
+        } point_info_t;
+
         /*--------------------------------------------------------------------
          * Methods
          *--------------------------------------------------------------------*/
@@ -78,6 +83,7 @@ class RasterObject: public LuaObject
         static int       luaCreate       (lua_State* L);
         static bool      registerRaster  (const char* _name, factory_f create);
         virtual uint32_t getSamples      (OGRGeometry* geo, int64_t gps, std::vector<RasterSample*>& slist, void* param=NULL) = 0;
+        virtual uint32_t getBatchSamples (const std::vector<point_info_t>& points, std::vector<std::vector<RasterSample*>>& sllist, void* param=NULL);
         virtual uint32_t getSubsets      (OGRGeometry* geo, int64_t gps, std::vector<RasterSubset*>& slist, void* param=NULL) = 0;
         virtual uint32_t getPixels       (uint32_t ulx, uint32_t uly, uint32_t xsize, uint32_t ysize, std::vector<RasterSubset*>& slist, void* param=NULL);
         virtual         ~RasterObject    (void);
@@ -272,59 +272,49 @@ bool RasterSampler::processRecord (RecordObject* record, okey_t key, recVec_t* r
         }
     }
 
-    /* Initialize Local Fields */
-    RecordObject::field_t index_field = indexField;
-    RecordObject::field_t lon_field = lonField;
-    RecordObject::field_t lat_field = latField;
-    RecordObject::field_t time_field = timeField;
-    RecordObject::field_t height_field = heightField;
+    /* Get Columns */
+    std::vector<uint64_t> index_values(num_batches);
+    std::vector<double> lon_values(num_batches);
+    std::vector<double> lat_values(num_batches);
+    std::vector<int64_t> time_values(num_batches, 0);
+    std::vector<double> height_values(num_batches, 0.0);
+    record->getValueColumn(indexField, batchRecordSizeBytes, num_batches, index_values.data());
+    record->getValueColumn(lonField, batchRecordSizeBytes, num_batches, lon_values.data());
+    record->getValueColumn(latField, batchRecordSizeBytes, num_batches, lat_values.data());
+    if(timeField.type != RecordObject::INVALID_FIELD)
+    {
+        record->getValueColumn(timeField, batchRecordSizeBytes, num_batches, time_values.data());
+    }
+    if(heightField.type != RecordObject::INVALID_FIELD)
+    {
+        record->getValueColumn(heightField, batchRecordSizeBytes, num_batches, height_values.data());
+    }
 
-    /* Loop Through Each Record in Batch */
+    /* Build Points of Batch */
+    std::vector<RasterObject::point_info_t> points(num_batches);
     for(int batch = 0; batch < num_batches; batch++)
     {
-        /* Get Index (e.g. Extent Id) */
-        uint64_t index = (uint64_t)record->getValueInteger(index_field);
-        index_field.offset += (batchRecordSizeBytes * 8);
-
-        /* Get Longitude */
-        double lon_val = record->getValueReal(lon_field);
-        lon_field.offset += (batchRecordSizeBytes * 8);
-
-        /* Get Latitude */
-        double lat_val = record->getValueReal(lat_field);
-        lat_field.offset += (batchRecordSizeBytes * 8);
-
-        /* Get Time */
-        long gps = 0;
-        if(time_field.type != RecordObject::INVALID_FIELD)
+        points[batch].point.setX(lon_values[batch]);
+        points[batch].point.setY(lat_values[batch]);
+        points[batch].point.setZ(height_values[batch]);
+        points[batch].gps = 0;
+        if(timeField.type != RecordObject::INVALID_FIELD)
         {
-            long time_val = record->getValueInteger(time_field);
-            time_field.offset += (batchRecordSizeBytes * 8);
-            gps = TimeLib::sysex2gpstime(time_val);
+            points[batch].gps = TimeLib::sysex2gpstime(time_values[batch]);
         }
+    }
 
-        /* Get Height */
-        double height_val = 0.0;
-        if(height_field.type != RecordObject::INVALID_FIELD)
-        {
-            height_val = record->getValueReal(height_field);
-            height_field.offset += (batchRecordSizeBytes * 8);
-        }
+    /* Sample Raster at All Points */
+    std::vector<std::vector<RasterSample*>> sllist;
+    raster->getBatchSamples(points, sllist);
 
-        /* Sample Raster */
-        std::vector<RasterSample*> slist;
-        OGRPoint poi(lon_val, lat_val, height_val);
-        uint32_t err = raster->getSamples(&poi, gps, slist);
+    /* Loop Through Each Record in Batch */
+    for(int batch = 0; batch < num_batches; batch++)
+    {
+        uint64_t index = index_values[batch];
+        std::vector<RasterSample*>& slist = sllist[batch];
         int num_samples = slist.size();
 
-        /* Generate Error Messages */
-        if(err & SS_THREADS_LIMIT_ERROR)
-        {
-            LuaEndpoint::generateExceptionStatus(RTE_ERROR, CRITICAL, outQ, NULL,
-                                                "Too many rasters to sample %s at %.3lf,%.3lf,%3lf: max allowed: %d, limit your AOI/temporal range or use filters",
-                                                rasterKey, lon_val, lat_val, height_val, GeoIndexedRaster::MAX_READER_THREADS);
-        }
-
         if(raster->hasZonalStats())
         {
             /* Create and Post Sample Record */
@@ -37,6 +37,7 @@
 #include "GeoJsonRaster.h"
 #include "GeoUserRaster.h"
 #include "RasterSampler.h"
+#include "RasterBlockCache.h"
 #include "geo.h"
 
 #include <gdal.h>
@@ -49,6 +50,10 @@
 
 #define LUA_GEO_LIBNAME  "geo"
 
+#ifndef GEO_READER_POOL_SIZE
+#define GEO_READER_POOL_SIZE 64
+#endif
+
 /******************************************************************************
  * GEO FUNCTIONS
  ******************************************************************************/
@@ -246,6 +251,7 @@ int geo_open (lua_State* L)
         {"raster",      RasterObject::luaCreate},
         {"sampler",     RasterSampler::luaCreate},
         {"parms",       GeoParms::luaCreate},
+        {"rastercache", RasterBlockCache::luaStats},
         {NULL,          NULL}
     };
 
@@ -292,7 +298,9 @@ void initgeo (void)
 
     /* Initialize Modules */
     GeoIndexedRaster::init();
+    GeoIndexedRaster::initReaders(GEO_READER_POOL_SIZE);
     RasterSampler::init();
+    RasterBlockCache::init();
 
     /* Register GDAL custom error handler */
     void (*fptrGdalErrorHandler)(CPLErr, int, const char *) = GdalErrHandler;
@@ -310,8 +318,10 @@ void initgeo (void)
 
 void deinitgeo (void)
 {
+    GeoIndexedRaster::deinitReaders();
     GeoIndexedRaster::deinit();
     RasterSampler::deinit();
+    RasterBlockCache::deinit();
     GDALDestroy();
 }
 }
@@ -38,6 +38,27 @@
 
 #include <zlib.h>
 
+#ifdef H5CORO_LIBDEFLATE
+#include <libdeflate.h>
+#endif
+
+#ifdef H5CORO_ZSTD
+#include <zstd.h>
+#endif
+
+#ifdef H5CORO_LZ4
+#include <lz4.h>
+#endif
+
+#ifdef H5CORO_BLOSC
+#include <blosc.h>
+#endif
+
+#if defined(__x86_64__) || defined(__i386__)
+#define H5_SIMD_SHUFFLE
+#include <immintrin.h>
+#endif
+
 /******************************************************************************
  * DEFINES
  ******************************************************************************/
@@ -60,6 +81,222 @@
 
 #define H5_INVALID(var)  (var == (0xFFFFFFFFFFFFFFFFllu >> (64 - (sizeof(var) * 8))))
 
+/******************************************************************************
+ * LOCAL DATA
+ ******************************************************************************/
+
+#ifdef H5CORO_LIBDEFLATE
+
+/* one decompressor per thread, allocated on first use and freed on thread exit */
+struct libdeflate_owner_t
+{
+    struct libdeflate_decompressor* decompressor;
+    libdeflate_owner_t(void): decompressor(NULL) {}
+    ~libdeflate_owner_t(void) { if(decompressor) libdeflate_free_decompressor(decompressor); }
+};
+
+static thread_local libdeflate_owner_t libdeflate_owner;
+
+#endif
+
+/******************************************************************************
+ * LOCAL FUNCTIONS
+ ******************************************************************************/
+
+#ifdef H5_SIMD_SHUFFLE
+
+/*----------------------------------------------------------------------------
+ * unshuffleSSE2
+ *
+ *  de-interleaves 16 elements per iteration from the byte planes of the
+ *  shuffled input; returns the number of elements written to the output
+ *----------------------------------------------------------------------------*/
+static int64_t unshuffleSSE2 (const uint8_t* input, int64_t plane_size, uint8_t* output, int64_t start_element, int64_t num_elements, int type_size)
+{
+    const int64_t step = 16;
+    int64_t e = 0;
+
+    if(type_size == 2)
+    {
+        const uint8_t* p0 = &input[start_element];
+        const uint8_t* p1 = p0 + plane_size;
+        for(; e + step <= num_elements; e += step)
+        {
+            __m128i a = _mm_loadu_si128((const __m128i*)&p0[e]);
+            __m128i b = _mm_loadu_si128((const __m128i*)&p1[e]);
+            __m128i* dst = (__m128i*)&output[e * 2];
+            _mm_storeu_si128(&dst[0], _mm_unpacklo_epi8(a, b));
+            _mm_storeu_si128(&dst[1], _mm_unpackhi_epi8(a, b));
+        }
+    }
+    else if(type_size == 4)
+    {
+        const uint8_t* p0 = &input[start_element];
+        for(; e + step <= num_elements; e += step)
+        {
+            __m128i b0 = _mm_loadu_si128((const __m128i*)&p0[e]);
+            __m128i b1 = _mm_loadu_si128((const __m128i*)&p0[e + plane_size]);
+            __m128i b2 = _mm_loadu_si128((const __m128i*)&p0[e + (2 * plane_size)]);
+            __m128i b3 = _mm_loadu_si128((const __m128i*)&p0[e + (3 * plane_size)]);
+            __m128i l01 = _mm_unpacklo_epi8(b0, b1);
+            __m128i h01 = _mm_unpackhi_epi8(b0, b1);
+            __m128i l23 = _mm_unpacklo_epi8(b2, b3);
+            __m128i h23 = _mm_unpackhi_epi8(b2, b3);
+            __m128i* dst = (__m128i*)&output[e * 4];
+            _mm_storeu_si128(&dst[0], _mm_unpacklo_epi16(l01, l23));
+            _mm_storeu_si128(&dst[1], _mm_unpackhi_epi16(l01, l23));
+            _mm_storeu_si128(&dst[2], _mm_unpacklo_epi16(h01, h23));
+            _mm_storeu_si128(&dst[3], _mm_unpackhi_epi16(h01, h23));
+        }
+    }
+    else if(type_size == 8)
+    {
+        const uint8_t* p0 = &input[start_element];
+        for(; e + step <= num_elements; e += step)
+        {
+            __m128i b[8];
+            for(int k = 0; k < 8; k++)
+            {
+                b[k] = _mm_loadu_si128((const __m128i*)&p0[e + (k * plane_size)]);
+            }
+
+            /* bytes 0-3 and bytes 4-7 of each element */
+            __m128i l01 = _mm_unpacklo_epi8(b[0], b[1]);
+            __m128i h01 = _mm_unpackhi_epi8(b[0], b[1]);
+            __m128i l23 = _mm_unpacklo_epi8(b[2], b[3]);
+            __m128i h23 = _mm_unpackhi_epi8(b[2], b[3]);
+            __m128i l45 = _mm_unpacklo_epi8(b[4], b[5]);
+            __m128i h45 = _mm_unpackhi_epi8(b[4], b[5]);
+            __m128i l67 = _mm_unpacklo_epi8(b[6], b[7]);
+            __m128i h67 = _mm_unpackhi_epi8(b[6], b[7]);
+            __m128i a0 = _mm_unpacklo_epi16(l01, l23);
+            __m128i a1 = _mm_unpackhi_epi16(l01, l23);
+            __m128i a2 = _mm_unpacklo_epi16(h01, h23);
+            __m128i a3 = _mm_unpackhi_epi16(h01, h23);
+            __m128i c0 = _mm_unpacklo_epi16(l45, l67);
+            __m128i c1 = _mm_unpackhi_epi16(l45, l67);
+            __m128i c2 = _mm_unpacklo_epi16(h45, h67);
+            __m128i c3 = _mm_unpackhi_epi16(h45, h67);
+
+            __m128i* dst = (__m128i*)&output[e * 8];
+            _mm_storeu_si128(&dst[0], _mm_unpacklo_epi32(a0, c0));
+            _mm_storeu_si128(&dst[1], _mm_unpackhi_epi32(a0, c0));
+            _mm_storeu_si128(&dst[2], _mm_unpacklo_epi32(a1, c1));
+            _mm_storeu_si128(&dst[3], _mm_unpackhi_epi32(a1, c1));
+            _mm_storeu_si128(&dst[4], _mm_unpacklo_epi32(a2, c2));
+            _mm_storeu_si128(&dst[5], _mm_unpackhi_epi32(a2, c2));
+            _mm_storeu_si128(&dst[6], _mm_unpacklo_epi32(a3, c3));
+            _mm_storeu_si128(&dst[7], _mm_unpackhi_epi32(a3, c3));
+        }
+    }
+
+    return e;
+}
+
+/*----------------------------------------------------------------------------
+ * unshuffleAVX2
+ *
+ *  same as unshuffleSSE2 but 32 elements per iteration; the unpack
+ *  instructions operate within 128-bit lanes, so the lower halves of the
+ *  results hold the first 16 elements and the upper halves the next 16,
+ *  which are recombined with lane permutes when stored
+ *----------------------------------------------------------------------------*/
+__attribute__((target("avx2")))
+static int64_t unshuffleAVX2 (const uint8_t* input, int64_t plane_size, uint8_t* output, int64_t start_element, int64_t num_elements, int type_size)
+{
+    const int64_t step = 32;
+    int64_t e = 0;
+
+    if(type_size == 2)
+    {
+        const uint8_t* p0 = &input[start_element];
+        const uint8_t* p1 = p0 + plane_size;
+        for(; e + step <= num_elements; e += step)
+        {
+            __m256i a = _mm256_loadu_si256((const __m256i*)&p0[e]);
+            __m256i b = _mm256_loadu_si256((const __m256i*)&p1[e]);
+            __m256i lo = _mm256_unpacklo_epi8(a, b);
+            __m256i hi = _mm256_unpackhi_epi8(a, b);
+            __m256i* dst = (__m256i*)&output[e * 2];
+            _mm256_storeu_si256(&dst[0], _mm256_permute2x128_si256(lo, hi, 0x20));
+            _mm256_storeu_si256(&dst[1], _mm256_permute2x128_si256(lo, hi, 0x31));
+        }
+    }
+    else if(type_size == 4)
+    {
+        const uint8_t* p0 = &input[start_element];
+        for(; e + step <= num_elements; e += step)
+        {
+            __m256i b0 = _mm256_loadu_si256((const __m256i*)&p0[e]);
+            __m256i b1 = _mm256_loadu_si256((const __m256i*)&p0[e + plane_size]);
+            __m256i b2 = _mm256_loadu_si256((const __m256i*)&p0[e + (2 * plane_size)]);
+            __m256i b3 = _mm256_loadu_si256((const __m256i*)&p0[e + (3 * plane_size)]);
+            __m256i l01 = _mm256_unpacklo_epi8(b0, b1);
+            __m256i h01 = _mm256_unpackhi_epi8(b0, b1);
+            __m256i l23 = _mm256_unpacklo_epi8(b2, b3);
+            __m256i h23 = _mm256_unpackhi_epi8(b2, b3);
+            __m256i r0 = _mm256_unpacklo_epi16(l01, l23);
+            __m256i r1 = _mm256_unpackhi_epi16(l01, l23);
+            __m256i r2 = _mm256_unpacklo_epi16(h01, h23);
+            __m256i r3 = _mm256_unpackhi_epi16(h01, h23);
+            __m256i* dst = (__m256i*)&output[e * 4];
+            _mm256_storeu_si256(&dst[0], _mm256_permute2x128_si256(r0, r1, 0x20));
+            _mm256_storeu_si256(&dst[1], _mm256_permute2x128_si256(r2, r3, 0x20));
+            _mm256_storeu_si256(&dst[2], _mm256_permute2x128_si256(r0, r1, 0x31));
+            _mm256_storeu_si256(&dst[3], _mm256_permute2x128_si256(r2, r3, 0x31));
+        }
+    }
+    else if(type_size == 8)
+    {
+        const uint8_t* p0 = &input[start_element];
+        for(; e + step <= num_elements; e += step)
+        {
+            __m256i b[8];
+            for(int k = 0; k < 8; k++)
+            {
+                b[k] = _mm256_loadu_si256((const __m256i*)&p0[e + (k * plane_size)]);
+            }
+
+            __m256i l01 = _mm256_unpacklo_epi8(b[0], b[1]);
+            __m256i h01 = _mm256_unpackhi_epi8(b[0], b[1]);
+            __m256i l23 = _mm256_unpacklo_epi8(b[2], b[3]);
+            __m256i h23 = _mm256_unpackhi_epi8(b[2], b[3]);
+            __m256i l45 = _mm256_unpacklo_epi8(b[4], b[5]);
+            __m256i h45 = _mm256_unpackhi_epi8(b[4], b[5]);
+            __m256i l67 = _mm256_unpacklo_epi8(b[6], b[7]);
+            __m256i h67 = _mm256_unpackhi_epi8(b[6], b[7]);
+            __m256i a0 = _mm256_unpacklo_epi16(l01, l23);
+            __m256i a1 = _mm256_unpackhi_epi16(l01, l23);
+            __m256i a2 = _mm256_unpacklo_epi16(h01, h23);
+            __m256i a3 = _mm256_unpackhi_epi16(h01, h23);
+            __m256i c0 = _mm256_unpacklo_epi16(l45, l67);
+            __m256i c1 = _mm256_unpackhi_epi16(l45, l67);
+            __m256i c2 = _mm256_unpacklo_epi16(h45, h67);
+            __m256i c3 = _mm256_unpackhi_epi16(h45, h67);
+            __m256i r[8];
+            r[0] = _mm256_unpacklo_epi32(a0, c0);
+            r[1] = _mm256_unpackhi_epi32(a0, c0);
+            r[2] = _mm256_unpacklo_epi32(a1, c1);
+            r[3] = _mm256_unpackhi_epi32(a1, c1);
+            r[4] = _mm256_unpacklo_epi32(a2, c2);
+            r[5] = _mm256_unpackhi_epi32(a2, c2);
+            r[6] = _mm256_unpacklo_epi32(a3, c3);
+            r[7] = _mm256_unpackhi_epi32(a3, c3);
+
+            __m256i* dst = (__m256i*)&output[e * 8];
+            for(int k = 0; k < 4; k++)
+            {
+                _mm256_storeu_si256(&dst[k],        _mm256_permute2x128_si256(r[k * 2], r[(k * 2) + 1], 0x20));
+                _mm256_storeu_si256(&dst[k + 4],    _mm256_permute2x128_si256(r[k * 2], r[(k * 2) + 1], 0x31));
+            }
+        }
+    }
+
+    return e;
+}
+
+#endif /* H5_SIMD_SHUFFLE */
+
 /******************************************************************************
  * H5 FUTURE CLASS
  ******************************************************************************/
@@ -134,22 +371,73 @@ H5Future::rc_t H5Future::wait (int timeout)
 /*----------------------------------------------------------------------------
  * Static Data
  *----------------------------------------------------------------------------*/
+H5FileBuffer::shuffle_impl_t H5FileBuffer::shuffleImpl = H5FileBuffer::detectShuffleImpl();
+H5FileBuffer::filter_registry_t H5FileBuffer::filterRegistry(MAX_FILTER_REGISTRY);
+Mutex H5FileBuffer::filterMutex;
 H5FileBuffer::meta_repo_t H5FileBuffer::metaRepo(MAX_META_STORE);
 Mutex H5FileBuffer::metaMutex;
+H5FileBuffer::chunk_repo_t H5FileBuffer::chunkIndexRepo(MAX_CHUNK_INDEX_STORE);
+int64_t H5FileBuffer::chunkIndexBytes = 0;
+Mutex H5FileBuffer::chunkIndexMutex;
+H5FileBuffer::chunk_pipeline_t* H5FileBuffer::chunkPipelineQ = NULL;
+Cond H5FileBuffer::chunkPipelineCond;
+bool H5FileBuffer::chunkPipelineActive = false;
+Thread** H5FileBuffer::chunkWorkerPids = NULL;
+int H5FileBuffer::chunkWorkerCount = 0;
 
 /*----------------------------------------------------------------------------
  * Constructor
  *----------------------------------------------------------------------------*/
-H5FileBuffer::io_context_t::io_context_t (void):
-    l1(IO_CACHE_L1_ENTRIES, ioHashL1),
-    l2(IO_CACHE_L2_ENTRIES, ioHashL2)
+H5FileBuffer::io_shard_t::io_shard_t (long entries, int64_t _capacity, cache_t::hash_func_t hash):
+    cache(entries, hash)
 {
+    capacity = _capacity;
+    bytes = 0;
+}
+
+/*----------------------------------------------------------------------------
+ * Destructor
+ *----------------------------------------------------------------------------*/
+H5FileBuffer::io_shard_t::~io_shard_t (void)
+{
+    cache_entry_t entry;
+    uint64_t key = cache.first(&entry);
+    while(key != INVALID_KEY)
+    {
+        assert(entry.data);
+        delete [] entry.data;
+        key = cache.next(&entry);
+    }
+}
+
+/*----------------------------------------------------------------------------
+ * Constructor
+ *
+ *  the level 1 capacity is divided evenly between the shards, each of which
+ *  is sized to hold at least IO_CACHE_L1_ENTRIES lines; an odd number of
+ *  entries keeps the line addresses of a shard spread across its table
+ *----------------------------------------------------------------------------*/
+H5FileBuffer::io_context_t::io_context_t (int64_t l1_capacity, int64_t l2_capacity):
+    l2(IO_CACHE_L2_ENTRIES, l2_capacity, ioHashL2)
+{
+    int64_t shard_capacity = l1_capacity / H5CORO_IO_CACHE_SHARDS;
+    long shard_entries = MAX(IO_CACHE_L1_ENTRIES, (shard_capacity / IO_CACHE_L1_LINESIZE) * 2) | 1;
+    for(int i = 0; i < H5CORO_IO_CACHE_SHARDS; i++)
+    {
+        l1[i] = new io_shard_t(shard_entries, shard_capacity, ioHashL1);
+    }
+
     pre_prefetch_request = 0;
     post_prefetch_request = 0;
+    cache_hit = 0;
     cache_miss = 0;
     l1_cache_replace = 0;
     l2_cache_replace = 0;
     bytes_read = 0;
+    pipeline_chunks = 0;
+    pipeline_peak = 0;
+    chunk_index_hit = 0;
+    chunk_index_miss = 0;
 }
 
 /*----------------------------------------------------------------------------
@@ -157,29 +445,106 @@ H5FileBuffer::io_context_t::io_context_t (void):
  *----------------------------------------------------------------------------*/
 H5FileBuffer::io_context_t::~io_context_t (void)
 {
-    /* Empty L1 Cache */
+    for(int i = 0; i < H5CORO_IO_CACHE_SHARDS; i++)
     {
-        cache_entry_t entry;
-        uint64_t key = l1.first(&entry);
-        while(key != INVALID_KEY)
+        delete l1[i];
+    }
+
+    for(int i = 0; i < drivers.length(); i++)
+    {
+        delete drivers[i].driver;
+        delete [] drivers[i].resource;
+    }
+}
+
+/*----------------------------------------------------------------------------
+ * cached
+ *----------------------------------------------------------------------------*/
+int64_t H5FileBuffer::io_context_t::cached (void)
+{
+    int64_t total = 0;
+
+    for(int i = 0; i < H5CORO_IO_CACHE_SHARDS; i++)
+    {
+        l1[i]->mut.lock();
         {
-            assert(entry.data);
-            delete [] entry.data;
-            key = l1.next(&entry);
+            total += l1[i]->bytes;
         }
+        l1[i]->mut.unlock();
     }
 
-    /* Empty L2 Cache */
+    l2.mut.lock();
     {
-        cache_entry_t entry;
-        uint64_t key = l2.first(&entry);
-        while(key != INVALID_KEY)
+        total += l2.bytes;
+    }
+    l2.mut.unlock();
+
+    return total;
+}
+
+/*----------------------------------------------------------------------------
+ * acquireDriver
+ *
+ *  i/o drivers are not thread safe, so each pipelined chunk read takes an idle
+ *  driver out of the pool (or opens a new one) and returns it when done
+ *----------------------------------------------------------------------------*/
+Asset::IODriver* H5FileBuffer::io_context_t::acquireDriver (const Asset* asset, const char* resource)
+{
+    Asset::IODriver* driver = NULL;
+
+    drivers_mut.lock();
+    {
+        for(int i = 0; i < drivers.length(); i++)
         {
-            assert(entry.data);
-            delete [] entry.data;
-            key = l2.next(&entry);
+            const driver_entry_t& entry = drivers[i];
+            if(entry.asset == asset && StringLib::match(entry.resource, resource))
+            {
+                driver = entry.driver;
+                delete [] entry.resource;
+                drivers.remove(i);
+                break;
+            }
         }
     }
+    drivers_mut.unlock();
+
+    if(!driver)
+    {
+        driver = asset->createDriver(resource);
+        if(!driver) throw RunTimeException(CRITICAL, RTE_ERROR, "failed to create driver for %s", resource);
+    }
+
+    return driver;
+}
+
+/*----------------------------------------------------------------------------
+ * releaseDriver
+ *
+ *  the pool holds at most one idle driver per chunk worker; the oldest idle
+ *  driver is closed to make room
+ *----------------------------------------------------------------------------*/
+void H5FileBuffer::io_context_t::releaseDriver (const Asset* asset, const char* resource, Asset::IODriver* driver)
+{
+    driver_entry_t entry = {
+        .asset = asset,
+        .resource = StringLib::duplicate(resource),
+        .driver = driver
+    };
+
+    driver_entry_t oldest = {NULL, NULL, NULL};
+    drivers_mut.lock();
+    {
+        if(drivers.length() >= H5CORO_CHUNK_PIPELINE_WORKERS)
+        {
+            oldest = drivers[0];
+            drivers.remove(0);
+        }
+        drivers.add(entry);
+    }
+    drivers_mut.unlock();
+
+    delete oldest.driver;
+    delete [] oldest.resource;
 }
 
 /*----------------------------------------------------------------------------
@@ -192,6 +557,8 @@ H5FileBuffer::H5FileBuffer (info_t* info, io_context_t* context, const Asset* as
     assert(dataset);
 
     /* Initialize Class Data */
+    ioAsset                 = asset;
+    ioResource              = StringLib::duplicate(resource);
     ioDriver                = NULL;
     ioContextLocal          = true;
     ioContext               = NULL;
@@ -208,6 +575,8 @@ H5FileBuffer::H5FileBuffer (info_t* info, io_context_t* context, const Asset* as
     dataChunkBufferSize     = 0;
     highestDataLevel        = 0;
     dataSizeHint            = 0;
+    dataChunkList           = NULL;
+    dataChunkIndex          = NULL;
 
     /* Initialize Info */
     info->elements = 0;
@@ -222,6 +591,7 @@ H5FileBuffer::H5FileBuffer (info_t* info, io_context_t* context, const Asset* as
     {
         /* Initialize Driver */
         ioDriver = asset->createDriver(resource);
+        ioDriver->ioAdvise(0, 0, Asset::IODriver::IO_ACCESS_RANDOM); // metadata is read out of order
 
         /* Set or Create I/O Context */
         if(context)
@@ -269,6 +639,8 @@ H5FileBuffer::H5FileBuffer (info_t* info, io_context_t* context, const Asset* as
             {
                 metaData.filter[f]  = INVALID_FILTER;
             }
+            metaData.compression    = INVALID_FILTER;
+            metaData.decompress     = NULL;
 
             /* Get Dataset Path */
             parseDataset();
@@ -337,52 +709,71 @@ void H5FileBuffer::tearDown (void)
     /* Delete Dataset Strings */
     delete [] datasetName;
     delete [] datasetPrint;
+    delete [] ioResource;
 
     /* Delete Chunk Buffer */
     delete [] dataChunkBuffer;
     delete [] dataChunkFilterBuffer;
+    delete dataChunkList;
 }
 
 /*----------------------------------------------------------------------------
  * ioRequest
  *----------------------------------------------------------------------------*/
-void H5FileBuffer::ioRequest (uint64_t* pos, int64_t size, uint8_t* buffer, int64_t hint, bool cache_the_data)
+void H5FileBuffer::ioRequest (uint64_t* pos, int64_t size, uint8_t* buffer, int64_t hint, bool cache_the_data, Asset::IODriver* driver)
 {
+    if(!driver) driver = ioDriver;
+
     cache_entry_t entry;
-    int64_t data_offset = 0;
     uint64_t file_position = *pos;
     bool cached = false;
-    ioContext->mut.lock();
-    {
-        /* Count I/O Request */
-        if(ioPostPrefetch) ioContext->post_prefetch_request++;
-        else ioContext->pre_prefetch_request++;
 
-        /* Attempt to fulfill data request from I/O cache
-        *  note that this is only checked if a buffer is supplied;
-        *  otherwise the purpose of the call is to cache the entry */
+    /* Count I/O Request */
+    if(ioPostPrefetch) ioContext->post_prefetch_request++;
+    else ioContext->pre_prefetch_request++;
+
+    /* Access Data in Place
+    *  drivers that map the resource into memory bypass the I/O cache
+    *  since a cached copy would only duplicate the mapped pages; a
+    *  request made only to cache data becomes a hint to the driver */
+    const uint8_t* mapped = driver->ioMap(size, file_position);
+    if(mapped)
+    {
         if(buffer)
         {
-            if( ioCheckCache(file_position, size, &ioContext->l1, IO_CACHE_L1_MASK, &entry) ||
-                ioCheckCache(file_position, size, &ioContext->l2, IO_CACHE_L2_MASK, &entry) )
-            {
-                /* Entry Found in Cache */
-                cached = true;
+            memcpy(buffer, mapped, size);
+            ioContext->bytes_read += size;
+        }
+        else
+        {
+            driver->ioAdvise(MAX(size, hint), file_position, Asset::IODriver::IO_ACCESS_WILLNEED);
+        }
+        *pos += size;
+        return;
+    }
 
-                /* Set Offset to Start of Requested Data */
-                data_offset = file_position - entry.pos;
+    /* Attempt to fulfill data request from I/O cache
+    *  note that this is only checked if a buffer is supplied;
+    *  otherwise the purpose of the call is to cache the entry;
+    *  entries that start in the previous cache line can also
+    *  hold the requested data, and for the level 1 cache the
+    *  previous line lives in a different shard */
+    if(buffer)
+    {
+        uint64_t prev_l1_pos = (file_position & ~IO_CACHE_L1_MASK) - 1;
+        uint64_t prev_l2_pos = (file_position & ~IO_CACHE_L2_MASK) - 1;
+        bool check_prev_l1 = file_position > prev_l1_pos; // checks for rollover
+        bool check_prev_l2 = file_position > prev_l2_pos; // checks for rollover
 
-                /* Copy Data into Buffer */
-                memcpy(buffer, &entry.data[data_offset], size);
-            }
-            else
-            {
-                /* Count Cache Miss */
-                ioContext->cache_miss++;
-            }
-        }
+        cached = ioCheckCache(file_position, file_position, size, buffer, ioContext->l1[ioShardL1(file_position)]) ||
+                 (check_prev_l1 && ioCheckCache(prev_l1_pos, file_position, size, buffer, ioContext->l1[ioShardL1(prev_l1_pos)])) ||
+                 ioCheckCache(file_position, file_position, size, buffer, &ioContext->l2) ||
+                 (check_prev_l2 && ioCheckCache(prev_l2_pos, file_position, size, buffer, &ioContext->l2));
+
+        /* Count Cache Hit or Miss */
+        if(cached) ioContext->cache_hit++;
+        else ioContext->cache_miss++;
     }
-    ioContext->mut.unlock();
 
     /* Read data to fulfill request */
     if(!cached)
@@ -407,7 +798,7 @@ void H5FileBuffer::ioRequest (uint64_t* pos, int64_t size, uint8_t* buffer, int6
         /* Read into Cache */
         try
         {
-            entry.size = ioDriver->ioRead(entry.data, read_size, entry.pos);
+            entry.size = driver->ioRead(entry.data, read_size, entry.pos);
         }
         catch (const RunTimeException& e)
         {
@@ -430,76 +821,26 @@ void H5FileBuffer::ioRequest (uint64_t* pos, int64_t size, uint8_t* buffer, int6
             *  or the purpose was only to cache the entry (prefetch) */
             if(buffer)
             {
-                memcpy(buffer, &entry.data[data_offset], size);
+                memcpy(buffer, entry.data, size);
             }
 
-            /* Select Cache */
-            cache_t* cache = NULL;
-            long* cache_replace = NULL;
+            /* Count Bytes Read */
+            ioContext->bytes_read += entry.size;
+
+            /* Cache Entry */
             if(entry.size <= IO_CACHE_L1_LINESIZE)
             {
-                cache = &ioContext->l1;
-                cache_replace = &ioContext->l1_cache_replace;
+                ioCacheEntry(entry, ioContext->l1[ioShardL1(file_position)], &ioContext->l1_cache_replace);
             }
             else
             {
-                cache = &ioContext->l2;
-                cache_replace = &ioContext->l2_cache_replace;
-            }
-
-            /* Cache Entry */
-            ioContext->mut.lock();
-            {
-                /* Ensure Room in Cache */
-                if(cache->isfull())
-                {
-                    /* Replace Oldest Entry */
-                    cache_entry_t oldest_entry;
-                    uint64_t oldest_pos = cache->first(&oldest_entry);
-                    if(oldest_pos != (uint64_t)INVALID_KEY)
-                    {
-                        delete [] oldest_entry.data;
-                        cache->remove(oldest_pos);
-                    }
-                    else
-                    {
-                        ioContext->mut.unlock();
-                        throw RunTimeException(CRITICAL, RTE_ERROR, "failed to make room in cache for %s", datasetPrint);
-                    }
-
-                    /* Count Cache Replacement */
-                    (*cache_replace)++;
-                }
-
-                /* Add Cache Entry */
-                if(!cache->add(file_position, entry, true))
-                {
-                    /* Free Previously Allocated Entry
-                     *  should only fail to add if the cache line was
-                     *  already added, in which case it is safe to just
-                     *  delete what was allocated and move on */
-                    delete [] entry.data;
-                }
-
-                /* Count Bytes Read */
-                ioContext->bytes_read += entry.size;
+                ioCacheEntry(entry, &ioContext->l2, &ioContext->l2_cache_replace);
             }
-            ioContext->mut.unlock();
         }
         else // data not being cached
         {
-            /* Count Bytes Read
-             *  the logic below is repeated to avoid locking the ioContext mutex
-             *  any more than it needs to be locked; the bytes_read could be updated
-             *  in a single place below, but then the ioRequest function would always
-             *  incur an additional mutex lock, whereas here it only occurs an aditional
-             *  time when data isn't being cached (which is rare)
-             */
-            ioContext->mut.lock();
-            {
-                ioContext->bytes_read += entry.size;
-            }
-            ioContext->mut.unlock();
+            /* Count Bytes Read */
+            ioContext->bytes_read += entry.size;
         }
     }
 
@@ -509,22 +850,85 @@ void H5FileBuffer::ioRequest (uint64_t* pos, int64_t size, uint8_t* buffer, int6
 
 /*----------------------------------------------------------------------------
  * ioCheckCache
+ *
+ *  looks up the entry starting nearest under the key in the shard and, if it
+ *  holds all of the requested data, copies the data into the buffer while the
+ *  shard is still locked (so the entry cannot be evicted during the copy)
  *----------------------------------------------------------------------------*/
-bool H5FileBuffer::ioCheckCache (uint64_t pos, int64_t size, cache_t* cache, uint64_t line_mask, cache_entry_t* entry)
+bool H5FileBuffer::ioCheckCache (uint64_t key, uint64_t pos, int64_t size, uint8_t* buffer, io_shard_t* shard)
 {
-    uint64_t prev_line_pos = (pos & ~line_mask) - 1;
-    bool check_prev = pos > prev_line_pos; // checks for rollover
+    bool found = false;
 
-    if( cache->find(pos, cache_t::MATCH_NEAREST_UNDER, entry, true) ||
-        (check_prev && cache->find(prev_line_pos, cache_t::MATCH_NEAREST_UNDER, entry, true)) )
+    shard->mut.lock();
     {
-        if((pos >= entry->pos) && ((pos + size) <= (entry->pos + entry->size)))
+        cache_entry_t entry;
+        if(shard->cache.find(key, cache_t::MATCH_NEAREST_UNDER, &entry, true))
         {
-            return true;
+            if((pos >= entry.pos) && ((pos + size) <= (entry.pos + entry.size)))
+            {
+                memcpy(buffer, &entry.data[pos - entry.pos], size);
+                found = true;
+            }
         }
     }
+    shard->mut.unlock();
 
-    return false;
+    return found;
+}
+
+/*----------------------------------------------------------------------------
+ * ioCacheEntry
+ *
+ *  takes ownership of the entry's data; least recently used entries are
+ *  evicted until the entry fits within the shard's capacity, and entries
+ *  larger than the whole shard are not retained
+ *----------------------------------------------------------------------------*/
+void H5FileBuffer::ioCacheEntry (cache_entry_t& entry, io_shard_t* shard, std::atomic<long>* cache_replace)
+{
+    bool retained = false;
+
+    shard->mut.lock();
+    {
+        if(entry.size <= shard->capacity)
+        {
+            /* Ensure Room in Shard */
+            while(shard->cache.isfull() || ((shard->bytes + entry.size) > shard->capacity))
+            {
+                /* Replace Oldest Entry */
+                cache_entry_t oldest_entry;
+                uint64_t oldest_pos = shard->cache.first(&oldest_entry);
+                if(oldest_pos == (uint64_t)INVALID_KEY) break;
+                shard->bytes -= oldest_entry.size;
+                delete [] oldest_entry.data;
+                shard->cache.remove(oldest_pos);
+
+                /* Count Cache Replacement */
+                (*cache_replace)++;
+            }
+
+            /* Add Cache Entry
+             *  should only fail to add if the cache line was
+             *  already added by another reader, in which case
+             *  the entry is freed below */
+            if(!shard->cache.isfull() && shard->cache.add(entry.pos, entry, true))
+            {
+                shard->bytes += entry.size;
+                retained = true;
+            }
+        }
+    }
+    shard->mut.unlock();
+
+    /* Free Entry Not Held in Cache */
+    if(!retained) delete [] entry.data;
+}
+
+/*----------------------------------------------------------------------------
+ * ioShardL1
+ *----------------------------------------------------------------------------*/
+long H5FileBuffer::ioShardL1 (uint64_t pos)
+{
+    return (long)((pos & ~IO_CACHE_L1_MASK) / IO_CACHE_L1_LINESIZE) % H5CORO_IO_CACHE_SHARDS;
 }
 
 /*----------------------------------------------------------------------------
@@ -714,7 +1118,7 @@ void H5FileBuffer::readDataset (info_t* info)
         {
             throw RunTimeException(CRITICAL, RTE_ERROR, "read exceeds available data: %ld != %ld", (long)metaData.size, (long)buffer_size);
         }
-        if((metaData.filter[DEFLATE_FILTER] || metaData.filter[SHUFFLE_FILTER]) && ((metaData.layout == COMPACT_LAYOUT) || (metaData.layout == CONTIGUOUS_LAYOUT)))
+        if((metaData.decompress || metaData.filter[SHUFFLE_FILTER]) && ((metaData.layout == COMPACT_LAYOUT) || (metaData.layout == CONTIGUOUS_LAYOUT)))
         {
             throw RunTimeException(CRITICAL, RTE_ERROR, "filters unsupported on non-chunked layouts");
         }
@@ -729,6 +1133,7 @@ void H5FileBuffer::readDataset (info_t* info)
             case CONTIGUOUS_LAYOUT:
             {
                 uint64_t data_addr = metaData.address + buffer_offset;
+                ioDriver->ioAdvise(buffer_size, data_addr, Asset::IODriver::IO_ACCESS_SEQUENTIAL);
                 ioRequest(&data_addr, buffer_size, buffer, IO_CACHE_L1_LINESIZE, false);
                 break;
             }
@@ -771,8 +1176,27 @@ void H5FileBuffer::readDataset (info_t* info)
                     dataSizeHint = buffer_size;
                 }
 
+                /* Gather Chunks for Pipeline */
+                if(H5CORO_CHUNK_PIPELINE_DEPTH > 1)
+                {
+                    dataChunkList = new List<chunk_rqst_t>;
+                }
+
                 /* Read B-Tree */
-                readBTreeV1(metaData.address, buffer, buffer_size, buffer_offset);
+                if(H5CORO_CHUNK_INDEX_CACHE_SIZE > 0)
+                {
+                    readChunkIndex(buffer, buffer_size, buffer_offset);
+                }
+                else
+                {
+                    readBTreeV1(metaData.address, buffer, buffer_size, buffer_offset);
+                }
+
+                /* Read Gathered Chunks */
+                if(dataChunkList)
+                {
+                    readChunkPipeline(buffer);
+                }
 
                 /* Check Need to Flatten Chunks */
                 bool flatten = false;
@@ -1396,8 +1820,6 @@ int H5FileBuffer::readIndirectBlock (heap_info_t* heap_info, int block_size, uin
 int H5FileBuffer::readBTreeV1 (uint64_t pos, uint8_t* buffer, uint64_t buffer_size, uint64_t buffer_offset)
 {
     uint64_t starting_position = pos;
-    uint64_t data_key1 = datasetStartRow;
-    uint64_t data_key2 = datasetStartRow + datasetNumRows - 1;
 
     /* Check Signature and Node Type */
     if(!H5_ERROR_CHECKING)
@@ -1462,183 +1884,775 @@ int H5FileBuffer::readBTreeV1 (uint64_t pos, uint8_t* buffer, uint64_t buffer_si
             print2term("Chunk Size:                                                      %u | %u\n", (unsigned int)curr_node.chunk_size, (unsigned int)next_node.chunk_size);
             print2term("Filter Mask:                                                     0x%x | 0x%x\n", (unsigned int)curr_node.filter_mask, (unsigned int)next_node.filter_mask);
             print2term("Chunk Key:                                                       %lu | %lu\n", (unsigned long)child_key1, (unsigned long)child_key2);
-            print2term("Data Key:                                                        %lu | %lu\n", (unsigned long)data_key1, (unsigned long)data_key2);
+            print2term("Data Key:                                                        %lu | %lu\n", (unsigned long)datasetStartRow, (unsigned long)(datasetStartRow + datasetNumRows - 1));
             print2term("Slice:                                                           ");
             for(int s = 0; s < metaData.ndims; s++) print2term("%lu ", (unsigned long)curr_node.slice[s]);
             print2term("\n");
             print2term("Child Address:                                                   0x%lx\n", (unsigned long)child_addr);
         }
 
-        /* Check Inclusion */
-        if ((data_key1  >= child_key1 && data_key1  <  child_key2) ||
-            (data_key2  >= child_key1 && data_key2  <  child_key2) ||
-            (child_key1 >= data_key1  && child_key1 <= data_key2)  ||
-            (child_key2 >  data_key1  && child_key2 <  data_key2))
+        /* Check Inclusion */
+        if (btreeIncludes(child_key1, child_key2))
+        {
+            /* Process Child Entry */
+            if(node_level > 0)
+            {
+                readBTreeV1(child_addr, buffer, buffer_size, buffer_offset);
+            }
+            else
+            {
+                chunk_entry_t entry = {
+                    .addr           = child_addr,
+                    .chunk_size     = curr_node.chunk_size,
+                    .filter_mask    = curr_node.filter_mask,
+                    .slice          = {curr_node.slice[0], curr_node.slice[1]},
+                    .row_key1       = child_key1,
+                    .row_key2       = child_key2
+                };
+
+                if(dataChunkIndex)
+                {
+                    /* Save Entry to Chunk Index */
+                    dataChunkIndex->add(entry);
+                }
+                else
+                {
+                    /* Read Chunk */
+                    processChunk(entry, buffer, buffer_size, buffer_offset);
+                }
+            }
+        }
+
+        /* Goto Next Key */
+        curr_node = next_node;
+    }
+
+    return 0;
+}
+
+/*----------------------------------------------------------------------------
+ * btreeIncludes
+ *----------------------------------------------------------------------------*/
+bool H5FileBuffer::btreeIncludes (uint64_t child_key1, uint64_t child_key2) const
+{
+    uint64_t data_key1 = datasetStartRow;
+    uint64_t data_key2 = datasetStartRow + datasetNumRows - 1;
+
+    return ((data_key1  >= child_key1 && data_key1  <  child_key2) ||
+            (data_key2  >= child_key1 && data_key2  <  child_key2) ||
+            (child_key1 >= data_key1  && child_key1 <= data_key2)  ||
+            (child_key2 >  data_key1  && child_key2 <  data_key2));
+}
+
+/*----------------------------------------------------------------------------
+ * processChunk
+ *----------------------------------------------------------------------------*/
+void H5FileBuffer::processChunk (const chunk_entry_t& entry, uint8_t* buffer, uint64_t buffer_size, uint64_t buffer_offset)
+{
+    /* Calculate Chunk Location */
+    uint64_t chunk_offset = 0;
+    for(int i = 0; i < metaData.ndims; i++)
+    {
+        uint64_t slice_size = entry.slice[i] * metaData.typesize;
+        for(int k = 0; k < i; k++)
+        {
+            slice_size *= metaData.chunkdims[k];
+        }
+        for(int j = i + 1; j < metaData.ndims; j++)
+        {
+            slice_size *= metaData.dimensions[j];
+        }
+        chunk_offset += slice_size;
+    }
+
+    /* Calculate Buffer Index - offset into data buffer to put chunked data */
+    uint64_t buffer_index = 0;
+    if(chunk_offset > buffer_offset)
+    {
+        buffer_index = chunk_offset - buffer_offset;
+        if(buffer_index >= buffer_size)
+        {
+            throw RunTimeException(CRITICAL, RTE_ERROR, "invalid location to read data: %ld, %lu", (unsigned long)chunk_offset, (unsigned long)buffer_offset);
+        }
+    }
+
+    /* Calculate Chunk Index - offset into chunk buffer to read from */
+    uint64_t chunk_index = 0;
+    if(buffer_offset > chunk_offset)
+    {
+        chunk_index = buffer_offset - chunk_offset;
+        if((int64_t)chunk_index >= dataChunkBufferSize)
+        {
+            throw RunTimeException(CRITICAL, RTE_ERROR, "invalid location to read chunk: %ld, %lu", (unsigned long)chunk_offset, (unsigned long)buffer_offset);
+        }
+    }
+
+    /* Calculate Chunk Bytes - number of bytes to read from chunk buffer */
+    int64_t chunk_bytes = dataChunkBufferSize - chunk_index;
+    if(chunk_bytes < 0)
+    {
+        throw RunTimeException(CRITICAL, RTE_ERROR, "no bytes of chunk data to read: %ld, %lu", (long)chunk_bytes, (unsigned long)chunk_index);
+    }
+    if((buffer_index + chunk_bytes) > buffer_size)
+    {
+        chunk_bytes = buffer_size - buffer_index;
+    }
+
+    /* Display Info */
+    if(H5_VERBOSE && H5_EXTRA_DEBUG)
+    {
+        print2term("Chunk Offset:                                                    %lu (%lu)\n", (unsigned long)chunk_offset, (unsigned long)(chunk_offset/metaData.typesize));
+        print2term("Buffer Index:                                                    %lu (%lu)\n", (unsigned long)buffer_index, (unsigned long)(buffer_index/metaData.typesize));
+        print2term("Chunk Bytes:                                                     %lu (%lu)\n", (unsigned long)chunk_bytes, (unsigned long)(chunk_bytes/metaData.typesize));
+    }
+
+    /* Read Chunk */
+    chunk_rqst_t chunk = {
+        .addr           = entry.addr,
+        .size           = entry.chunk_size,
+        .buffer_index   = buffer_index,
+        .chunk_index    = chunk_index,
+        .chunk_bytes    = chunk_bytes
+    };
+
+    if(dataChunkList)
+    {
+        /* Defer Read to Chunk Pipeline */
+        dataChunkList->add(chunk);
+    }
+    else
+    {
+        /* Read Chunk Now */
+        readChunk(chunk, buffer, dataChunkBuffer, dataChunkFilterBuffer, dataSizeHint, true);
+        dataSizeHint = IO_CACHE_L1_LINESIZE;
+    }
+}
+
+/*----------------------------------------------------------------------------
+ * readChunkIndex
+ *
+ *  reads the dataset's chunks using the decoded leaf entries of its b-tree;
+ *  the entries found by each read are merged into a sorted index shared
+ *  through the chunk index repository along with the rows they cover, so a
+ *  later read of rows already covered performs no b-tree i/o
+ *----------------------------------------------------------------------------*/
+void H5FileBuffer::readChunkIndex (uint8_t* buffer, uint64_t buffer_size, uint64_t buffer_offset)
+{
+    uint64_t index_key = metaGetKey(metaData.url);
+    uint64_t data_key1 = datasetStartRow;
+    uint64_t data_key2 = datasetStartRow + datasetNumRows - 1;
+    chunk_entry_t* entries = NULL;
+    int num_entries = 0;
+    bool found = false;
+
+    /* Check Chunk Index Repository */
+    chunkIndexMutex.lock();
+    {
+        chunk_index_t index;
+        if(chunkIndexRepo.find(index_key, chunk_repo_t::MATCH_EXACTLY, &index, true) && StringLib::match(index.url, metaData.url))
+        {
+            for(int r = 0; r < index.num_ranges && !found; r++)
+            {
+                found = (index.ranges[r].row_key1 <= data_key1) && (data_key2 <= index.ranges[r].row_key2);
+            }
+
+            if(found)
+            {
+                /* Find First Entry that can Reach Request */
+                int first = 0;
+                int last = index.num_entries;
+                while(first < last)
+                {
+                    int mid = (first + last) / 2;
+                    if(index.reach[mid] < data_key1) first = mid + 1;
+                    else last = mid;
+                }
+
+                /* Copy Out Entries up to End of Request */
+                last = first;
+                while(last < index.num_entries && index.entries[last].row_key1 <= data_key2) last++;
+                num_entries = last - first;
+                entries = new chunk_entry_t [num_entries];
+                memcpy(entries, &index.entries[first], num_entries * sizeof(chunk_entry_t));
+            }
+        }
+    }
+    chunkIndexMutex.unlock();
+
+    /* Traverse B-Tree */
+    if(!found)
+    {
+        ioContext->chunk_index_miss++;
+
+        /* Collect Entries Overlapping Request */
+        List<chunk_entry_t> index_list;
+        dataChunkIndex = &index_list;
+        try
+        {
+            readBTreeV1(metaData.address, buffer, buffer_size, buffer_offset);
+        }
+        catch(const RunTimeException& e)
+        {
+            dataChunkIndex = NULL;
+            throw;
+        }
+        dataChunkIndex = NULL;
+
+        /* Copy Out Entries */
+        num_entries = index_list.length();
+        entries = new chunk_entry_t [num_entries];
+        for(int i = 0; i < num_entries; i++)
+        {
+            entries[i] = index_list[i];
+        }
+        qsort(entries, num_entries, sizeof(chunk_entry_t), compareChunkEntries);
+
+        /* Add to Chunk Index Repository */
+        mergeChunkIndex(metaData.url, entries, num_entries, data_key1, data_key2);
+    }
+    else
+    {
+        ioContext->chunk_index_hit++;
+    }
+
+    /* Read Chunks Included in Request */
+    try
+    {
+        for(int i = 0; i < num_entries; i++)
+        {
+            if(btreeIncludes(entries[i].row_key1, entries[i].row_key2))
+            {
+                processChunk(entries[i], buffer, buffer_size, buffer_offset);
+            }
+        }
+    }
+    catch(const RunTimeException& e)
+    {
+        delete [] entries;
+        throw;
+    }
+
+    delete [] entries;
+}
+
+/*----------------------------------------------------------------------------
+ * mergeChunkIndex
+ *
+ *  entries must be sorted and hold every leaf entry overlapping the rows
+ *  row_key1 to row_key2; entries already in the index are skipped and the
+ *  rows are joined with any covered rows they overlap or touch
+ *----------------------------------------------------------------------------*/
+void H5FileBuffer::mergeChunkIndex (const char* url, chunk_entry_t* entries, int num_entries, uint64_t row_key1, uint64_t row_key2)
+{
+    uint64_t index_key = metaGetKey(url);
+
+    chunkIndexMutex.lock();
+    {
+        /* Take Existing Index out of Repository */
+        chunk_index_t old_index = {"", NULL, NULL, 0, NULL, 0};
+        chunk_index_t repo_index;
+        if(chunkIndexRepo.find(index_key, chunk_repo_t::MATCH_EXACTLY, &repo_index))
+        {
+            chunkIndexBytes -= chunkIndexSize(repo_index);
+            chunkIndexRepo.remove(index_key);
+            if(StringLib::match(repo_index.url, url)) old_index = repo_index;
+            else freeChunkIndex(repo_index);
+        }
+
+        /* Merge Entries */
+        chunk_index_t index;
+        StringLib::copy(index.url, url, MAX_META_NAME_SIZE);
+        index.entries = new chunk_entry_t [old_index.num_entries + num_entries];
+        int i = 0, j = 0, k = 0;
+        while(i < old_index.num_entries || j < num_entries)
+        {
+            int cmp = (j >= num_entries) ? -1 : (i >= old_index.num_entries) ? 1 : compareChunkEntries(&old_index.entries[i], &entries[j]);
+            if(cmp < 0)         index.entries[k++] = old_index.entries[i++];
+            else if(cmp > 0)    index.entries[k++] = entries[j++];
+            else                {index.entries[k++] = old_index.entries[i++]; j++;}
+        }
+        index.num_entries = k;
+
+        /* Build Reach of Entries */
+        index.reach = new uint64_t [index.num_entries];
+        uint64_t reach = 0;
+        for(int e = 0; e < index.num_entries; e++)
+        {
+            reach = MAX(reach, index.entries[e].row_key2);
+            index.reach[e] = reach;
+        }
+
+        /* Merge Covered Rows */
+        row_range_t range = {row_key1, row_key2};
+        bool placed = false;
+        index.ranges = new row_range_t [old_index.num_ranges + 1];
+        index.num_ranges = 0;
+        for(int r = 0; r < old_index.num_ranges; r++)
+        {
+            const row_range_t& old_range = old_index.ranges[r];
+            if(old_range.row_key2 + 1 < range.row_key1)
+            {
+                index.ranges[index.num_ranges++] = old_range;
+            }
+            else if(range.row_key2 + 1 < old_range.row_key1)
+            {
+                if(!placed) index.ranges[index.num_ranges++] = range;
+                index.ranges[index.num_ranges++] = old_range;
+                placed = true;
+            }
+            else
+            {
+                range.row_key1 = MIN(range.row_key1, old_range.row_key1);
+                range.row_key2 = MAX(range.row_key2, old_range.row_key2);
+            }
+        }
+        if(!placed) index.ranges[index.num_ranges++] = range;
+        freeChunkIndex(old_index);
+
+        /* Add Index to Repository */
+        int64_t index_size = chunkIndexSize(index);
+        if(index_size <= H5CORO_CHUNK_INDEX_CACHE_SIZE)
+        {
+            /* Remove Least Recently Used Entries until Index Fits */
+            while((chunkIndexRepo.isfull() || (chunkIndexBytes + index_size) > H5CORO_CHUNK_INDEX_CACHE_SIZE) && (chunkIndexRepo.length() > 0))
+            {
+                chunk_index_t oldest_index;
+                uint64_t oldest_key = chunkIndexRepo.first(&oldest_index);
+                chunkIndexBytes -= chunkIndexSize(oldest_index);
+                freeChunkIndex(oldest_index);
+                chunkIndexRepo.remove(oldest_key);
+            }
+
+            chunkIndexRepo.add(index_key, index, false);
+            chunkIndexBytes += index_size;
+        }
+        else
+        {
+            freeChunkIndex(index);
+        }
+    }
+    chunkIndexMutex.unlock();
+}
+
+/*----------------------------------------------------------------------------
+ * chunkIndexSize
+ *----------------------------------------------------------------------------*/
+int64_t H5FileBuffer::chunkIndexSize (const chunk_index_t& index)
+{
+    return (index.num_entries * (sizeof(chunk_entry_t) + sizeof(uint64_t))) + (index.num_ranges * sizeof(row_range_t));
+}
+
+/*----------------------------------------------------------------------------
+ * freeChunkIndex
+ *----------------------------------------------------------------------------*/
+void H5FileBuffer::freeChunkIndex (chunk_index_t& index)
+{
+    delete [] index.entries;
+    delete [] index.reach;
+    delete [] index.ranges;
+    index.entries = NULL;
+    index.reach = NULL;
+    index.ranges = NULL;
+    index.num_entries = 0;
+    index.num_ranges = 0;
+}
+
+/*----------------------------------------------------------------------------
+ * compareChunkEntries
+ *
+ *  orders entries by first row; the same chunk always has the same address
+ *----------------------------------------------------------------------------*/
+int H5FileBuffer::compareChunkEntries (const void* a, const void* b)
+{
+    const chunk_entry_t* entry_a = (const chunk_entry_t*)a;
+    const chunk_entry_t* entry_b = (const chunk_entry_t*)b;
+
+    if(entry_a->row_key1 != entry_b->row_key1) return (entry_a->row_key1 < entry_b->row_key1) ? -1 : 1;
+    if(entry_a->addr != entry_b->addr) return (entry_a->addr < entry_b->addr) ? -1 : 1;
+    return 0;
+}
+
+/*----------------------------------------------------------------------------
+ * readBTreeNodeV1
+ *----------------------------------------------------------------------------*/
+H5FileBuffer::btree_node_t H5FileBuffer::readBTreeNodeV1 (int ndims, uint64_t* pos)
+{
+    btree_node_t node;
+
+    /* Read Key */
+    node.chunk_size = (uint32_t)readField(4, pos);
+    node.filter_mask = (uint32_t)readField(4, pos);
+    for(int d = 0; d < ndims; d++)
+    {
+        node.slice[d] = readField(8, pos);
+    }
+
+    /* Read Trailing Zero */
+    uint64_t trailing_zero = readField(8, pos);
+    if(H5_ERROR_CHECKING)
+    {
+        if(trailing_zero % metaData.typesize != 0)
+        {
+            throw RunTimeException(CRITICAL, RTE_ERROR, "key did not include a trailing zero: %lu", trailing_zero);
+        }
+        if(H5_VERBOSE && H5_EXTRA_DEBUG)
+        {
+            print2term("Trailing Zero:                                                   %d\n", (int)trailing_zero);
+        }
+    }
+
+    /* Set Node Key */
+    if(ndims > 0)   node.row_key = node.slice[0];
+    else            node.row_key = 0;
+
+    /* Return Copy of Node */
+    return node;
+}
+
+/*----------------------------------------------------------------------------
+ * readChunk
+ *----------------------------------------------------------------------------*/
+void H5FileBuffer::readChunk (const chunk_rqst_t& chunk, uint8_t* buffer, uint8_t* chunk_buffer, uint8_t* filter_buffer, int64_t hint, bool cache, Asset::IODriver* driver)
+{
+    uint64_t chunk_addr = chunk.addr;
+
+    /* Check for Mapped Chunk (prefetched by readChunkPipeline) */
+    Asset::IODriver* io_driver = driver ? driver : ioDriver;
+    const uint8_t* mapped = io_driver->ioMap(chunk.size, chunk.addr);
+
+    if(metaData.decompress)
+    {
+        /* Check Current Node Chunk Size */
+        if(chunk.size > (dataChunkBufferSize * FILTER_SIZE_SCALE))
+        {
+            throw RunTimeException(CRITICAL, RTE_ERROR, "Compressed chunk size exceeds buffer: %u > %lu", chunk.size, (unsigned long)dataChunkBufferSize);
+        }
+
+        /* Read Data into Chunk Filter Buffer (holds the compressed data)
+        *  unless it is mapped, in which case it is decompressed in place;
+        *  filters do not modify their input */
+        uint8_t* compressed = (uint8_t*)mapped;
+        if(!compressed)
+        {
+            ioRequest(&chunk_addr, chunk.size, filter_buffer, hint, cache, driver);
+            compressed = filter_buffer;
+        }
+
+        if((chunk.chunk_bytes == dataChunkBufferSize) && (!metaData.filter[SHUFFLE_FILTER]))
+        {
+            /* Decompress Directly into Data Buffer */
+            metaData.decompress(compressed, chunk.size, &buffer[chunk.buffer_index], chunk.chunk_bytes);
+        }
+        else
+        {
+            /* Decompress into Data Chunk Buffer */
+            metaData.decompress(compressed, chunk.size, chunk_buffer, dataChunkBufferSize);
+
+            if(metaData.filter[SHUFFLE_FILTER])
+            {
+                /* Shuffle Data Chunk Buffer into Data Buffer */
+                shuffleChunk(chunk_buffer, dataChunkBufferSize, &buffer[chunk.buffer_index], chunk.chunk_index, chunk.chunk_bytes, metaData.typesize);
+            }
+            else
+            {
+                /* Copy Data Chunk Buffer into Data Buffer */
+                memcpy(&buffer[chunk.buffer_index], &chunk_buffer[chunk.chunk_index], chunk.chunk_bytes);
+            }
+        }
+    }
+    else /* no supported filters */
+    {
+        if(H5_ERROR_CHECKING)
+        {
+            if(metaData.filter[SHUFFLE_FILTER])
+            {
+                throw RunTimeException(CRITICAL, RTE_ERROR, "shuffle filter unsupported on uncompressed chunk");
+            }
+            if(dataChunkBufferSize != chunk.size)
+            {
+                throw RunTimeException(CRITICAL, RTE_ERROR, "mismatch in chunk size: %lu, %lu", (unsigned long)chunk.size, (unsigned long)dataChunkBufferSize);
+            }
+        }
+
+        /* Read Data into Data Buffer */
+        chunk_addr += chunk.chunk_index;
+        ioRequest(&chunk_addr, chunk.chunk_bytes, &buffer[chunk.buffer_index], hint, cache, driver);
+    }
+}
+
+/*----------------------------------------------------------------------------
+ * readChunkPipeline
+ *
+ *  reads all chunks gathered while traversing the b-tree; the pipeline is
+ *  queued to the persistent chunk workers and the calling thread reads
+ *  chunks alongside them, so the latency of outstanding reads overlaps with
+ *  the inflating of chunks already received
+ *----------------------------------------------------------------------------*/
+void H5FileBuffer::readChunkPipeline (uint8_t* buffer)
+{
+    int num_chunks = dataChunkList->length();
+    if(num_chunks <= 0) return;
+
+    /* Advise Driver of Chunk Spans
+     *  neighbouring chunks are merged into a single hint so that drivers
+     *  see a few large ranges instead of one small range per chunk */
+    uint64_t span_start = dataChunkList->get(0).addr;
+    uint64_t span_end = span_start + dataChunkList->get(0).size;
+    for(int i = 1; i < num_chunks; i++)
+    {
+        const chunk_rqst_t& chunk = dataChunkList->get(i);
+        if(chunk.addr >= span_start && chunk.addr <= span_end + IO_CACHE_L1_LINESIZE)
+        {
+            span_end = MAX(span_end, chunk.addr + chunk.size);
+        }
+        else
+        {
+            ioDriver->ioAdvise(span_end - span_start, span_start, Asset::IODriver::IO_ACCESS_WILLNEED);
+            span_start = chunk.addr;
+            span_end = chunk.addr + chunk.size;
+        }
+    }
+    ioDriver->ioAdvise(span_end - span_start, span_start, Asset::IODriver::IO_ACCESS_WILLNEED);
+
+    /* Single Chunk or No Workers - Read Serially */
+    if(num_chunks == 1 || chunkWorkerCount <= 0)
+    {
+        for(int i = 0; i < num_chunks; i++)
+        {
+            readChunk(dataChunkList->get(i), buffer, dataChunkBuffer, dataChunkFilterBuffer, dataSizeHint, true);
+        }
+        return;
+    }
+
+    /* Initialize Pipeline */
+    chunk_pipeline_t pipeline;
+    pipeline.h5file = this;
+    pipeline.buffer = buffer;
+    pipeline.chunks = dataChunkList;
+    pipeline.next = 0;
+    pipeline.in_flight = 0;
+    pipeline.peak = 0;
+    pipeline.queued = false;
+    pipeline.failed = false;
+    pipeline.error[0] = '\0';
+    pipeline.next_queued = NULL;
+
+    /* Queue Pipeline to Chunk Workers */
+    chunkPipelineCond.lock();
+    {
+        enqueuePipeline(&pipeline);
+        chunkPipelineCond.signal();
+    }
+    chunkPipelineCond.unlock();
+
+    /* Read Chunks Alongside Workers
+     *  the pipeline lives on this stack, so it is not left until every
+     *  chunk claimed by a worker has been retired */
+    chunkPipelineCond.lock();
+    {
+        while(true)
         {
-            /* Process Child Entry */
-            if(node_level > 0)
-            {
-                readBTreeV1(child_addr, buffer, buffer_size, buffer_offset);
-            }
-            else
+            if(!pipeline.failed && pipeline.next < num_chunks && pipeline.in_flight < H5CORO_CHUNK_PIPELINE_DEPTH)
             {
-                /* Calculate Chunk Location */
-                uint64_t chunk_offset = 0;
-                for(int i = 0; i < metaData.ndims; i++)
-                {
-                    uint64_t slice_size = curr_node.slice[i] * metaData.typesize;
-                    for(int k = 0; k < i; k++)
-                    {
-                        slice_size *= metaData.chunkdims[k];
-                    }
-                    for(int j = i + 1; j < metaData.ndims; j++)
-                    {
-                        slice_size *= metaData.dimensions[j];
-                    }
-                    chunk_offset += slice_size;
-                }
-
-                /* Calculate Buffer Index - offset into data buffer to put chunked data */
-                uint64_t buffer_index = 0;
-                if(chunk_offset > buffer_offset)
-                {
-                    buffer_index = chunk_offset - buffer_offset;
-                    if(buffer_index >= buffer_size)
-                    {
-                        throw RunTimeException(CRITICAL, RTE_ERROR, "invalid location to read data: %ld, %lu", (unsigned long)chunk_offset, (unsigned long)buffer_offset);
-                    }
-                }
+                chunk_rqst_t chunk;
+                claimChunk(&pipeline, &chunk);
+                chunkPipelineCond.unlock();
 
-                /* Calculate Chunk Index - offset into chunk buffer to read from */
-                uint64_t chunk_index = 0;
-                if(buffer_offset > chunk_offset)
+                const char* error = NULL;
+                char error_buf[STR_BUFF_SIZE];
+                try
                 {
-                    chunk_index = buffer_offset - chunk_offset;
-                    if((int64_t)chunk_index >= dataChunkBufferSize)
-                    {
-                        throw RunTimeException(CRITICAL, RTE_ERROR, "invalid location to read chunk: %ld, %lu", (unsigned long)chunk_offset, (unsigned long)buffer_offset);
-                    }
+                    readChunk(chunk, buffer, dataChunkBuffer, dataChunkFilterBuffer, chunk.size, false);
                 }
-
-                /* Calculate Chunk Bytes - number of bytes to read from chunk buffer */
-                int64_t chunk_bytes = dataChunkBufferSize - chunk_index;
-                if(chunk_bytes < 0)
+                catch(const std::exception& e)
                 {
-                    throw RunTimeException(CRITICAL, RTE_ERROR, "no bytes of chunk data to read: %ld, %lu", (long)chunk_bytes, (unsigned long)chunk_index);
+                    error = StringLib::copy(error_buf, e.what(), STR_BUFF_SIZE);
                 }
-                if((buffer_index + chunk_bytes) > buffer_size)
+                catch(...)
                 {
-                    chunk_bytes = buffer_size - buffer_index;
+                    error = StringLib::copy(error_buf, "unknown exception", STR_BUFF_SIZE);
                 }
 
-                /* Display Info */
-                if(H5_VERBOSE && H5_EXTRA_DEBUG)
-                {
-                    print2term("Chunk Offset:                                                    %lu (%lu)\n", (unsigned long)chunk_offset, (unsigned long)(chunk_offset/metaData.typesize));
-                    print2term("Buffer Index:                                                    %lu (%lu)\n", (unsigned long)buffer_index, (unsigned long)(buffer_index/metaData.typesize));
-                    print2term("Chunk Bytes:                                                     %lu (%lu)\n", (unsigned long)chunk_bytes, (unsigned long)(chunk_bytes/metaData.typesize));
-                }
+                chunkPipelineCond.lock();
+                retireChunk(&pipeline, error);
+            }
+            else if(pipeline.in_flight > 0)
+            {
+                chunkPipelineCond.wait(0, SYS_TIMEOUT);
+            }
+            else
+            {
+                break;
+            }
+        }
+    }
+    chunkPipelineCond.unlock();
 
-                /* Read Chunk */
-                if(metaData.filter[DEFLATE_FILTER])
-                {
-                    /* Check Current Node Chunk Size */
-                    if(curr_node.chunk_size > (dataChunkBufferSize * FILTER_SIZE_SCALE))
-                    {
-                        throw RunTimeException(CRITICAL, RTE_ERROR, "Compressed chunk size exceeds buffer: %u > %lu", curr_node.chunk_size, (unsigned long)dataChunkBufferSize);
-                    }
+    /* Update Statistics */
+    ioContext->pipeline_chunks += pipeline.next;
+    long peak = ioContext->pipeline_peak;
+    while((pipeline.peak > peak) && !ioContext->pipeline_peak.compare_exchange_weak(peak, pipeline.peak));
 
-                    /* Read Data into Chunk Filter Buffer (holds the compressed data) */
-                    ioRequest(&child_addr, curr_node.chunk_size, dataChunkFilterBuffer, dataSizeHint, true);
-                    if((chunk_bytes == dataChunkBufferSize) && (!metaData.filter[SHUFFLE_FILTER]))
-                    {
-                        /* Inflate Directly into Data Buffer */
-                        inflateChunk(dataChunkFilterBuffer, curr_node.chunk_size, &buffer[buffer_index], chunk_bytes);
-                    }
-                    else
-                    {
-                        /* Inflate into Data Chunk Buffer */
-                        inflateChunk(dataChunkFilterBuffer, curr_node.chunk_size, dataChunkBuffer, dataChunkBufferSize);
+    /* Check for Errors */
+    if(pipeline.failed)
+    {
+        throw RunTimeException(CRITICAL, RTE_ERROR, "failed to read chunk: %s", pipeline.error);
+    }
+}
 
-                        if(metaData.filter[SHUFFLE_FILTER])
-                        {
-                            /* Shuffle Data Chunk Buffer into Data Buffer */
-                            shuffleChunk(dataChunkBuffer, dataChunkBufferSize, &buffer[buffer_index], chunk_index, chunk_bytes, metaData.typesize);
-                        }
-                        else
-                        {
-                            /* Copy Data Chunk Buffer into Data Buffer */
-                            memcpy(&buffer[buffer_index], &dataChunkBuffer[chunk_index], chunk_bytes);
-                        }
-                    }
+/*----------------------------------------------------------------------------
+ * chunkWorkerThread
+ *
+ *  persistent reader shared by all pipelines; takes the next chunk from the
+ *  first queued pipeline that is below its depth and reads it with a driver
+ *  borrowed from the i/o context of that pipeline
+ *----------------------------------------------------------------------------*/
+void* H5FileBuffer::chunkWorkerThread (void* parm)
+{
+    (void)parm;
 
-                    /* Handle Caching */
-                    dataSizeHint = IO_CACHE_L1_LINESIZE;
-                }
-                else /* no supported filters */
-                {
-                    if(H5_ERROR_CHECKING)
-                    {
-                        if(metaData.filter[SHUFFLE_FILTER])
-                        {
-                            throw RunTimeException(CRITICAL, RTE_ERROR, "shuffle filter unsupported on uncompressed chunk");
-                        }
-                        if(dataChunkBufferSize != curr_node.chunk_size)
-                        {
-                            throw RunTimeException(CRITICAL, RTE_ERROR, "mismatch in chunk size: %lu, %lu", (unsigned long)curr_node.chunk_size, (unsigned long)dataChunkBufferSize);
-                        }
-                    }
+    uint8_t* chunk_buffer = NULL;
+    uint8_t* filter_buffer = NULL;
+    int64_t buffer_size = 0;
 
-                    /* Read Data into Data Buffer */
-                    uint64_t chunk_offset_addr = child_addr + chunk_index;
-                    ioRequest(&chunk_offset_addr, chunk_bytes, &buffer[buffer_index], dataSizeHint, true);
-                    dataSizeHint = IO_CACHE_L1_LINESIZE;
-                }
+    chunkPipelineCond.lock();
+    while(chunkPipelineActive)
+    {
+        /* Find Pipeline with Chunks Available */
+        chunk_pipeline_t* pipeline = chunkPipelineQ;
+        while(pipeline && pipeline->in_flight >= H5CORO_CHUNK_PIPELINE_DEPTH)
+        {
+            pipeline = pipeline->next_queued;
+        }
+
+        if(!pipeline)
+        {
+            chunkPipelineCond.wait(0, SYS_TIMEOUT);
+            continue;
+        }
+
+        /* Claim Chunk */
+        chunk_rqst_t chunk;
+        claimChunk(pipeline, &chunk);
+        H5FileBuffer* h5file = pipeline->h5file;
+        chunkPipelineCond.unlock();
+
+        /* Read Chunk
+         *  the exact size of each chunk is requested and not cached
+         *  since parallel overreads of cache lines would overlap */
+        const char* error = NULL;
+        char error_buf[STR_BUFF_SIZE];
+        Asset::IODriver* driver = NULL;
+        try
+        {
+            /* Grow Worker Buffers to Chunk Size of Dataset */
+            if(buffer_size < h5file->dataChunkBufferSize)
+            {
+                delete [] chunk_buffer;
+                delete [] filter_buffer;
+                chunk_buffer = NULL;
+                filter_buffer = NULL;
+                buffer_size = 0;
+                chunk_buffer = new uint8_t [h5file->dataChunkBufferSize];
+                filter_buffer = new uint8_t [h5file->dataChunkBufferSize * FILTER_SIZE_SCALE];
+                buffer_size = h5file->dataChunkBufferSize;
             }
+
+            driver = h5file->ioContext->acquireDriver(h5file->ioAsset, h5file->ioResource);
+            h5file->readChunk(chunk, pipeline->buffer, chunk_buffer, filter_buffer, chunk.size, false, driver);
+            h5file->ioContext->releaseDriver(h5file->ioAsset, h5file->ioResource, driver);
+        }
+        catch(const std::exception& e)
+        {
+            delete driver;
+            error = StringLib::copy(error_buf, e.what(), STR_BUFF_SIZE);
+        }
+        catch(...)
+        {
+            delete driver;
+            error = StringLib::copy(error_buf, "unknown exception", STR_BUFF_SIZE);
         }
 
-        /* Goto Next Key */
-        curr_node = next_node;
+        /* Retire Chunk */
+        chunkPipelineCond.lock();
+        retireChunk(pipeline, error);
     }
+    chunkPipelineCond.unlock();
 
-    return 0;
+    /* Clean Up Worker Resources */
+    delete [] chunk_buffer;
+    delete [] filter_buffer;
+
+    return NULL;
 }
 
 /*----------------------------------------------------------------------------
- * readBTreeNodeV1
+ * claimChunk
+ *
+ *  must be called with chunkPipelineCond locked; the pipeline leaves the work
+ *  queue once its last chunk has been claimed
  *----------------------------------------------------------------------------*/
-H5FileBuffer::btree_node_t H5FileBuffer::readBTreeNodeV1 (int ndims, uint64_t* pos)
+void H5FileBuffer::claimChunk (chunk_pipeline_t* pipeline, chunk_rqst_t* chunk)
 {
-    btree_node_t node;
+    *chunk = pipeline->chunks->get(pipeline->next++);
+    pipeline->in_flight++;
+    pipeline->peak = MAX(pipeline->peak, pipeline->in_flight);
 
-    /* Read Key */
-    node.chunk_size = (uint32_t)readField(4, pos);
-    node.filter_mask = (uint32_t)readField(4, pos);
-    for(int d = 0; d < ndims; d++)
+    if(pipeline->next >= pipeline->chunks->length())
     {
-        node.slice[d] = readField(8, pos);
+        dequeuePipeline(pipeline);
     }
+}
 
-    /* Read Trailing Zero */
-    uint64_t trailing_zero = readField(8, pos);
-    if(H5_ERROR_CHECKING)
+/*----------------------------------------------------------------------------
+ * retireChunk
+ *
+ *  must be called with chunkPipelineCond locked; the first error fails the
+ *  pipeline which stops any further chunks from being claimed
+ *----------------------------------------------------------------------------*/
+void H5FileBuffer::retireChunk (chunk_pipeline_t* pipeline, const char* error)
+{
+    pipeline->in_flight--;
+
+    if(error && !pipeline->failed)
     {
-        if(trailing_zero % metaData.typesize != 0)
-        {
-            throw RunTimeException(CRITICAL, RTE_ERROR, "key did not include a trailing zero: %lu", trailing_zero);
-        }
-        if(H5_VERBOSE && H5_EXTRA_DEBUG)
-        {
-            print2term("Trailing Zero:                                                   %d\n", (int)trailing_zero);
-        }
+        pipeline->failed = true;
+        StringLib::copy(pipeline->error, error, STR_BUFF_SIZE);
+        dequeuePipeline(pipeline);
     }
 
-    /* Set Node Key */
-    if(ndims > 0)   node.row_key = node.slice[0];
-    else            node.row_key = 0;
+    chunkPipelineCond.signal();
+}
 
-    /* Return Copy of Node */
-    return node;
+/*----------------------------------------------------------------------------
+ * enqueuePipeline
+ *
+ *  must be called with chunkPipelineCond locked; pipelines are served in the
+ *  order they were queued
+ *----------------------------------------------------------------------------*/
+void H5FileBuffer::enqueuePipeline (chunk_pipeline_t* pipeline)
+{
+    chunk_pipeline_t** link = &chunkPipelineQ;
+    while(*link) link = &(*link)->next_queued;
+    *link = pipeline;
+    pipeline->next_queued = NULL;
+    pipeline->queued = true;
+}
+
+/*----------------------------------------------------------------------------
+ * dequeuePipeline
+ *
+ *  must be called with chunkPipelineCond locked
+ *----------------------------------------------------------------------------*/
+void H5FileBuffer::dequeuePipeline (chunk_pipeline_t* pipeline)
+{
+    if(!pipeline->queued) return;
+
+    chunk_pipeline_t** link = &chunkPipelineQ;
+    while(*link && *link != pipeline) link = &(*link)->next_queued;
+    if(*link) *link = pipeline->next_queued;
+    pipeline->next_queued = NULL;
+    pipeline->queued = false;
 }
 
 /*----------------------------------------------------------------------------
@@ -2794,7 +3808,24 @@ int H5FileBuffer::readFilterMsg (uint64_t pos, uint8_t hdr_flags, int dlvl)
         }
 
         /* Set Filter */
-        if(filter < NUM_FILTERS)
+        filter_entry_t entry;
+        bool registered = false;
+        filterMutex.lock();
+        {
+            registered = filterRegistry.find(filter, filter_registry_t::MATCH_EXACTLY, &entry);
+        }
+        filterMutex.unlock();
+        if(registered)
+        {
+            if(metaData.decompress && (metaData.compression != filter))
+            {
+                throw RunTimeException(CRITICAL, RTE_ERROR, "multiple compression filters unsupported: %d, %d", metaData.compression, filter);
+            }
+            metaData.compression = filter;
+            metaData.decompress = entry.decompress;
+            if(filter < NUM_FILTERS) metaData.filter[filter] = true;
+        }
+        else if(filter < NUM_FILTERS)
         {
             metaData.filter[filter] = true;
         }
@@ -3343,10 +4374,161 @@ int H5FileBuffer::inflateChunk (uint8_t* input, uint32_t input_size, uint8_t* ou
     return 0;
 }
 
+/*----------------------------------------------------------------------------
+ * libdeflateChunk
+ *
+ *  the uncompressed size of a chunk is always known, so the whole chunk is
+ *  decoded in a single call instead of through zlib's streaming interface
+ *----------------------------------------------------------------------------*/
+int H5FileBuffer::libdeflateChunk (uint8_t* input, uint32_t input_size, uint8_t* output, uint32_t output_size)
+{
+    #ifdef H5CORO_LIBDEFLATE
+    struct libdeflate_decompressor* decompressor = libdeflate_owner.decompressor;
+    if(!decompressor)
+    {
+        decompressor = libdeflate_alloc_decompressor();
+        if(!decompressor)
+        {
+            throw RunTimeException(CRITICAL, RTE_ERROR, "failed to allocate libdeflate decompressor");
+        }
+        libdeflate_owner.decompressor = decompressor;
+    }
+
+    size_t actual_size = 0;
+    enum libdeflate_result status = libdeflate_zlib_decompress(decompressor, input, input_size, output, output_size, &actual_size);
+
+    if(status != LIBDEFLATE_SUCCESS)
+    {
+        throw RunTimeException(CRITICAL, RTE_ERROR, "failed to inflate chunk with libdeflate: %d", (int)status);
+    }
+
+    return 0;
+    #else
+    return inflateChunk(input, input_size, output, output_size);
+    #endif
+}
+
+/*----------------------------------------------------------------------------
+ * zstdChunk
+ *----------------------------------------------------------------------------*/
+int H5FileBuffer::zstdChunk (uint8_t* input, uint32_t input_size, uint8_t* output, uint32_t output_size)
+{
+    #ifdef H5CORO_ZSTD
+    size_t status = ZSTD_decompress(output, output_size, input, input_size);
+    if(ZSTD_isError(status))
+    {
+        throw RunTimeException(CRITICAL, RTE_ERROR, "failed to decompress zstd chunk: %s", ZSTD_getErrorName(status));
+    }
+
+    return 0;
+    #else
+    (void)input;
+    (void)input_size;
+    (void)output;
+    (void)output_size;
+    throw RunTimeException(CRITICAL, RTE_ERROR, "zstd filter not supported");
+    #endif
+}
+
+/*----------------------------------------------------------------------------
+ * lz4Chunk
+ *
+ *  the HDF5 lz4 filter prefixes the data with the big endian total size (8 bytes)
+ *  and block size (4 bytes); each block is then stored as a big endian
+ *  compressed size (4 bytes) followed by the block, which is left uncompressed
+ *  when compressing it would not have saved any space
+ *----------------------------------------------------------------------------*/
+int H5FileBuffer::lz4Chunk (uint8_t* input, uint32_t input_size, uint8_t* output, uint32_t output_size)
+{
+    #ifdef H5CORO_LZ4
+    if(input_size < 12)
+    {
+        throw RunTimeException(CRITICAL, RTE_ERROR, "invalid lz4 chunk size: %u", input_size);
+    }
+
+    /* Read Header */
+    uint64_t total_size = 0;
+    for(int i = 0; i < 8; i++) total_size = (total_size << 8) | input[i];
+    uint32_t block_size = ((uint32_t)input[8] << 24) | ((uint32_t)input[9] << 16) | ((uint32_t)input[10] << 8) | (uint32_t)input[11];
+    if(total_size > output_size || block_size == 0)
+    {
+        throw RunTimeException(CRITICAL, RTE_ERROR, "invalid lz4 chunk header: %lu, %u", (unsigned long)total_size, block_size);
+    }
+
+    /* Decompress Blocks */
+    uint64_t in_pos = 12;
+    uint64_t out_pos = 0;
+    while(out_pos < total_size)
+    {
+        uint32_t expected_size = MIN(block_size, total_size - out_pos);
+        if(in_pos + 4 > input_size)
+        {
+            throw RunTimeException(CRITICAL, RTE_ERROR, "truncated lz4 chunk at %lu", (unsigned long)in_pos);
+        }
+        uint32_t compressed_size = ((uint32_t)input[in_pos] << 24) | ((uint32_t)input[in_pos + 1] << 16) | ((uint32_t)input[in_pos + 2] << 8) | (uint32_t)input[in_pos + 3];
+        in_pos += 4;
+        if(in_pos + compressed_size > input_size)
+        {
+            throw RunTimeException(CRITICAL, RTE_ERROR, "truncated lz4 block at %lu: %u", (unsigned long)in_pos, compressed_size);
+        }
+
+        if(compressed_size == expected_size)
+        {
+            memcpy(&output[out_pos], &input[in_pos], expected_size);
+        }
+        else
+        {
+            int status = LZ4_decompress_safe((const char*)&input[in_pos], (char*)&output[out_pos], compressed_size, expected_size);
+            if(status != (int)expected_size)
+            {
+                throw RunTimeException(CRITICAL, RTE_ERROR, "failed to decompress lz4 block: %d", status);
+            }
+        }
+
+        in_pos += compressed_size;
+        out_pos += expected_size;
+    }
+
+    return 0;
+    #else
+    (void)input;
+    (void)input_size;
+    (void)output;
+    (void)output_size;
+    throw RunTimeException(CRITICAL, RTE_ERROR, "lz4 filter not supported");
+    #endif
+}
+
+/*----------------------------------------------------------------------------
+ * bloscChunk
+ *
+ *  blosc buffers are self describing (including any shuffling applied
+ *  internally by blosc), so no filter parameters are needed
+ *----------------------------------------------------------------------------*/
+int H5FileBuffer::bloscChunk (uint8_t* input, uint32_t input_size, uint8_t* output, uint32_t output_size)
+{
+    #ifdef H5CORO_BLOSC
+    (void)input_size;
+    int status = blosc_decompress_ctx(input, output, output_size, 1);
+    if(status < 0)
+    {
+        throw RunTimeException(CRITICAL, RTE_ERROR, "failed to decompress blosc chunk: %d", status);
+    }
+
+    return 0;
+    #else
+    (void)input;
+    (void)input_size;
+    (void)output;
+    (void)output_size;
+    throw RunTimeException(CRITICAL, RTE_ERROR, "blosc filter not supported");
+    #endif
+}
+
 /*----------------------------------------------------------------------------
  * shuffleChunk
  *----------------------------------------------------------------------------*/
-int H5FileBuffer::shuffleChunk (const uint8_t* input, uint32_t input_size, uint8_t* output, uint32_t output_offset, uint32_t output_size, int type_size)
+int H5FileBuffer::shuffleChunk (const uint8_t* input, uint32_t input_size, uint8_t* output, uint32_t output_offset, uint32_t output_size, int type_size, shuffle_impl_t impl)
 {
     if(H5_ERROR_CHECKING)
     {
@@ -3356,11 +4538,24 @@ int H5FileBuffer::shuffleChunk (const uint8_t* input, uint32_t input_size, uint8
         }
     }
 
-    int64_t dst_index = 0;
     int64_t shuffle_block_size = input_size / type_size;
     int64_t num_elements = output_size / type_size;
     int64_t start_element = output_offset / type_size;
-    for(int64_t element_index = start_element; element_index < (start_element + num_elements); element_index++)
+
+    /* Vectorized De-interleave */
+    int64_t elements_done = 0;
+    if(impl == AUTO_SHUFFLE) impl = shuffleImpl;
+    #ifdef H5_SIMD_SHUFFLE
+    if(type_size == 2 || type_size == 4 || type_size == 8)
+    {
+        if      (impl == AVX2_SHUFFLE)  elements_done = unshuffleAVX2(input, shuffle_block_size, output, start_element, num_elements, type_size);
+        else if (impl == SSE2_SHUFFLE)  elements_done = unshuffleSSE2(input, shuffle_block_size, output, start_element, num_elements, type_size);
+    }
+    #endif
+
+    /* Scalar De-interleave (remaining elements) */
+    int64_t dst_index = elements_done * type_size;
+    for(int64_t element_index = start_element + elements_done; element_index < (start_element + num_elements); element_index++)
     {
         for(int64_t val_index = 0; val_index < type_size; val_index++)
         {
@@ -3372,6 +4567,114 @@ int H5FileBuffer::shuffleChunk (const uint8_t* input, uint32_t input_size, uint8
     return 0;
 }
 
+/*----------------------------------------------------------------------------
+ * detectShuffleImpl
+ *----------------------------------------------------------------------------*/
+H5FileBuffer::shuffle_impl_t H5FileBuffer::detectShuffleImpl (void)
+{
+    #ifdef H5_SIMD_SHUFFLE
+    __builtin_cpu_init();
+    if(__builtin_cpu_supports("avx2"))  return AVX2_SHUFFLE;
+    if(__builtin_cpu_supports("sse2"))  return SSE2_SHUFFLE;
+    #endif
+    return SCALAR_SHUFFLE;
+}
+
+/*----------------------------------------------------------------------------
+ * initFilters
+ *
+ *  registers the decompression filters compiled into H5Coro; deflate uses
+ *  libdeflate when available and falls back to zlib otherwise
+ *----------------------------------------------------------------------------*/
+void H5FileBuffer::initFilters (void)
+{
+    #ifdef H5CORO_LIBDEFLATE
+    registerFilter(DEFLATE_FILTER, "libdeflate", libdeflateChunk);
+    #else
+    registerFilter(DEFLATE_FILTER, "zlib", inflateChunk);
+    #endif
+
+    #ifdef H5CORO_ZSTD
+    registerFilter(ZSTD_FILTER_ID, "zstd", zstdChunk);
+    #endif
+
+    #ifdef H5CORO_LZ4
+    registerFilter(LZ4_FILTER_ID, "lz4", lz4Chunk);
+    #endif
+
+    #ifdef H5CORO_BLOSC
+    registerFilter(BLOSC_FILTER_ID, "blosc", bloscChunk);
+    #endif
+}
+
+/*----------------------------------------------------------------------------
+ * initPipeline
+ *
+ *  starts the chunk workers once for the life of the process so that a read
+ *  does not pay for creating threads and opening drivers
+ *----------------------------------------------------------------------------*/
+void H5FileBuffer::initPipeline (int num_workers)
+{
+    chunkPipelineActive = true;
+    chunkWorkerCount = MAX(num_workers, 0);
+    chunkWorkerPids = new Thread* [chunkWorkerCount];
+    for(int t = 0; t < chunkWorkerCount; t++)
+    {
+        chunkWorkerPids[t] = new Thread(chunkWorkerThread, NULL);
+    }
+}
+
+/*----------------------------------------------------------------------------
+ * deinitPipeline
+ *----------------------------------------------------------------------------*/
+void H5FileBuffer::deinitPipeline (void)
+{
+    chunkPipelineCond.lock();
+    {
+        chunkPipelineActive = false;
+        chunkPipelineCond.signal();
+    }
+    chunkPipelineCond.unlock();
+
+    for(int t = 0; t < chunkWorkerCount; t++)
+    {
+        delete chunkWorkerPids[t];
+    }
+    delete [] chunkWorkerPids;
+    chunkWorkerPids = NULL;
+    chunkWorkerCount = 0;
+}
+
+/*----------------------------------------------------------------------------
+ * registerFilter
+ *
+ *  replaces any filter previously registered with the same identifier
+ *----------------------------------------------------------------------------*/
+bool H5FileBuffer::registerFilter (int filter_id, const char* name, filter_func_t decompress)
+{
+    bool status;
+
+    if(filter_id <= INVALID_FILTER || filter_id == SHUFFLE_FILTER || decompress == NULL)
+    {
+        mlog(CRITICAL, "Unable to register decompression filter %d", filter_id);
+        return false;
+    }
+
+    filter_entry_t entry;
+    StringLib::copy(entry.name, name, STR_BUFF_SIZE);
+    entry.decompress = decompress;
+
+    filterMutex.lock();
+    {
+        status = filterRegistry.add(filter_id, entry, false);
+    }
+    filterMutex.unlock();
+
+    if(status) mlog(DEBUG, "Registered decompression filter %d: %s", filter_id, name);
+
+    return status;
+}
+
 /*----------------------------------------------------------------------------
  * metaGetKey
  *----------------------------------------------------------------------------*/
@@ -3435,6 +4738,13 @@ int          H5Coro::threadPoolSize;
  *----------------------------------------------------------------------------*/
 void H5Coro::init (int num_threads)
 {
+    H5FileBuffer::initFilters();
+
+    if(H5CORO_CHUNK_PIPELINE_DEPTH > 1)
+    {
+        H5FileBuffer::initPipeline(H5CORO_CHUNK_PIPELINE_WORKERS);
+    }
+
     rqstPub = new Publisher(NULL);
 
     if(num_threads > 0)
@@ -3473,6 +4783,8 @@ void H5Coro::deinit (void)
         delete rqstSub;
     }
 
+    H5FileBuffer::deinitPipeline();
+
     delete rqstPub;
 }
 
@@ -41,6 +41,8 @@
 #include "Table.h"
 #include "Asset.h"
 
+#include <atomic>
+
 /******************************************************************************
  * HDF5 DEFINES
  ******************************************************************************/
@@ -49,6 +51,30 @@
 #define H5CORO_MAXIMUM_NAME_SIZE 104
 #endif
 
+#ifndef H5CORO_CHUNK_INDEX_CACHE_SIZE
+#define H5CORO_CHUNK_INDEX_CACHE_SIZE 0x4000000 // 64MB of decoded chunk b-tree entries shared by all reads; 0 disables cache
+#endif
+
+#ifndef H5CORO_IO_CACHE_L1_SIZE
+#define H5CORO_IO_CACHE_L1_SIZE 0x9D00000 // 157MB of 1MB cache lines per I/O context
+#endif
+
+#ifndef H5CORO_IO_CACHE_L2_SIZE
+#define H5CORO_IO_CACHE_L2_SIZE 0x40000000 // 1GB of large (prefetch) cache lines per I/O context
+#endif
+
+#ifndef H5CORO_IO_CACHE_SHARDS
+#define H5CORO_IO_CACHE_SHARDS 16 // number of independently locked partitions of the level 1 cache
+#endif
+
+#ifndef H5CORO_CHUNK_PIPELINE_DEPTH
+#define H5CORO_CHUNK_PIPELINE_DEPTH 8 // maximum chunks read in parallel per dataset; 1 disables pipeline
+#endif
+
+#ifndef H5CORO_CHUNK_PIPELINE_WORKERS
+#define H5CORO_CHUNK_PIPELINE_WORKERS 16 // persistent chunk reader threads shared by all pipelined reads
+#endif
+
 /******************************************************************************
  * HDF5 FUTURE CLASS
  ******************************************************************************/
@@ -120,12 +146,27 @@ class H5FileBuffer
         static const int MAX_NDIMS      = 2;
         static const int FLAT_NDIMS     = 3;
 
+        /* Third Party Filter Identifiers (registered with The HDF Group) */
+        static const int BLOSC_FILTER_ID    = 32001;
+        static const int LZ4_FILTER_ID      = 32004;
+        static const int ZSTD_FILTER_ID     = 32015;
+
         /*--------------------------------------------------------------------
         * Typedefs
         *--------------------------------------------------------------------*/
 
         typedef H5Future::info_t info_t;
 
+        typedef enum {
+            AUTO_SHUFFLE            = -1, // best implementation supported by processor
+            SCALAR_SHUFFLE          = 0,
+            SSE2_SHUFFLE            = 1,
+            AVX2_SHUFFLE            = 2
+        } shuffle_impl_t;
+
+        /* decompresses input into output; output_size is the size of the uncompressed chunk */
+        typedef int (*filter_func_t) (uint8_t* input, uint32_t input_size, uint8_t* output, uint32_t output_size);
+
         /*--------------------------------------------------------------------
         * I/O Context (subclass)
         *--------------------------------------------------------------------*/
@@ -138,20 +179,46 @@ class H5FileBuffer
 
         typedef Table<cache_entry_t, uint64_t> cache_t;
 
+        typedef struct {
+            const Asset*            asset;
+            const char*             resource;
+            Asset::IODriver*        driver;
+        } driver_entry_t;
+
+        struct io_shard_t
+        {
+            cache_t     cache; // least recently used entry is first
+            Mutex       mut; // shard mutex
+            int64_t     capacity; // maximum number of bytes held in shard
+            int64_t     bytes; // number of bytes currently held in shard
+
+            io_shard_t      (long entries, int64_t _capacity, cache_t::hash_func_t hash);
+            ~io_shard_t     (void);
+        };
+
         struct io_context_t
         {
-            cache_t     l1; // level 1 cache
-            cache_t     l2; // level 2 cache
-            Mutex       mut; // cache mutex
-            long        pre_prefetch_request;
-            long        post_prefetch_request;
-            long        cache_miss;
-            long        l1_cache_replace;
-            long        l2_cache_replace;
-            long        bytes_read;
-
-            io_context_t    (void);
+            io_shard_t*         l1[H5CORO_IO_CACHE_SHARDS]; // level 1 cache, sharded by cache line
+            io_shard_t          l2; // level 2 cache
+            std::atomic<long>   pre_prefetch_request;
+            std::atomic<long>   post_prefetch_request;
+            std::atomic<long>   cache_hit;
+            std::atomic<long>   cache_miss;
+            std::atomic<long>   l1_cache_replace;
+            std::atomic<long>   l2_cache_replace;
+            std::atomic<long>   bytes_read;
+            std::atomic<long>   pipeline_chunks; // chunks read through the parallel chunk pipeline
+            std::atomic<long>   pipeline_peak; // maximum number of chunk reads in flight at the same time
+            std::atomic<long>   chunk_index_hit; // chunk b-tree index found in repository
+            std::atomic<long>   chunk_index_miss; // chunk b-tree had to be traversed
+            List<driver_entry_t> drivers; // idle i/o drivers reused by pipelined chunk reads
+            Mutex               drivers_mut; // driver pool mutex
+
+            io_context_t    (int64_t l1_capacity=H5CORO_IO_CACHE_L1_SIZE, int64_t l2_capacity=H5CORO_IO_CACHE_L2_SIZE);
             ~io_context_t   (void);
+            int64_t cached  (void); // number of bytes currently held in cache
+            Asset::IODriver* acquireDriver (const Asset* asset, const char* resource);
+            void releaseDriver (const Asset* asset, const char* resource, Asset::IODriver* driver);
         };
 
         /*--------------------------------------------------------------------
@@ -161,6 +228,14 @@ class H5FileBuffer
                             H5FileBuffer        (info_t* info, io_context_t* context, const Asset* asset, const char* resource, const char* dataset, long startrow, long numrows, bool _meta_only=false);
         virtual             ~H5FileBuffer       (void);
 
+        static int          shuffleChunk        (const uint8_t* input, uint32_t input_size, uint8_t* output, uint32_t output_offset, uint32_t output_size, int type_size, shuffle_impl_t impl=AUTO_SHUFFLE);
+        static shuffle_impl_t detectShuffleImpl (void);
+
+        static void         initFilters         (void);
+        static void         initPipeline        (int num_workers);
+        static void         deinitPipeline      (void);
+        static bool         registerFilter      (int filter_id, const char* name, filter_func_t decompress);
+
     protected:
 
         /*--------------------------------------------------------------------
@@ -180,6 +255,7 @@ class H5FileBuffer
 
         static const long       MAX_META_STORE          = 150000;
         static const long       MAX_META_NAME_SIZE      = (H5CORO_MAXIMUM_NAME_SIZE & 0xFFF8); // forces size to multiple of 8
+        static const long       MAX_CHUNK_INDEX_STORE   = 15000; // datasets with chunk indexes held in repository
 
         /*
          * Assuming:
@@ -191,13 +267,14 @@ class H5FileBuffer
 
         static const int64_t    IO_CACHE_L1_LINESIZE    = 0x100000; // 1MB cache line
         static const uint64_t   IO_CACHE_L1_MASK        = 0x0FFFFF; // lower inverse of buffer size
-        static const long       IO_CACHE_L1_ENTRIES     = 157; // cache lines per dataset
+        static const long       IO_CACHE_L1_ENTRIES     = 17; // minimum cache lines per level 1 shard
 
         static const uint64_t   IO_CACHE_L2_MASK        = 0x7FFFFFF; // lower inverse of buffer size
         static const long       IO_CACHE_L2_ENTRIES     = 17; // cache lines per dataset
 
         static const long       STR_BUFF_SIZE           = 128;
         static const long       FILTER_SIZE_SCALE       = 1; // maximum factor for dataChunkFilterBuffer
+        static const long       MAX_FILTER_REGISTRY     = 64; // number of decompression filters that can be registered
 
         static const uint64_t   H5_SIGNATURE_LE         = 0x0A1A0A0D46444889LL;
         static const uint64_t   H5_OHDR_SIGNATURE_LE    = 0x5244484FLL; // object header
@@ -276,6 +353,36 @@ class H5FileBuffer
             uint64_t                row_key;
         } btree_node_t;
 
+        typedef struct {
+            uint64_t                addr;           // file address of chunk
+            uint32_t                chunk_size;     // number of bytes of chunk stored in file
+            uint32_t                filter_mask;    // filters skipped for chunk
+            uint64_t                slice[MAX_NDIMS];
+            uint64_t                row_key1;       // first row in chunk
+            uint64_t                row_key2;       // first row past chunk
+        } chunk_entry_t;
+
+        typedef struct {
+            uint64_t                addr;           // file address of chunk
+            uint32_t                size;           // number of bytes of chunk stored in file
+            uint64_t                buffer_index;   // offset into data buffer to write chunk data
+            uint64_t                chunk_index;    // offset into uncompressed chunk to read from
+            int64_t                 chunk_bytes;    // number of bytes copied out of uncompressed chunk
+        } chunk_rqst_t;
+
+        typedef struct chunk_pipeline {
+            H5FileBuffer*           h5file;
+            uint8_t*                buffer;         // data buffer being populated
+            List<chunk_rqst_t>*     chunks;         // all chunks that need to be read
+            int                     next;           // index of next chunk to read
+            int                     in_flight;      // number of chunk reads currently outstanding
+            int                     peak;           // high water mark of in_flight
+            bool                    queued;         // pipeline is in the work queue of the chunk workers
+            bool                    failed;         // set when any reader encounters an error
+            char                    error[STR_BUFF_SIZE];
+            struct chunk_pipeline*  next_queued;    // next pipeline in the work queue
+        } chunk_pipeline_t;
+
         typedef struct {
             int                     table_width;
             int                     curr_num_rows;
@@ -297,12 +404,21 @@ class H5FileBuffer
             uint8_t                 fill_b;
         } fill_t;
 
+        typedef struct {
+            char                    name[STR_BUFF_SIZE];
+            filter_func_t           decompress;
+        } filter_entry_t;
+
+        typedef Table<filter_entry_t, int> filter_registry_t;
+
         typedef struct {
             char                    url[MAX_META_NAME_SIZE];
             data_type_t             type;
             layout_t                layout;
             fill_t                  fill;
             bool                    filter[NUM_FILTERS]; // true if enabled for dataset
+            int                     compression; // identifier of the decompression filter (INVALID_FILTER if none)
+            filter_func_t           decompress; // decompression filter looked up from registry
             bool                    signedval; // is the value a signed or not
             int                     typesize;
             int                     fillsize;
@@ -319,14 +435,32 @@ class H5FileBuffer
 
         typedef Table<meta_entry_t, uint64_t> meta_repo_t;
 
+        typedef struct {
+            uint64_t                row_key1;       // first row covered
+            uint64_t                row_key2;       // last row covered
+        } row_range_t;
+
+        typedef struct {
+            char                    url[MAX_META_NAME_SIZE];
+            chunk_entry_t*          entries;        // leaf entries of chunk b-tree read so far, sorted by first row
+            uint64_t*               reach;          // running maximum of row_key2 over entries, for binary search
+            int                     num_entries;
+            row_range_t*            ranges;         // sorted disjoint rows for which all overlapping entries are present
+            int                     num_ranges;
+        } chunk_index_t;
+
+        typedef Table<chunk_index_t, uint64_t> chunk_repo_t;
+
        /*--------------------------------------------------------------------
         * Methods
         *--------------------------------------------------------------------*/
 
         void                tearDown              (void);
 
-        void                ioRequest             (uint64_t* pos, int64_t size, uint8_t* buffer, int64_t hint, bool cache);
-        static bool         ioCheckCache          (uint64_t pos, int64_t size, cache_t* cache, uint64_t line_mask, cache_entry_t* entry);
+        void                ioRequest             (uint64_t* pos, int64_t size, uint8_t* buffer, int64_t hint, bool cache, Asset::IODriver* driver=NULL);
+        static bool         ioCheckCache          (uint64_t key, uint64_t pos, int64_t size, uint8_t* buffer, io_shard_t* shard);
+        static void         ioCacheEntry          (cache_entry_t& entry, io_shard_t* shard, std::atomic<long>* cache_replace);
+        static long         ioShardL1             (uint64_t pos);
         static uint64_t     ioHashL1              (uint64_t key);
         static uint64_t     ioHashL2              (uint64_t key);
 
@@ -340,6 +474,20 @@ class H5FileBuffer
         int                 readIndirectBlock     (heap_info_t* heap_info, int block_size, uint64_t pos, uint8_t hdr_flags, int dlvl);
         int                 readBTreeV1           (uint64_t pos, uint8_t* buffer, uint64_t buffer_size, uint64_t buffer_offset);
         btree_node_t        readBTreeNodeV1       (int ndims, uint64_t* pos);
+        bool                btreeIncludes         (uint64_t child_key1, uint64_t child_key2) const;
+        void                processChunk          (const chunk_entry_t& entry, uint8_t* buffer, uint64_t buffer_size, uint64_t buffer_offset);
+        void                readChunkIndex        (uint8_t* buffer, uint64_t buffer_size, uint64_t buffer_offset);
+        static void         mergeChunkIndex       (const char* url, chunk_entry_t* entries, int num_entries, uint64_t row_key1, uint64_t row_key2);
+        static int64_t      chunkIndexSize        (const chunk_index_t& index);
+        static void         freeChunkIndex        (chunk_index_t& index);
+        static int          compareChunkEntries   (const void* a, const void* b);
+        void                readChunk             (const chunk_rqst_t& chunk, uint8_t* buffer, uint8_t* chunk_buffer, uint8_t* filter_buffer, int64_t hint, bool cache, Asset::IODriver* driver=NULL);
+        void                readChunkPipeline     (uint8_t* buffer);
+        static void*        chunkWorkerThread     (void* parm);
+        static void         claimChunk            (chunk_pipeline_t* pipeline, chunk_rqst_t* chunk);
+        static void         retireChunk           (chunk_pipeline_t* pipeline, const char* error);
+        static void         enqueuePipeline       (chunk_pipeline_t* pipeline);
+        static void         dequeuePipeline       (chunk_pipeline_t* pipeline);
         int                 readSymbolTable       (uint64_t pos, uint64_t heap_data_addr, int dlvl);
 
         int                 readObjHdr            (uint64_t pos, int dlvl);
@@ -365,7 +513,10 @@ class H5FileBuffer
         static const char*  layout2str            (layout_t layout);
         static int          highestBit            (uint64_t value);
         static int          inflateChunk          (uint8_t* input, uint32_t input_size, uint8_t* output, uint32_t output_size);
-        static int          shuffleChunk          (const uint8_t* input, uint32_t input_size, uint8_t* output, uint32_t output_offset, uint32_t output_size, int type_size);
+        static int          libdeflateChunk       (uint8_t* input, uint32_t input_size, uint8_t* output, uint32_t output_size);
+        static int          zstdChunk             (uint8_t* input, uint32_t input_size, uint8_t* output, uint32_t output_size);
+        static int          lz4Chunk              (uint8_t* input, uint32_t input_size, uint8_t* output, uint32_t output_size);
+        static int          bloscChunk            (uint8_t* input, uint32_t input_size, uint8_t* output, uint32_t output_size);
 
         static uint64_t     metaGetKey            (const char* url);
         static void         metaGetUrl            (char* url, const char* resource, const char* dataset);
@@ -374,10 +525,29 @@ class H5FileBuffer
         * Data
         *--------------------------------------------------------------------*/
 
+        /* Shuffle Filter */
+        static shuffle_impl_t shuffleImpl;
+
+        /* Decompression Filters */
+        static filter_registry_t filterRegistry;
+        static Mutex        filterMutex;
+
         /* Meta Repository */
         static meta_repo_t  metaRepo;
         static Mutex        metaMutex;
 
+        /* Chunk Index Repository */
+        static chunk_repo_t chunkIndexRepo;
+        static int64_t      chunkIndexBytes;
+        static Mutex        chunkIndexMutex;
+
+        /* Chunk Pipeline */
+        static chunk_pipeline_t* chunkPipelineQ;    // pipelines with chunks waiting for a worker
+        static Cond         chunkPipelineCond;      // guards all pipelines; signaled on every state change
+        static bool         chunkPipelineActive;
+        static Thread**     chunkWorkerPids;
+        static int          chunkWorkerCount;
+
         /* Class Data */
         const char*         datasetName;            // holds buffer of dataset name that datasetPath points back into
         const char*         datasetPrint;           // holds untouched dataset name string used for displaying the name
@@ -389,6 +559,8 @@ class H5FileBuffer
         bool                metaOnly;
 
         /* I/O Management */
+        const Asset*        ioAsset;
+        const char*         ioResource;             // needed to open additional drivers for pipelined chunk reads
         Asset::IODriver*    ioDriver;
         char*               ioBucket;               // s3 driver
         char*               ioKey;                  // s3 driver
@@ -402,6 +574,8 @@ class H5FileBuffer
         int64_t             dataChunkBufferSize;    // dataChunkElements * dataInfo->typesize
         int                 highestDataLevel;       // high water mark for traversing dataset path
         int64_t             dataSizeHint;
+        List<chunk_rqst_t>* dataChunkList;          // chunks gathered from b-tree when pipelining reads
+        List<chunk_entry_t>* dataChunkIndex;        // b-tree leaf entries overlapping request when building chunk index
 
         /* Meta Info */
         meta_entry_t        metaData;
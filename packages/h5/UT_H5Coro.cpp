@@ -0,0 +1,221 @@
+/*
+ * Copyright (c) 2021, University of Washington
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the University of Washington nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE UNIVERSITY OF WASHINGTON AND CONTRIBUTORS
+ * “AS IS” AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE UNIVERSITY OF WASHINGTON OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+
+#include "core.h"
+#include "UT_H5Coro.h"
+#include "H5Coro.h"
+
+/******************************************************************************
+ * STATIC DATA
+ ******************************************************************************/
+
+const char* UT_H5Coro::OBJECT_TYPE = "UT_H5Coro";
+
+const char* UT_H5Coro::LUA_META_NAME = "UT_H5Coro";
+const struct luaL_Reg UT_H5Coro::LUA_META_TABLE[] = {
+    {"shuffletest",     luaShuffleTest},
+    {"shufflebench",    luaShuffleBenchmark},
+    {NULL,              NULL}
+};
+
+/******************************************************************************
+ * PUBLIC METHODS
+ ******************************************************************************/
+
+/*----------------------------------------------------------------------------
+ * luaCreate - :ut_h5coro()
+ *----------------------------------------------------------------------------*/
+int UT_H5Coro::luaCreate (lua_State* L)
+{
+    try
+    {
+        /* Create H5Coro Unit Test */
+        return createLuaObject(L, new UT_H5Coro(L));
+    }
+    catch(const RunTimeException& e)
+    {
+        mlog(e.level(), "Error creating %s: %s", LUA_META_NAME, e.what());
+        return returnLuaStatus(L, false);
+    }
+}
+
+/******************************************************************************
+ * PRIVATE METHODS
+ *******************************************************************************/
+
+/*----------------------------------------------------------------------------
+ * Constructor
+ *----------------------------------------------------------------------------*/
+UT_H5Coro::UT_H5Coro (lua_State* L):
+    LuaObject(L, OBJECT_TYPE, LUA_META_NAME, LUA_META_TABLE)
+{
+}
+
+/*----------------------------------------------------------------------------
+ * Destructor  -
+ *----------------------------------------------------------------------------*/
+UT_H5Coro::~UT_H5Coro(void)
+{
+}
+
+/*----------------------------------------------------------------------------
+ * luaShuffleTest - :shuffletest() --> status
+ *
+ *  compares every shuffle implementation supported by the processor against
+ *  the scalar implementation for each type size and a range of offsets
+ *----------------------------------------------------------------------------*/
+int UT_H5Coro::luaShuffleTest (lua_State* L)
+{
+    bool status = false;
+
+    const int num_elements[] = {1, 15, 16, 17, 31, 32, 33, 1000, 4099};
+    const int start_elements[] = {0, 1, 5, 37};
+    H5FileBuffer::shuffle_impl_t best_impl = H5FileBuffer::detectShuffleImpl();
+
+    try
+    {
+        bool tests_passed = true;
+
+        for(int type_size = 1; type_size <= 8; type_size++)
+        {
+            for(int n: num_elements)
+            {
+                for(int start: start_elements)
+                {
+                    if(start >= n) continue;
+
+                    /* Build Shuffled Input */
+                    uint32_t input_size = n * type_size;
+                    uint32_t output_offset = start * type_size;
+                    uint32_t output_size = input_size - output_offset;
+                    uint8_t* input = new uint8_t [input_size];
+                    for(uint32_t i = 0; i < input_size; i++) input[i] = (uint8_t)((i * 131) + (i >> 8));
+
+                    /* Unshuffle with Scalar Implementation */
+                    uint8_t* expected = new uint8_t [output_size];
+                    H5FileBuffer::shuffleChunk(input, input_size, expected, output_offset, output_size, type_size, H5FileBuffer::SCALAR_SHUFFLE);
+
+                    /* Check Vectorized Implementations */
+                    uint8_t* output = new uint8_t [output_size];
+                    for(int impl = H5FileBuffer::SSE2_SHUFFLE; impl <= best_impl; impl++)
+                    {
+                        memset(output, 0, output_size);
+                        H5FileBuffer::shuffleChunk(input, input_size, output, output_offset, output_size, type_size, (H5FileBuffer::shuffle_impl_t)impl);
+                        if(memcmp(output, expected, output_size) != 0)
+                        {
+                            mlog(CRITICAL, "Failed shuffle test for implementation %d: type size %d, %d elements, start %d", impl, type_size, n, start);
+                            tests_passed = false;
+                        }
+                    }
+
+                    delete [] input;
+                    delete [] expected;
+                    delete [] output;
+                }
+            }
+        }
+
+        /* Set Status */
+        status = tests_passed;
+    }
+    catch(const RunTimeException& e)
+    {
+        mlog(e.level(), "Error executing test %s: %s", __FUNCTION__, e.what());
+    }
+
+    /* Return Status */
+    return returnLuaStatus(L, status);
+}
+
+/*----------------------------------------------------------------------------
+ * luaShuffleBenchmark - :shufflebench(<type size>, <chunk size>, <iterations>) --> {<impl>=<GB/s>, ...}
+ *----------------------------------------------------------------------------*/
+int UT_H5Coro::luaShuffleBenchmark (lua_State* L)
+{
+    bool status = false;
+    int num_obj_to_return = 1;
+    uint8_t* input = NULL;
+    uint8_t* output = NULL;
+
+    try
+    {
+        /* Get Parameters */
+        long type_size  = getLuaInteger(L, 2, true, 8);
+        long chunk_size = getLuaInteger(L, 3, true, 0x100000);
+        long iterations = getLuaInteger(L, 4, true, 100);
+
+        /* Check Parameters */
+        if(type_size <= 0 || type_size > 8) throw RunTimeException(CRITICAL, RTE_ERROR, "invalid type size: %ld", type_size);
+        if(chunk_size <= 0) throw RunTimeException(CRITICAL, RTE_ERROR, "invalid chunk size: %ld", chunk_size);
+        if(iterations <= 0) throw RunTimeException(CRITICAL, RTE_ERROR, "invalid number of iterations: %ld", iterations);
+        chunk_size -= chunk_size % type_size;
+
+        /* Allocate Chunks */
+        input = new uint8_t [chunk_size];
+        output = new uint8_t [chunk_size];
+        for(long i = 0; i < chunk_size; i++) input[i] = (uint8_t)i;
+
+        /* Time Each Implementation */
+        const char* impl_names[] = {"scalar", "sse2", "avx2"};
+        H5FileBuffer::shuffle_impl_t best_impl = H5FileBuffer::detectShuffleImpl();
+        lua_newtable(L);
+        for(int impl = H5FileBuffer::SCALAR_SHUFFLE; impl <= best_impl; impl++)
+        {
+            double start = TimeLib::latchtime();
+            for(long i = 0; i < iterations; i++)
+            {
+                H5FileBuffer::shuffleChunk(input, chunk_size, output, 0, chunk_size, type_size, (H5FileBuffer::shuffle_impl_t)impl);
+            }
+            double duration = TimeLib::latchtime() - start;
+            double gbps = (duration > 0.0) ? ((double)chunk_size * iterations) / duration / 1000000000.0 : 0.0;
+            LuaEngine::setAttrNum(L, impl_names[impl], gbps);
+        }
+
+        /* Set Success */
+        status = true;
+        num_obj_to_return = 2;
+    }
+    catch(const RunTimeException& e)
+    {
+        mlog(e.level(), "Error executing test %s: %s", __FUNCTION__, e.what());
+    }
+
+    /* Clean Up */
+    delete [] input;
+    delete [] output;
+
+    /* Return Status */
+    return returnLuaStatus(L, status, num_obj_to_return);
+}
@@ -58,6 +58,7 @@ int h5_open (lua_State *L)
     static const struct luaL_Reg h5_functions[] = {
         {"file",        H5File::luaCreate},
         {"dataset",     H5DatasetDevice::luaCreate},
+        {"ut_h5coro",   UT_H5Coro::luaCreate},
         {NULL,          NULL}
     };
 
@@ -41,6 +41,7 @@
 #include "H5DArray.h"
 #include "H5DatasetDevice.h"
 #include "H5File.h"
+#include "UT_H5Coro.h"
 
 /******************************************************************************
  * PROTOTYPES
@@ -0,0 +1,256 @@
+/*
+ * Copyright (c) 2021, University of Washington
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the University of Washington nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE UNIVERSITY OF WASHINGTON AND CONTRIBUTORS
+ * “AS IS” AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE UNIVERSITY OF WASHINGTON OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+
+#include <stdlib.h>
+#include "UT_EventLib.h"
+#include "core.h"
+
+/******************************************************************************
+ * MACROS
+ ******************************************************************************/
+
+#define ut_assert(e,...)    UT_EventLib::_ut_assert(e,__FILE__,__LINE__,__VA_ARGS__)
+
+/******************************************************************************
+ * STATIC DATA
+ ******************************************************************************/
+
+const char* UT_EventLib::TYPE = "UT_EventLib";
+
+/******************************************************************************
+ * PUBLIC METHODS
+ ******************************************************************************/
+
+/*----------------------------------------------------------------------------
+ * createObject  -
+ *----------------------------------------------------------------------------*/
+CommandableObject* UT_EventLib::createObject(CommandProcessor* cmd_proc, const char* name, int argc, char argv[][MAX_CMD_SIZE])
+{
+    (void)argc;
+    (void)argv;
+
+    /* Create EventLib Unit Test */
+    return new UT_EventLib(cmd_proc, name);
+}
+
+/*----------------------------------------------------------------------------
+ * Constructor  -
+ *----------------------------------------------------------------------------*/
+UT_EventLib::UT_EventLib(CommandProcessor* cmd_proc, const char* obj_name):
+    CommandableObject(cmd_proc, obj_name, TYPE),
+    failures(0)
+{
+    /* Register Commands */
+    registerCommand("RINGS", (cmdFunc_t)&UT_EventLib::testRings, 1, "<event queue>");
+}
+
+/*----------------------------------------------------------------------------
+ * Destructor  -
+ *----------------------------------------------------------------------------*/
+UT_EventLib::~UT_EventLib(void)
+{
+}
+
+/*--------------------------------------------------------------------------------------
+ * _ut_assert - called via ut_assert macro
+ *--------------------------------------------------------------------------------------*/
+bool UT_EventLib::_ut_assert(bool e, const char* file, int line, const char* fmt, ...)
+{
+    if(!e)
+    {
+        char formatted_string[UT_MAX_ASSERT];
+        char log_message[UT_MAX_ASSERT];
+        va_list args;
+        int vlen, msglen;
+        char* pathptr;
+
+        /* Build Formatted String */
+        va_start(args, fmt);
+        vlen = vsnprintf(formatted_string, UT_MAX_ASSERT - 1, fmt, args);
+        msglen = vlen < UT_MAX_ASSERT - 1 ? vlen : UT_MAX_ASSERT - 1;
+        va_end(args);
+        if (msglen < 0) formatted_string[0] = '\0';
+        else            formatted_string[msglen] = '\0';
+
+        /* Chop Path in Filename */
+        pathptr = StringLib::find(file, '/', false);
+        if(pathptr) pathptr++;
+        else pathptr = (char*)file;
+
+        /* Create Log Message */
+        msglen = snprintf(log_message, UT_MAX_ASSERT, "Failure at %s:%d:%s", pathptr, line, formatted_string);
+        if(msglen > (UT_MAX_ASSERT - 1))
+        {
+            log_message[UT_MAX_ASSERT - 1] = '#';
+        }
+
+        /* Display Log Message */
+        print2term("%s", log_message);
+
+        /* Count Error */
+        failures++;
+    }
+
+    return e;
+}
+
+/*--------------------------------------------------------------------------------------
+ * ringWorker
+ *--------------------------------------------------------------------------------------*/
+void* UT_EventLib::ringWorker(void* parm)
+{
+    ring_worker_t* worker = static_cast<ring_worker_t*>(parm);
+    worker->tid = Thread::getId();
+
+    for(int seq = 0; seq < UT_RING_EVENTS; seq++)
+    {
+        EventLib::generateMetric(CRITICAL, "ut_eventlib.ring", EventLib::COUNTER, seq);
+    }
+
+    return NULL;
+}
+
+/*--------------------------------------------------------------------------------------
+ * testRings
+ *
+ *  every event generated by a thread is either delivered to the event queue in
+ *  the order it was generated or counted as dropped
+ *--------------------------------------------------------------------------------------*/
+int UT_EventLib::testRings(int argc, char argv[][MAX_CMD_SIZE])
+{
+    (void)argc;
+
+    failures = 0;
+
+    // subscribe to event queue
+    Subscriber eventq(argv[0]);
+    uint64_t dropped_before = EventLib::droppedEvents();
+
+    // start workers
+    ring_worker_t workers[UT_RING_THREADS];
+    Thread* pids[UT_RING_THREADS];
+    for(int i = 0; i < UT_RING_THREADS; i++)
+    {
+        workers[i].tid = 0;
+        workers[i].received = 0;
+        workers[i].last = -1;
+        pids[i] = new Thread(ringWorker, &workers[i]);
+    }
+
+    // receive events while the workers generate them
+    const long total = UT_RING_THREADS * UT_RING_EVENTS;
+    ring_worker_t senders[UT_RING_THREADS];
+    int num_senders = 0;
+    long received = 0;
+    bool in_order = true;
+    while(received + (long)(EventLib::droppedEvents() - dropped_before) < total)
+    {
+        Subscriber::msgRef_t ref;
+        int status = eventq.receiveRef(ref, 1000);
+        if(status <= 0)
+        {
+            ut_assert(status == MsgQ::STATE_TIMEOUT, "Failed to receive event: %d", status);
+            break;
+        }
+
+        // check metric events from workers
+        RecordInterface record((unsigned char*)ref.data, ref.size);
+        if(StringLib::match(record.getRecordType(), EventLib::rec_type))
+        {
+            EventLib::event_t* event = (EventLib::event_t*)record.getRecordData();
+            if(event->type == EventLib::METRIC && StringLib::match(event->name, "ut_eventlib.ring"))
+            {
+                int s = 0;
+                while(s < num_senders && senders[s].tid != event->tid) s++;
+                if(s == num_senders && num_senders < UT_RING_THREADS)
+                {
+                    senders[num_senders].tid = event->tid;
+                    senders[num_senders].received = 0;
+                    senders[num_senders].last = -1;
+                    num_senders++;
+                }
+
+                if(ut_assert(s < num_senders, "Failed to match event to worker: %ld", (long)event->tid))
+                {
+                    long seq = (long)strtod(event->attr, NULL);
+                    if(seq <= senders[s].last) in_order = false;
+                    senders[s].last = seq;
+                    senders[s].received++;
+                    received++;
+                }
+            }
+        }
+        eventq.dereference(ref);
+    }
+
+    // join workers
+    for(int i = 0; i < UT_RING_THREADS; i++)
+    {
+        delete pids[i];
+    }
+
+    // check results
+    long dropped = (long)(EventLib::droppedEvents() - dropped_before);
+    ut_assert(in_order, "Failed to deliver events in order");
+    ut_assert(received + dropped == total, "Failed to account for all events: %ld received + %ld dropped != %ld", received, dropped, total);
+    for(int i = 0; i < UT_RING_THREADS; i++)
+    {
+        int s = 0;
+        while(s < num_senders && senders[s].tid != workers[i].tid) s++;
+        if(dropped == 0 && ut_assert(s < num_senders, "Failed to receive events from worker %d", i))
+        {
+            ut_assert(senders[s].received == UT_RING_EVENTS, "Failed to receive all events from worker %d: %ld", i, senders[s].received);
+        }
+    }
+    print2term("Received %ld events, dropped %ld\n", received, dropped);
+
+    // an idle collector is woken by the next event rather than its timeout
+    OsApi::sleep(0.1);
+    EventLib::generateMetric(CRITICAL, "ut_eventlib.wake", EventLib::COUNTER, 0);
+    bool woken = false;
+    while(!woken)
+    {
+        Subscriber::msgRef_t ref;
+        if(eventq.receiveRef(ref, 250) <= 0) break;
+        RecordInterface record((unsigned char*)ref.data, ref.size);
+        EventLib::event_t* event = (EventLib::event_t*)record.getRecordData();
+        woken = StringLib::match(record.getRecordType(), EventLib::rec_type) && StringLib::match(event->name, "ut_eventlib.wake");
+        eventq.dereference(ref);
+    }
+    ut_assert(woken, "Failed to wake idle collector");
+
+    // return success or failure
+    return failures == 0 ? 0 : -1;
+}
@@ -0,0 +1,264 @@
+/*
+ * Copyright (c) 2021, University of Washington
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the University of Washington nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE UNIVERSITY OF WASHINGTON AND CONTRIBUTORS
+ * “AS IS” AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE UNIVERSITY OF WASHINGTON OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+
+#include <stdlib.h>
+#include <sys/stat.h>
+#include <utime.h>
+#include "UT_LuaEngine.h"
+#include "core.h"
+
+/******************************************************************************
+ * MACROS
+ ******************************************************************************/
+
+#define ut_assert(e,...)    UT_LuaEngine::_ut_assert(e,__FILE__,__LINE__,__VA_ARGS__)
+
+/******************************************************************************
+ * STATIC DATA
+ ******************************************************************************/
+
+const char* UT_LuaEngine::TYPE = "UT_LuaEngine";
+
+/******************************************************************************
+ * PUBLIC METHODS
+ ******************************************************************************/
+
+/*----------------------------------------------------------------------------
+ * createObject  -
+ *----------------------------------------------------------------------------*/
+CommandableObject* UT_LuaEngine::createObject(CommandProcessor* cmd_proc, const char* name, int argc, char argv[][MAX_CMD_SIZE])
+{
+    (void)argc;
+    (void)argv;
+
+    /* Create LuaEngine Unit Test */
+    return new UT_LuaEngine(cmd_proc, name);
+}
+
+/*----------------------------------------------------------------------------
+ * Constructor  -
+ *----------------------------------------------------------------------------*/
+UT_LuaEngine::UT_LuaEngine(CommandProcessor* cmd_proc, const char* obj_name):
+    CommandableObject(cmd_proc, obj_name, TYPE),
+    failures(0)
+{
+    /* Register Commands */
+    registerCommand("RECYCLE", (cmdFunc_t)&UT_LuaEngine::testRecycle, 1, "<scratch script path>");
+    registerCommand("CHUNKCACHE", (cmdFunc_t)&UT_LuaEngine::testChunkCache, 1, "<scratch script path>");
+}
+
+/*----------------------------------------------------------------------------
+ * Destructor  -
+ *----------------------------------------------------------------------------*/
+UT_LuaEngine::~UT_LuaEngine(void)
+{
+}
+
+/*--------------------------------------------------------------------------------------
+ * _ut_assert - called via ut_assert macro
+ *--------------------------------------------------------------------------------------*/
+bool UT_LuaEngine::_ut_assert(bool e, const char* file, int line, const char* fmt, ...)
+{
+    if(!e)
+    {
+        char formatted_string[UT_MAX_ASSERT];
+        char log_message[UT_MAX_ASSERT];
+        va_list args;
+        int vlen, msglen;
+        char* pathptr;
+
+        /* Build Formatted String */
+        va_start(args, fmt);
+        vlen = vsnprintf(formatted_string, UT_MAX_ASSERT - 1, fmt, args);
+        msglen = vlen < UT_MAX_ASSERT - 1 ? vlen : UT_MAX_ASSERT - 1;
+        va_end(args);
+        if (msglen < 0) formatted_string[0] = '\0';
+        else            formatted_string[msglen] = '\0';
+
+        /* Chop Path in Filename */
+        pathptr = StringLib::find(file, '/', false);
+        if(pathptr) pathptr++;
+        else pathptr = (char*)file;
+
+        /* Create Log Message */
+        msglen = snprintf(log_message, UT_MAX_ASSERT, "Failure at %s:%d:%s", pathptr, line, formatted_string);
+        if(msglen > (UT_MAX_ASSERT - 1))
+        {
+            log_message[UT_MAX_ASSERT - 1] = '#';
+        }
+
+        /* Display Log Message */
+        print2term("%s", log_message);
+
+        /* Count Error */
+        failures++;
+    }
+
+    return e;
+}
+
+/*--------------------------------------------------------------------------------------
+ * writeScript
+ *
+ *  writes the script to path and, if mtime is provided, sets its modification time
+ *--------------------------------------------------------------------------------------*/
+bool UT_LuaEngine::writeScript(const char* path, const char* script, time_t mtime)
+{
+    FILE* fp = fopen(path, "w");
+    if(!ut_assert(fp != NULL, "Failed to open %s", path)) return false;
+    size_t len = StringLib::size(script);
+    bool written = fwrite(script, 1, len, fp) == len;
+    fclose(fp);
+    if(!ut_assert(written, "Failed to write %s", path)) return false;
+
+    if(mtime != 0)
+    {
+        struct utimbuf times = {mtime, mtime};
+        if(!ut_assert(utime(path, &times) == 0, "Failed to set modification time of %s", path)) return false;
+    }
+
+    return true;
+}
+
+/*--------------------------------------------------------------------------------------
+ * runScript
+ *
+ *  runs the script on a pooled engine, checks its result, and recycles the engine
+ *--------------------------------------------------------------------------------------*/
+bool UT_LuaEngine::runScript(LuaEngine* engine, const char* path, const char* expected)
+{
+    bool status = false;
+
+    engine->reload(path, "");
+    if(ut_assert(engine->executeEngine(UT_TIMEOUT_MS), "Failed to complete %s", path))
+    {
+        const char* result = engine->getResult();
+        status = ut_assert(result != NULL && StringLib::match(result, expected), "Failed to get expected result from %s: %s != %s", path, result ? result : "nil", expected);
+    }
+    ut_assert(engine->recycle(), "Failed to recycle engine after %s", path);
+
+    return status;
+}
+
+/*--------------------------------------------------------------------------------------
+ * testRecycle
+ *
+ *  a recycled engine shows none of the changes the previous script made to
+ *  globals, loaded modules, library tables, or metatables
+ *--------------------------------------------------------------------------------------*/
+int UT_LuaEngine::testRecycle(int argc, char argv[][MAX_CMD_SIZE])
+{
+    (void)argc;
+
+    failures = 0;
+
+    const char* path = argv[0];
+    const char* dirty_script =
+        "ut_leak = true\n"
+        "string.ut_leak = function() return true end\n"
+        "string.format = nil\n"
+        "table.insert = function() end\n"
+        "math.pi = 3\n"
+        "package.loaded.ut_leak = {}\n"
+        "getmetatable('').ut_leak = true\n"
+        "setmetatable(_G, {__index = function() return 'leak' end})\n"
+        "return 'dirty'\n";
+    const char* check_script =
+        "local leaks = {}\n"
+        "if rawget(_G, 'ut_leak') ~= nil then leaks[#leaks+1] = 'global' end\n"
+        "if string.ut_leak ~= nil then leaks[#leaks+1] = 'string.ut_leak' end\n"
+        "if string.format == nil then leaks[#leaks+1] = 'string.format' end\n"
+        "local t = {} table.insert(t, 1) if #t ~= 1 then leaks[#leaks+1] = 'table.insert' end\n"
+        "if math.pi < 3.14 then leaks[#leaks+1] = 'math.pi' end\n"
+        "if package.loaded.ut_leak ~= nil then leaks[#leaks+1] = 'package.loaded' end\n"
+        "if getmetatable('').ut_leak ~= nil then leaks[#leaks+1] = 'string metatable' end\n"
+        "if getmetatable(_G) ~= nil then leaks[#leaks+1] = 'global metatable' end\n"
+        "return #leaks == 0 and 'clean' or table.concat(leaks, ',')\n";
+
+    LuaEngine* engine = new LuaEngine(NULL);
+
+    // a fresh engine is clean
+    if(writeScript(path, check_script)) runScript(engine, path, "clean");
+
+    // dirty the engine then check that recycling cleaned it
+    if(writeScript(path, dirty_script)) runScript(engine, path, "dirty");
+    if(writeScript(path, check_script)) runScript(engine, path, "clean");
+
+    // a second round restores from the same snapshot
+    if(writeScript(path, dirty_script)) runScript(engine, path, "dirty");
+    if(writeScript(path, check_script)) runScript(engine, path, "clean");
+
+    delete engine;
+    remove(path);
+
+    // return success or failure
+    return failures == 0 ? 0 : -1;
+}
+
+/*--------------------------------------------------------------------------------------
+ * testChunkCache
+ *
+ *  scripts are loaded from the compiled chunk cache until the modification time
+ *  or size of the script changes
+ *--------------------------------------------------------------------------------------*/
+int UT_LuaEngine::testChunkCache(int argc, char argv[][MAX_CMD_SIZE])
+{
+    (void)argc;
+
+    failures = 0;
+
+    const char* path = argv[0];
+    time_t mtime = time(NULL) - 60;
+
+    LuaEngine* engine = new LuaEngine(NULL);
+
+    // first load compiles the script
+    if(writeScript(path, "return 'one'\n", mtime)) runScript(engine, path, "one");
+
+    // same size and modification time is a cache hit, even though the contents changed
+    if(writeScript(path, "return 'two'\n", mtime)) runScript(engine, path, "one");
+
+    // a new modification time invalidates the cached chunk
+    if(writeScript(path, "return 'two'\n", mtime + 10)) runScript(engine, path, "two");
+
+    // a new size invalidates the cached chunk
+    if(writeScript(path, "return 'three'\n", mtime + 10)) runScript(engine, path, "three");
+
+    delete engine;
+    remove(path);
+
+    // return success or failure
+    return failures == 0 ? 0 : -1;
+}
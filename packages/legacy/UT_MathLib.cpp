@@ -0,0 +1,246 @@
+/*
+ * Copyright (c) 2021, University of Washington
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the University of Washington nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE UNIVERSITY OF WASHINGTON AND CONTRIBUTORS
+ * “AS IS” AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE UNIVERSITY OF WASHINGTON OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+
+#include <stdlib.h>
+#include "UT_MathLib.h"
+#include "core.h"
+
+/******************************************************************************
+ * MACROS
+ ******************************************************************************/
+
+#define ut_assert(e,...)    UT_MathLib::_ut_assert(e,__FILE__,__LINE__,__VA_ARGS__)
+
+/******************************************************************************
+ * STATIC DATA
+ ******************************************************************************/
+
+const char* UT_MathLib::TYPE = "UT_MathLib";
+
+/******************************************************************************
+ * PUBLIC METHODS
+ ******************************************************************************/
+
+/*----------------------------------------------------------------------------
+ * createObject  -
+ *----------------------------------------------------------------------------*/
+CommandableObject* UT_MathLib::createObject(CommandProcessor* cmd_proc, const char* name, int argc, char argv[][MAX_CMD_SIZE])
+{
+    (void)argc;
+    (void)argv;
+
+    /* Create MathLib Unit Test */
+    return new UT_MathLib(cmd_proc, name);
+}
+
+/*----------------------------------------------------------------------------
+ * Constructor  -
+ *----------------------------------------------------------------------------*/
+UT_MathLib::UT_MathLib(CommandProcessor* cmd_proc, const char* obj_name):
+    CommandableObject(cmd_proc, obj_name, TYPE),
+    failures(0)
+{
+    /* Register Commands */
+    registerCommand("INPOLY", (cmdFunc_t)&UT_MathLib::testInpoly, 0, "");
+}
+
+/*----------------------------------------------------------------------------
+ * Destructor  -
+ *----------------------------------------------------------------------------*/
+UT_MathLib::~UT_MathLib(void)
+{
+}
+
+/*--------------------------------------------------------------------------------------
+ * _ut_assert - called via ut_assert macro
+ *--------------------------------------------------------------------------------------*/
+bool UT_MathLib::_ut_assert(bool e, const char* file, int line, const char* fmt, ...)
+{
+    if(!e)
+    {
+        char formatted_string[UT_MAX_ASSERT];
+        char log_message[UT_MAX_ASSERT];
+        va_list args;
+        int vlen, msglen;
+        char* pathptr;
+
+        /* Build Formatted String */
+        va_start(args, fmt);
+        vlen = vsnprintf(formatted_string, UT_MAX_ASSERT - 1, fmt, args);
+        msglen = vlen < UT_MAX_ASSERT - 1 ? vlen : UT_MAX_ASSERT - 1;
+        va_end(args);
+        if (msglen < 0) formatted_string[0] = '\0';
+        else            formatted_string[msglen] = '\0';
+
+        /* Chop Path in Filename */
+        pathptr = StringLib::find(file, '/', false);
+        if(pathptr) pathptr++;
+        else pathptr = (char*)file;
+
+        /* Create Log Message */
+        msglen = snprintf(log_message, UT_MAX_ASSERT, "Failure at %s:%d:%s", pathptr, line, formatted_string);
+        if(msglen > (UT_MAX_ASSERT - 1))
+        {
+            log_message[UT_MAX_ASSERT - 1] = '#';
+        }
+
+        /* Display Log Message */
+        print2term("%s", log_message);
+
+        /* Count Error */
+        failures++;
+    }
+
+    return e;
+}
+
+/*--------------------------------------------------------------------------------------
+ * checkInpoly
+ *
+ *  tests every point with the bulk inpoly against an index of the rings and
+ *  with the scalar inpoly against each ring (combined with the even-odd rule),
+ *  and returns the number of points where the two disagree
+ *--------------------------------------------------------------------------------------*/
+long UT_MathLib::checkInpoly(MathLib::point_t** rings, int* lens, int num_rings, const MathLib::point_t* points, long n)
+{
+    MathLib::PolyIndex index(rings, lens, num_rings);
+    bool* inclusion = new bool [n];
+    MathLib::inpoly(index, points, n, inclusion);
+
+    long mismatches = 0;
+    for(long k = 0; k < n; k++)
+    {
+        bool expected = false;
+        for(int r = 0; r < num_rings; r++)
+        {
+            if(MathLib::inpoly(rings[r], lens[r], points[k])) expected = !expected;
+        }
+
+        if(!ut_assert(inclusion[k] == expected, "Bulk inpoly mismatch at (%lf, %lf): %d != %d", points[k].x, points[k].y, inclusion[k], expected))
+        {
+            mismatches++;
+        }
+    }
+
+    delete [] inclusion;
+    return mismatches;
+}
+
+/*--------------------------------------------------------------------------------------
+ * testInpoly
+ *--------------------------------------------------------------------------------------*/
+int UT_MathLib::testInpoly(int argc, char argv[][MAX_CMD_SIZE])
+{
+    (void)argc;
+    (void)argv;
+
+    failures = 0;
+
+    // concave outer ring (with a horizontal edge) and a square hole
+    MathLib::point_t outer[] = { {0.0, 0.0}, {10.0, 0.0}, {10.0, 10.0}, {5.0, 5.0}, {0.0, 10.0} };
+    MathLib::point_t hole[] = { {2.0, 1.0}, {4.0, 1.0}, {4.0, 3.0}, {2.0, 3.0} };
+    MathLib::point_t* rings[2] = { outer, hole };
+    int lens[2] = { 5, 4 };
+
+    // build test points
+    const long max_points = 4096;
+    MathLib::point_t* points = new MathLib::point_t [max_points];
+    long n = 0;
+    for(int r = 0; r < 2; r++)
+    {
+        // vertices and points along edges
+        for(int i = 0, j = lens[r] - 1; i < lens[r]; j = i++)
+        {
+            for(int q = 0; q < 4; q++)
+            {
+                points[n].x = ((rings[r][i].x * (4 - q)) + (rings[r][j].x * q)) / 4.0;
+                points[n].y = ((rings[r][i].y * (4 - q)) + (rings[r][j].y * q)) / 4.0;
+                n++;
+            }
+        }
+    }
+    for(double y = -1.0; y <= 11.0; y += 0.5)
+    {
+        // grid that lands on vertices, edges, and the bounding box
+        for(double x = -1.0; x <= 11.0; x += 0.5)
+        {
+            points[n].x = x;
+            points[n].y = y;
+            n++;
+        }
+    }
+    uint64_t seed = 0x5eed;
+    while(n < max_points)
+    {
+        // pseudo-random points in and around the polygon
+        seed = (seed * 6364136223846793005ULL) + 1442695040888963407ULL;
+        points[n].x = -2.0 + (14.0 * ((seed >> 11) & 0xFFFFF) / (double)0xFFFFF);
+        points[n].y = -2.0 + (14.0 * ((seed >> 31) & 0xFFFFF) / (double)0xFFFFF);
+        n++;
+    }
+
+    // 1) Single Ring
+    ut_assert(checkInpoly(rings, lens, 1, points, n) == 0, "Failed single ring comparison");
+
+    // 2) Ring with Hole
+    ut_assert(checkInpoly(rings, lens, 2, points, n) == 0, "Failed ring with hole comparison");
+
+    // 3) Expected Inclusion
+    MathLib::PolyIndex index(rings, lens, 2);
+    ut_assert(index.includes({1.0, 5.0}), "Failed to include point inside polygon");
+    ut_assert(!index.includes({5.0, 8.0}), "Failed to exclude point in concave notch");
+    ut_assert(!index.includes({3.0, 2.0}), "Failed to exclude point inside hole");
+    ut_assert(!index.includes({11.0, 5.0}), "Failed to exclude point outside polygon");
+
+    // 4) Bulk Projection
+    const MathLib::proj_t projections[3] = { MathLib::NORTH_POLAR, MathLib::SOUTH_POLAR, MathLib::PLATE_CARREE };
+    double lon[3] = { -120.5, 0.0, 45.25 };
+    double lat[3] = { 75.0, -80.5, 39.0 };
+    for(int p = 0; p < 3; p++)
+    {
+        MathLib::point_t projected[3];
+        MathLib::coord2point(lon, lat, 3, projections[p], projected);
+        for(int k = 0; k < 3; k++)
+        {
+            MathLib::point_t expected = MathLib::coord2point({lon[k], lat[k]}, projections[p]);
+            ut_assert(projected[k].x == expected.x && projected[k].y == expected.y, "Bulk projection %d mismatch at %d", p, k);
+        }
+    }
+
+    delete [] points;
+
+    // return success or failure
+    return failures == 0 ? 0 : -1;
+}
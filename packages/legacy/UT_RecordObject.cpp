@@ -0,0 +1,252 @@
+/*
+ * Copyright (c) 2021, University of Washington
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the University of Washington nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE UNIVERSITY OF WASHINGTON AND CONTRIBUTORS
+ * “AS IS” AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE UNIVERSITY OF WASHINGTON OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+
+#include <stdlib.h>
+#include "UT_RecordObject.h"
+#include "core.h"
+
+/******************************************************************************
+ * MACROS
+ ******************************************************************************/
+
+#define ut_assert(e,...)    UT_RecordObject::_ut_assert(e,__FILE__,__LINE__,__VA_ARGS__)
+
+/******************************************************************************
+ * STATIC DATA
+ ******************************************************************************/
+
+const char* UT_RecordObject::TYPE = "UT_RecordObject";
+
+/******************************************************************************
+ * PUBLIC METHODS
+ ******************************************************************************/
+
+/*----------------------------------------------------------------------------
+ * createObject  -
+ *----------------------------------------------------------------------------*/
+CommandableObject* UT_RecordObject::createObject(CommandProcessor* cmd_proc, const char* name, int argc, char argv[][MAX_CMD_SIZE])
+{
+    (void)argc;
+    (void)argv;
+
+    /* Create Record Object Unit Test */
+    return new UT_RecordObject(cmd_proc, name);
+}
+
+/*----------------------------------------------------------------------------
+ * Constructor  -
+ *----------------------------------------------------------------------------*/
+UT_RecordObject::UT_RecordObject(CommandProcessor* cmd_proc, const char* obj_name):
+    CommandableObject(cmd_proc, obj_name, TYPE),
+    failures(0)
+{
+    /* Register Commands */
+    registerCommand("COLUMN", (cmdFunc_t)&UT_RecordObject::testColumn, 0, "");
+}
+
+/*----------------------------------------------------------------------------
+ * Destructor  -
+ *----------------------------------------------------------------------------*/
+UT_RecordObject::~UT_RecordObject(void)
+{
+}
+
+/*--------------------------------------------------------------------------------------
+ * _ut_assert - called via ut_assert macro
+ *--------------------------------------------------------------------------------------*/
+bool UT_RecordObject::_ut_assert(bool e, const char* file, int line, const char* fmt, ...)
+{
+    if(!e)
+    {
+        char formatted_string[UT_MAX_ASSERT];
+        char log_message[UT_MAX_ASSERT];
+        va_list args;
+        int vlen, msglen;
+        char* pathptr;
+
+        /* Build Formatted String */
+        va_start(args, fmt);
+        vlen = vsnprintf(formatted_string, UT_MAX_ASSERT - 1, fmt, args);
+        msglen = vlen < UT_MAX_ASSERT - 1 ? vlen : UT_MAX_ASSERT - 1;
+        va_end(args);
+        if (msglen < 0) formatted_string[0] = '\0';
+        else            formatted_string[msglen] = '\0';
+
+        /* Chop Path in Filename */
+        pathptr = StringLib::find(file, '/', false);
+        if(pathptr) pathptr++;
+        else pathptr = (char*)file;
+
+        /* Create Log Message */
+        msglen = snprintf(log_message, UT_MAX_ASSERT, "Failure at %s:%d:%s", pathptr, line, formatted_string);
+        if(msglen > (UT_MAX_ASSERT - 1))
+        {
+            log_message[UT_MAX_ASSERT - 1] = '#';
+        }
+
+        /* Display Log Message */
+        print2term("%s", log_message);
+
+        /* Count Error */
+        failures++;
+    }
+
+    return e;
+}
+
+/*--------------------------------------------------------------------------------------
+ * testColumn
+ *--------------------------------------------------------------------------------------*/
+int UT_RecordObject::testColumn(int argc, char argv[][MAX_CMD_SIZE])
+{
+    (void)argc;
+    (void)argv;
+
+    failures = 0;
+
+    // define a row with native, big endian, and bitfield fields
+    const int row_size = 24;
+    const int num_rows = 8;
+    RecordObject::fieldDef_t fields[] = {
+        {"i32",     RecordObject::INT32,    0,  1, NULL, NATIVE_FLAGS},
+        {"f32",     RecordObject::FLOAT,    4,  1, NULL, NATIVE_FLAGS},
+        {"u16",     RecordObject::UINT16,   8,  1, NULL, NATIVE_FLAGS},
+        {"be16",    RecordObject::INT16,    10, 1, NULL, NATIVE_FLAGS ^ RecordObject::BIGENDIAN},
+        {"bits",    RecordObject::BITFIELD, 96, 4, NULL, NATIVE_FLAGS},
+        {"f64",     RecordObject::DOUBLE,   16, 1, NULL, NATIVE_FLAGS}
+    };
+    RecordObject::recordDefErr_t rc = RecordObject::defineRecord("ut_column", NULL, row_size, fields, sizeof(fields) / sizeof(RecordObject::fieldDef_t), 16);
+    if(!ut_assert(rc == RecordObject::SUCCESS_DEF || rc == RecordObject::DUPLICATE_DEF, "Failed to define record: %d", rc)) return -1;
+
+    // populate a batch of rows
+    RecordObject record("ut_column", row_size * num_rows);
+    RecordObject::field_t i32 = record.getField("i32");
+    RecordObject::field_t f32 = record.getField("f32");
+    RecordObject::field_t u16 = record.getField("u16");
+    RecordObject::field_t be16 = record.getField("be16");
+    RecordObject::field_t bits = record.getField("bits");
+    RecordObject::field_t f64 = record.getField("f64");
+    for(int row = 0; row < num_rows; row++)
+    {
+        RecordObject::field_t field;
+        field = i32;    field.offset += row * row_size * 8;     record.setValueInteger(field, -100 * row);
+        field = f32;    field.offset += row * row_size * 8;     record.setValueReal(field, row + 0.75);
+        field = u16;    field.offset += row * row_size * 8;     record.setValueInteger(field, 60000 + row);
+        field = be16;   field.offset += row * row_size * 8;     record.setValueInteger(field, -300 * row);
+        field = bits;   field.offset += row * row_size * 8;     record.setValueInteger(field, row);
+        field = f64;    field.offset += row * row_size * 8;     record.setValueReal(field, row * 1.5);
+    }
+
+    // 1) Matching Types
+    int32_t i32_values[num_rows];
+    double f64_values[num_rows];
+    record.getValueColumn(i32, row_size, num_rows, i32_values);
+    record.getValueColumn(f64, row_size, num_rows, f64_values);
+    for(int row = 0; row < num_rows; row++)
+    {
+        ut_assert(i32_values[row] == -100 * row, "Failed int32 column at row %d: %d", row, i32_values[row]);
+        ut_assert(f64_values[row] == row * 1.5, "Failed double column at row %d: %lf", row, f64_values[row]);
+    }
+
+    // 2) Type Mismatches (converted like the element accessors)
+    int32_t f32_as_int[num_rows];
+    double i32_as_double[num_rows];
+    uint8_t u16_as_byte[num_rows];
+    record.getValueColumn(f32, row_size, num_rows, f32_as_int);
+    record.getValueColumn(i32, row_size, num_rows, i32_as_double);
+    record.getValueColumn(u16, row_size, num_rows, u16_as_byte);
+    for(int row = 0; row < num_rows; row++)
+    {
+        ut_assert(f32_as_int[row] == row, "Failed float to int32 column at row %d: %d", row, f32_as_int[row]);
+        ut_assert(i32_as_double[row] == -100.0 * row, "Failed int32 to double column at row %d: %lf", row, i32_as_double[row]);
+        ut_assert(u16_as_byte[row] == (uint8_t)(60000 + row), "Failed uint16 to uint8 column at row %d: %d", row, u16_as_byte[row]);
+    }
+
+    // 3) Element Accessor Fields (big endian and bitfield, same values as the element accessors)
+    int64_t be16_values[num_rows];
+    int16_t bits_values[num_rows];
+    record.getValueColumn(be16, row_size, num_rows, be16_values);
+    record.getValueColumn(bits, row_size, num_rows, bits_values);
+    for(int row = 0; row < num_rows; row++)
+    {
+        RecordObject::field_t field;
+        field = be16;   field.offset += row * row_size * 8;
+        ut_assert(be16_values[row] == record.getValueInteger(field), "Failed big endian column at row %d: %ld", row, (long)be16_values[row]);
+        field = bits;   field.offset += row * row_size * 8;
+        ut_assert(bits_values[row] == (int16_t)record.getValueInteger(field), "Failed bitfield column at row %d: %d", row, bits_values[row]);
+    }
+
+    // 4) Zero Stride
+    double repeated[num_rows];
+    RecordObject::field_t last_f64 = f64;
+    last_f64.offset += (num_rows - 1) * row_size * 8;
+    record.getValueColumn(last_f64, 0, num_rows, repeated);
+    for(int row = 0; row < num_rows; row++)
+    {
+        ut_assert(repeated[row] == (num_rows - 1) * 1.5, "Failed zero stride column at row %d: %lf", row, repeated[row]);
+    }
+
+    // 5) Bounds Check (one row past the end of the batch)
+    double overflow[num_rows + 1];
+    RecordObject::field_t fields_to_check[3] = { f64, be16, bits };
+    for(int i = 0; i < 3; i++)
+    {
+        bool caught = false;
+        try
+        {
+            record.getValueColumn(fields_to_check[i], row_size, num_rows + 1, overflow);
+        }
+        catch(const RunTimeException&)
+        {
+            caught = true;
+        }
+        ut_assert(caught, "Failed to catch out of range column for field %d", i);
+    }
+
+    // 6) Invalid Stride
+    bool caught = false;
+    try
+    {
+        record.getValueColumn(f64, -row_size, num_rows, overflow);
+    }
+    catch(const RunTimeException&)
+    {
+        caught = true;
+    }
+    ut_assert(caught, "Failed to catch negative column stride");
+
+    // return success or failure
+    return failures == 0 ? 0 : -1;
+}
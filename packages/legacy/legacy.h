@@ -53,9 +53,13 @@
 #include "LuaLibraryCmd.h"
 #include "StatisticRecord.h"
 #include "UT_Dictionary.h"
+#include "UT_EventLib.h"
 #include "UT_List.h"
+#include "UT_LuaEngine.h"
+#include "UT_MathLib.h"
 #include "UT_MsgQ.h"
 #include "UT_Ordering.h"
+#include "UT_RecordObject.h"
 #include "UT_Table.h"
 #include "UT_TimeLib.h"
 #include "UT_String.h"
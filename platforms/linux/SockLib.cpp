@@ -50,6 +50,7 @@
 #include <netdb.h>
 #include <sys/types.h>
 #include <sys/socket.h>
+#include <sys/uio.h>
 #include <sys/time.h>
 #include <ctype.h>
 #include <fcntl.h>
@@ -307,6 +308,79 @@ int SockLib::socksend(int fd, const void* buf, int size, int timeout)
     return c;
 }
 
+/*----------------------------------------------------------------------------
+ * socksendv
+ *
+ *  sends count buffers in a single call, as if they were one contiguous
+ *  buffer; returns the number of bytes sent, which can be less than the total
+ *----------------------------------------------------------------------------*/
+int SockLib::socksendv(int fd, const void* const bufs[], const int sizes[], int count, int timeout)
+{
+    int revents = POLLOUT;
+    int c = TIMEOUT_RC;
+
+    /* Check Sock */
+    if(fd == INVALID_RC || count <= 0 || count > IOV_MAX)
+    {
+        if(timeout != IO_CHECK) OsApi::performIOTimeout();
+        return TIMEOUT_RC;
+    }
+
+    if(timeout != IO_CHECK)
+    {
+        int activity = 1;
+
+        /* Build Poll Structure */
+        struct pollfd polllist[1];
+        polllist[0].fd = fd;
+        polllist[0].events = POLLOUT | POLLHUP;
+        polllist[0].revents = 0;
+
+        /* Poll */
+        do activity = poll(polllist, 1, timeout);
+        while(activity == -1 && (errno == EINTR || errno == EAGAIN));
+
+        /* Set Activity */
+        if(activity > 0)    revents = polllist[0].revents;
+        else                revents = 0;
+    }
+
+    /* Perform Send */
+    if(revents & POLLHUP)
+    {
+        c = SHUTDOWN_RC;
+    }
+    else if(revents & POLLOUT)
+    {
+        /* Build Message */
+        struct iovec iov[IOV_MAX];
+        for(int i = 0; i < count; i++)
+        {
+            iov[i].iov_base = const_cast<void*>(bufs[i]);
+            iov[i].iov_len = sizes[i];
+        }
+        struct msghdr msg;
+        memset(&msg, 0, sizeof(msg));
+        msg.msg_iov = iov;
+        msg.msg_iovlen = count;
+
+        /* Send Message */
+        c = sendmsg(fd, &msg, MSG_DONTWAIT | MSG_NOSIGNAL);
+        if(c == 0)
+        {
+            c = SHUTDOWN_RC;
+        }
+        else if(timeout != IO_CHECK && c < 0)
+        {
+            dlog("Failed (%d) to send data to ready socket [0x%0X]: %s", c, revents, strerror(errno));
+            c = SOCK_ERR_RC;
+        }
+    }
+
+    /* Return Results */
+    return c;
+}
+
 /*----------------------------------------------------------------------------
  * sockrecv
  *----------------------------------------------------------------------------*/
@@ -56,6 +56,7 @@ class SockLib
         static int          sockstream          (const char* ip_addr, int port, bool is_server, bool* block);
         static int          sockdatagram        (const char* ip_addr, int port, bool is_server, bool* block, const char* multicast_group);
         static int          socksend            (int fd, const void* buf, int size, int timeout);
+        static int          socksendv           (int fd, const void* const bufs[], const int sizes[], int count, int timeout);
         static int          sockrecv            (int fd, void* buf, int size, int timeout);
         static int          sockinfo            (int fd, char** local_ipaddr, int* local_port, char** remote_ipaddr, int* remote_port);
         static void         sockclose           (int fd);
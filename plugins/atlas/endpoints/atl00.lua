@@ -19,6 +19,7 @@ local rqst = json.decode(arg[1])
 -- File Data
 --------------------------------------------------------------------------------------
 local threads = rqst["threads"] or 4
+local batch_size = math.min(math.max(math.floor(rqst["batch_size"] or 64), 0), ccsds.MAX_BATCH) -- packets posted per message, 0 posts packets individually
 local timeout_seconds = rqst["timeout"] or core.PEND
 local baseDispatcher = nil
 local ccsdsDispatcher = nil
@@ -75,7 +76,7 @@ local function createMetrics(metrictable)
     -- Create CCSDS Record Metrics --
     if metrictable["ccsds"] then
         if not ccsdsDispatcher then
-            ccsdsDispatcher = ccsds.dispatcher("scidataq", threads, player_key, key_parm):name("ccsdsDispatcher")
+            ccsdsDispatcher = ccsds.dispatcher("scidataq", threads, player_key, key_parm, batch_size > 0):name("ccsdsDispatcher")
         end
         for recname,fieldlist in pairs(metrictable["ccsds"]) do
             for _,fieldname in ipairs(fieldlist) do
@@ -150,7 +151,7 @@ local function createLimits (limittable)
     -- Create CCSDS Record Metrics --
     if limittable["ccsds"] then
         if not ccsdsDispatcher then
-            ccsdsDispatcher = ccsds.dispatcher("scidataq", threads, player_key, key_parm)
+            ccsdsDispatcher = ccsds.dispatcher("scidataq", threads, player_key, key_parm, batch_size > 0)
         end
         for i,limit in ipairs(limittable["ccsds"]) do
             local recname = limit["record"]
@@ -228,12 +229,12 @@ if source["type"] == "ATL00" then
     for index,filepath in ipairs(filelist) do
         fileq = "filedataq-"..tostring(index)
         ccsdsq = "ccsdsdataq-"..tostring(index)
-        ccsdsParsers[filepath] = ccsds.parser(ccsds.pktmod(), ccsds.SPACE, fileq, ccsdsq):name(filepath)
+        ccsdsParsers[filepath] = ccsds.parser(ccsds.pktmod(), ccsds.SPACE, fileq, ccsdsq, nil, batch_size):name(filepath)
         table.insert(ccsdsQs, ccsdsq)
         table.insert(fileQs, fileq)
     end
     -- Create Interleaver --
-    interleaver = ccsds.interleaver(ccsdsQs, "scidataq")
+    interleaver = ccsds.interleaver(ccsdsQs, "scidataq", batch_size)
     if source["start"] then
         interleaver:start(source["start"])
     end
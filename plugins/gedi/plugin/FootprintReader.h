@@ -375,13 +375,22 @@ void FootprintReader<footprint_t>::Region::polyregion (info_t* info)
     if(lat[0] > 70.0) projection = MathLib::NORTH_POLAR;
     else if(lat[0] < -70.0) projection = MathLib::SOUTH_POLAR;
 
-    /* Project Polygon */
+    /* Project and Index Polygon */
     List<MathLib::coord_t>::Iterator poly_iterator(info->reader->parms->polygon);
     MathLib::point_t* projected_poly = new MathLib::point_t [points_in_polygon];
     for(int i = 0; i < points_in_polygon; i++)
     {
         projected_poly[i] = MathLib::coord2point(poly_iterator[i], projection);
     }
+    MathLib::PolyIndex poly_index(projected_poly, points_in_polygon);
+    delete [] projected_poly;
+
+    /* Test Inclusion of Footprints */
+    MathLib::point_t* footprint_points = new MathLib::point_t [lat.size];
+    bool* footprint_inclusion = new bool [lat.size];
+    MathLib::coord2point(lon.pointer, lat.pointer, lat.size, projection, footprint_points);
+    MathLib::inpoly(poly_index, footprint_points, lat.size, footprint_inclusion);
+    delete [] footprint_points;
 
     /* Find First and Last Footprints in Polygon */
     bool first_footprint_found = false;
@@ -389,17 +398,7 @@ void FootprintReader<footprint_t>::Region::polyregion (info_t* info)
     int footprint = 0;
     while(footprint < lat.size)
     {
-        bool inclusion = false;
-
-        /* Project Segment Coordinate */
-        MathLib::coord_t footprint_coord = {lon[footprint], lat[footprint]};
-        MathLib::point_t footprint_point = MathLib::coord2point(footprint_coord, projection);
-
-        /* Test Inclusion */
-        if(MathLib::inpoly(projected_poly, points_in_polygon, footprint_point))
-        {
-            inclusion = true;
-        }
+        bool inclusion = footprint_inclusion[footprint];
 
         /* Find First Footprint */
         if(!first_footprint_found && inclusion)
@@ -425,8 +424,8 @@ void FootprintReader<footprint_t>::Region::polyregion (info_t* info)
         num_footprints = footprint - first_footprint;
     }
 
-    /* Delete Projected Polygon */
-    delete [] projected_poly;
+    /* Free Inclusion */
+    delete [] footprint_inclusion;
 }
 
 /*----------------------------------------------------------------------------
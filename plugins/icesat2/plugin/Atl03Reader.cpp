@@ -88,6 +88,8 @@ const RecordObject::fieldDef_t Atl03Reader::ancRecDef[] = {
 };
 
 const double Atl03Reader::ATL03_SEGMENT_LENGTH = 20.0; // meters
+const double Atl03Reader::Region::SEARCH_MAX_LAT = 85.0; // degrees
+const double Atl03Reader::Region::SEARCH_FILL_LAT = 90.0; // degrees
 
 const char* Atl03Reader::OBJECT_TYPE = "Atl03Reader";
 const char* Atl03Reader::LUA_META_NAME = "Atl03Reader";
@@ -338,14 +340,15 @@ Atl03Reader::~Atl03Reader (void)
  * Region::Constructor
  *----------------------------------------------------------------------------*/
 Atl03Reader::Region::Region (info_t* info):
-    segment_lat    (info->reader->asset, info->reader->resource, FString("%s/%s", info->prefix, "geolocation/reference_photon_lat").c_str(), &info->reader->context),
-    segment_lon    (info->reader->asset, info->reader->resource, FString("%s/%s", info->prefix, "geolocation/reference_photon_lon").c_str(), &info->reader->context),
-    segment_ph_cnt (info->reader->asset, info->reader->resource, FString("%s/%s", info->prefix, "geolocation/segment_ph_cnt").c_str(), &info->reader->context),
+    search         (searchregion(info)),
+    segment_ph_cnt (info->reader->asset, info->reader->resource, FString("%s/%s", info->prefix, "geolocation/segment_ph_cnt").c_str(), &info->reader->context, 0, search.first, search.count),
+    segment_lat    (info->reader->asset, info->reader->resource, FString("%s/%s", info->prefix, "geolocation/reference_photon_lat").c_str(), &info->reader->context, 0, search.first, search.count),
+    segment_lon    (info->reader->asset, info->reader->resource, FString("%s/%s", info->prefix, "geolocation/reference_photon_lon").c_str(), &info->reader->context, 0, search.first, search.count),
     inclusion_mask {NULL},
     inclusion_ptr  {NULL}
 {
     /* Process Area of Interest */
-    projected_poly = NULL;
+    poly_index = NULL;
     projection = MathLib::PLATE_CARREE;
     points_in_polygon = info->reader->parms->polygon.length();
     if(points_in_polygon > 0)
@@ -354,13 +357,15 @@ Atl03Reader::Region::Region (info_t* info):
         if(info->reader->parms->polygon[0].lat > 70.0) projection = MathLib::NORTH_POLAR;
         else if(info->reader->parms->polygon[0].lat < -70.0) projection = MathLib::SOUTH_POLAR;
 
-        /* Project Polygon */
+        /* Project and Index Polygon */
         List<MathLib::coord_t>::Iterator poly_iterator(info->reader->parms->polygon);
-        projected_poly = new MathLib::point_t [points_in_polygon];
+        MathLib::point_t* projected_poly = new MathLib::point_t [points_in_polygon];
         for(int i = 0; i < points_in_polygon; i++)
         {
             projected_poly[i] = MathLib::coord2point(poly_iterator[i], projection);
         }
+        poly_index = new MathLib::PolyIndex(projected_poly, points_in_polygon);
+        delete [] projected_poly;
     }
 
     try
@@ -383,7 +388,7 @@ Atl03Reader::Region::Region (info_t* info):
         }
         else if(points_in_polygon > 0)
         {
-            polyregion();
+            polyregion(info);
         }
         else
         {
@@ -397,9 +402,9 @@ Atl03Reader::Region::Region (info_t* info):
         }
 
         /* Trim Geospatial Extent Datasets Read from HDF5 File */
-        segment_lat.trim(first_segment);
-        segment_lon.trim(first_segment);
-        segment_ph_cnt.trim(first_segment);
+        segment_lat.trim(first_segment - search.first);
+        segment_lon.trim(first_segment - search.first);
+        segment_ph_cnt.trim(first_segment - search.first);
     }
     catch(const RunTimeException& e)
     {
@@ -422,10 +427,10 @@ Atl03Reader::Region::~Region (void)
  *----------------------------------------------------------------------------*/
 void Atl03Reader::Region::cleanup (void)
 {
-    if(projected_poly)
+    if(poly_index)
     {
-        delete [] projected_poly;
-        projected_poly = NULL;
+        delete poly_index;
+        poly_index = NULL;
     }
     
     if(inclusion_mask)
@@ -436,26 +441,168 @@ void Atl03Reader::Region::cleanup (void)
 }
 
 /*----------------------------------------------------------------------------
- * Region::polyregion
+ * Region::searchregion
+ *
+ *  coarse search for the rows of the segment coordinates that can be inside
+ *  the polygon, so that only those rows need to be read and tested; evenly
+ *  spaced latitudes are read one row at a time and narrow the rows to those
+ *  that bracket the latitude extent of the polygon, which relies on the
+ *  latitude being monotonic along the track; samples holding fill values are
+ *  skipped, and when the rest show otherwise (or come near the turning point
+ *  of the orbit) all rows are used
  *----------------------------------------------------------------------------*/
-void Atl03Reader::Region::polyregion (void)
+Atl03Reader::Region::rows_t Atl03Reader::Region::searchregion (info_t* info)
 {
-    /* Find First Segment In Polygon */
-    bool first_segment_found = false;
-    int segment = 0;
-    while(segment < segment_ph_cnt.size)
+    rows_t rows = {0, H5Coro::ALL_ROWS};
+
+    /* Check for Polygon */
+    if(info->reader->parms->raster != NULL || info->reader->parms->polygon.length() <= 0)
+    {
+        return rows;
+    }
+
+    /* Get Latitude Extent of Polygon */
+    List<MathLib::coord_t>::Iterator poly_iterator(info->reader->parms->polygon);
+    double min_lat = poly_iterator[0].lat;
+    double max_lat = poly_iterator[0].lat;
+    for(int i = 1; i < poly_iterator.length; i++)
     {
-        bool inclusion = false;
+        min_lat = MIN(min_lat, poly_iterator[i].lat);
+        max_lat = MAX(max_lat, poly_iterator[i].lat);
+    }
+
+    /* Get Number of Segments (metadata only) */
+    FString lat_name("%s/%s", info->prefix, "geolocation/reference_photon_lat");
+    FString ph_cnt_name("%s/%s", info->prefix, "geolocation/segment_ph_cnt");
+    H5Coro::info_t lat_info = H5Coro::read(info->reader->asset, info->reader->resource, lat_name.c_str(), RecordObject::DYNAMIC, 0, 0, H5Coro::ALL_ROWS, &info->reader->context, true);
+    H5Coro::info_t ph_cnt_info = H5Coro::read(info->reader->asset, info->reader->resource, ph_cnt_name.c_str(), RecordObject::DYNAMIC, 0, 0, H5Coro::ALL_ROWS, &info->reader->context, true);
+    long num_rows = MIN(lat_info.numrows, ph_cnt_info.numrows);
+    long first_row = 0;
+    long last_row = num_rows - 1;
+
+    /* Narrow Rows */
+    while((last_row - first_row) > SEARCH_MIN_ROWS)
+    {
+        /* Read Sampled Latitudes */
+        H5Array<double>* samples[SEARCH_SAMPLES + 1];
+        long sample_rows[SEARCH_SAMPLES + 1];
+        for(int i = 0; i <= SEARCH_SAMPLES; i++)
+        {
+            sample_rows[i] = first_row + (((last_row - first_row) * i) / SEARCH_SAMPLES);
+            samples[i] = new H5Array<double>(info->reader->asset, info->reader->resource, lat_name.c_str(), &info->reader->context, 0, sample_rows[i], 1);
+        }
+
+        /* Keep Samples that are not Fill Values */
+        long valid_rows[SEARCH_SAMPLES + 1];
+        double valid_lats[SEARCH_SAMPLES + 1];
+        int num_valid = 0;
+        bool valid = true;
+        for(int i = 0; i <= SEARCH_SAMPLES; i++)
+        {
+            if(samples[i]->join(info->reader->read_timeout_ms, false) && samples[i]->size > 0)
+            {
+                double lat = (*samples[i])[0];
+                if(fabs(lat) <= SEARCH_FILL_LAT)
+                {
+                    valid_rows[num_valid] = sample_rows[i];
+                    valid_lats[num_valid] = lat;
+                    valid = valid && (fabs(lat) < SEARCH_MAX_LAT);
+                    num_valid++;
+                }
+            }
+            else
+            {
+                valid = false; // failures are reported by the read of the candidate rows
+            }
+            delete samples[i];
+        }
+
+        /* Check Latitudes are Monotonic */
+        valid = valid && (num_valid >= 2);
+        double direction = (valid && valid_lats[num_valid - 1] >= valid_lats[0]) ? 1.0 : -1.0;
+        for(int i = 1; valid && i < num_valid; i++)
+        {
+            valid = ((valid_lats[i] - valid_lats[i - 1]) * direction) >= 0.0;
+        }
+        if(!valid)
+        {
+            return rows;
+        }
 
-        /* Project Segment Coordinate */
-        MathLib::coord_t segment_coord = {segment_lon[segment], segment_lat[segment]};
-        MathLib::point_t segment_point = MathLib::coord2point(segment_coord, projection);
+        /* Bracket Polygon with Samples */
+        long new_first_row = first_row;
+        long new_last_row = last_row;
+        for(int i = 0; i < num_valid; i++)
+        {
+            bool before = (direction > 0.0) ? (valid_lats[i] < min_lat) : (valid_lats[i] > max_lat);
+            bool after = (direction > 0.0) ? (valid_lats[i] > max_lat) : (valid_lats[i] < min_lat);
+            if(before) new_first_row = valid_rows[i];
+            if(after && new_last_row == last_row) new_last_row = valid_rows[i];
+        }
 
-        /* Test Inclusion */
-        if(MathLib::inpoly(projected_poly, points_in_polygon, segment_point))
+        /* Check Progress */
+        if(new_first_row == first_row && new_last_row == last_row)
+        {
+            break;
+        }
+        first_row = new_first_row;
+        last_row = new_last_row;
+    }
+
+    /* Return Candidate Rows (if narrowed) */
+    if(first_row == 0 && last_row == num_rows - 1)
+    {
+        return rows;
+    }
+    rows.first = first_row;
+    rows.count = last_row - first_row + 1;
+    return rows;
+}
+
+/*----------------------------------------------------------------------------
+ * Region::polyregion
+ *
+ *  only the candidate rows found by the search are read and tested; the
+ *  photons in the segments before them are located with the photon index
+ *  of the first candidate segment that has photons
+ *----------------------------------------------------------------------------*/
+void Atl03Reader::Region::polyregion (info_t* info)
+{
+    /* Test Inclusion of Candidate Segments */
+    long num_candidates = MIN(segment_ph_cnt.size, MIN(segment_lat.size, segment_lon.size));
+    MathLib::point_t* segment_points = new MathLib::point_t [num_candidates];
+    bool* segment_inclusion = new bool [num_candidates];
+    MathLib::coord2point(segment_lon.pointer, segment_lat.pointer, num_candidates, projection, segment_points);
+    MathLib::inpoly(*poly_index, segment_points, num_candidates, segment_inclusion);
+    delete [] segment_points;
+
+    /* Skip Photons Before Candidate Rows */
+    if(search.first > 0)
+    {
+        long segment = 0;
+        while(segment < num_candidates && segment_ph_cnt[segment] == 0) segment++;
+        if(segment < num_candidates)
         {
-            inclusion = true;
+            try
+            {
+                H5Array<int64_t> ph_index_beg(info->reader->asset, info->reader->resource, FString("%s/%s", info->prefix, "geolocation/ph_index_beg").c_str(), &info->reader->context, 0, search.first + segment, 1);
+                ph_index_beg.join(info->reader->read_timeout_ms, true);
+                first_photon = ph_index_beg[0] - 1; // one based
+            }
+            catch(const RunTimeException&)
+            {
+                delete [] segment_inclusion;
+                throw;
+            }
         }
+    }
+
+    /* Find First Segment In Polygon */
+    bool first_segment_found = false;
+    long segment = 0;
+    while(segment < num_candidates)
+    {
+        bool inclusion = segment_inclusion[segment];
 
         /* Check First Segment */
         if(!first_segment_found)
@@ -465,7 +612,7 @@ void Atl03Reader::Region::polyregion (void)
             {
                 /* Set First Segment */
                 first_segment_found = true;
-                first_segment = segment;
+                first_segment = search.first + segment;
 
                 /* Include Photons From First Segment */
                 num_photons = segment_ph_cnt[segment];
@@ -495,8 +642,11 @@ void Atl03Reader::Region::polyregion (void)
     /* Set Number of Segments */
     if(first_segment_found)
     {
-        num_segments = segment - first_segment;
+        num_segments = search.first + segment - first_segment;
     }
+
+    /* Free Inclusion */
+    delete [] segment_inclusion;
 }
 
 /*----------------------------------------------------------------------------
@@ -1225,6 +1375,10 @@ Atl03Reader::TrackState::TrackState (const Atl03Data& atl03)
     start_seg_portion  = 0.0;
     track_complete     = false;
     bckgrd_in          = 0;
+    extent_record      = NULL;
+    extent             = NULL;
+    extent_capacity    = INITIAL_EXTENT_CAPACITY;
+    extent_expected    = 0;
     extent_segment     = 0;
     extent_valid       = true;
     extent_length      = 0.0;
@@ -1235,6 +1389,71 @@ Atl03Reader::TrackState::TrackState (const Atl03Data& atl03)
  *----------------------------------------------------------------------------*/
 Atl03Reader::TrackState::~TrackState (void)
 {
+    delete extent_record;
+}
+
+/*----------------------------------------------------------------------------
+ * TrackState::reserveExtent
+ *
+ *  the extent record is kept across extents and only reallocated after its
+ *  memory has been handed off to the output queue; a new record is sized
+ *  from the expected extent (with headroom) rather than the largest extent
+ *  seen, since its memory travels with the posted record
+ *----------------------------------------------------------------------------*/
+void Atl03Reader::TrackState::reserveExtent (void)
+{
+    if(!extent_record)
+    {
+        extent_capacity = MAX(extent_expected + (extent_expected / 4), INITIAL_EXTENT_CAPACITY);
+        int extent_bytes = offsetof(extent_t, photons) + (sizeof(photon_t) * extent_capacity);
+        extent_record = new RecordObject(exRecType, extent_bytes, false);
+        extent = (extent_t*)extent_record->getRecordData();
+    }
+    extent->photon_count = 0;
+}
+
+/*----------------------------------------------------------------------------
+ * TrackState::addPhoton
+ *
+ *  returns the next photon slot in the extent record, doubling the record when
+ *  it is full
+ *----------------------------------------------------------------------------*/
+Atl03Reader::photon_t* Atl03Reader::TrackState::addPhoton (void)
+{
+    if(extent->photon_count >= (uint32_t)extent_capacity)
+    {
+        extent_capacity *= 2;
+        int extent_bytes = offsetof(extent_t, photons) + (sizeof(photon_t) * extent_capacity);
+        RecordObject* new_record = new RecordObject(exRecType, extent_bytes, false);
+        extent_t* new_extent = (extent_t*)new_record->getRecordData();
+        memcpy(new_extent, extent, extentSize());
+        delete extent_record;
+        extent_record = new_record;
+        extent = new_extent;
+    }
+    return &extent->photons[extent->photon_count++];
+}
+
+/*----------------------------------------------------------------------------
+ * TrackState::releaseExtent
+ *
+ *  frees the extent record once its memory has been posted and folds its
+ *  photon count into the expected extent size
+ *----------------------------------------------------------------------------*/
+void Atl03Reader::TrackState::releaseExtent (void)
+{
+    extent_expected = (extent_expected + (int32_t)extent->photon_count) / 2;
+    delete extent_record;
+    extent_record = NULL;
+    extent = NULL;
+}
+
+/*----------------------------------------------------------------------------
+ * TrackState::extentSize
+ *----------------------------------------------------------------------------*/
+int Atl03Reader::TrackState::extentSize (void) const
+{
+    return offsetof(extent_t, photons) + (sizeof(photon_t) * extent->photon_count);
 }
 
 /*----------------------------------------------------------------------------
@@ -1298,7 +1517,7 @@ void* Atl03Reader::subsettingThread (void* parm)
             state.start_seg_portion = atl03.dist_ph_along[current_photon] / ATL03_SEGMENT_LENGTH;
             state.extent_segment = state.seg_in;
             state.extent_valid = true;
-            state.extent_photons.clear();
+            state.reserveExtent();
 
             /* Ancillary Extent Fields */
             if(parms->atl03_geo_fields)
@@ -1435,7 +1654,8 @@ void* Atl03Reader::subsettingThread (void* parm)
                         }
 
                         /* Add Photon to Extent */
-                        photon_t ph = {
+                        photon_t* ph = state.addPhoton();
+                        *ph = {
                             .time_ns = Icesat2Parms::deltatime2timestamp(atl03.delta_time[current_photon]),
                             .latitude = atl03.lat_ph[current_photon],
                             .longitude = atl03.lon_ph[current_photon],
@@ -1450,7 +1670,6 @@ void* Atl03Reader::subsettingThread (void* parm)
                             .quality_ph = (int8_t)quality_ph,
                             .yapc_score = yapc_score
                         };
-                        state.extent_photons.add(ph);
 
                         /* Index Photon for Ancillary Fields */
                         if(segment_indices)
@@ -1508,16 +1727,16 @@ void* Atl03Reader::subsettingThread (void* parm)
             }
 
             /* Check Photon Count */
-            if(state.extent_photons.length() < parms->minimum_photon_count)
+            if((int32_t)state.extent->photon_count < parms->minimum_photon_count)
             {
                 state.extent_valid = false;
             }
 
             /* Check Along Track Spread */
-            if(state.extent_photons.length() > 1)
+            if(state.extent->photon_count > 1)
             {
-                int32_t last = state.extent_photons.length() - 1;
-                double along_track_spread = state.extent_photons[last].x_atc - state.extent_photons[0].x_atc;
+                int32_t last = state.extent->photon_count - 1;
+                double along_track_spread = state.extent->photons[last].x_atc - state.extent->photons[0].x_atc;
                 if(along_track_spread < parms->along_track_spread)
                 {
                     state.extent_valid = false;
@@ -1535,24 +1754,29 @@ void* Atl03Reader::subsettingThread (void* parm)
                 try
                 {
                     int rec_total_size = 0;
-                    reader->generateExtentRecord(extent_id, info, state, atl03, rec_list, rec_total_size);
+                    reader->generateExtentRecord(extent_id, info, state, atl03);
                     Atl03Reader::generateAncillaryRecords(extent_id, parms->atl03_ph_fields, atl03.anc_ph_data, PHOTON_ANC_TYPE, photon_indices, rec_list, rec_total_size);
                     Atl03Reader::generateAncillaryRecords(extent_id, parms->atl03_geo_fields, atl03.anc_geo_data, EXTENT_ANC_TYPE, segment_indices, rec_list, rec_total_size);
 
                     /* Send Records */
-                    if(rec_list.size() == 1)
+                    int extent_size = state.extentSize();
+                    if(rec_list.empty())
                     {
-                        reader->postRecord(*(rec_list[0]), local_stats);
+                        /* Hand Extent Record to Output Queue */
+                        reader->postRecord(*state.extent_record, extent_size, local_stats);
+                        state.releaseExtent();
                     }
-                    else if(rec_list.size() > 1)
+                    else
                     {
-                        /* Send Container Record */
-                        ContainerRecord container(rec_list.size(), rec_total_size);
+                        /* Send Container Record (extent record is kept for next extent) */
+                        int extent_hdr_size = state.extent_record->getAllocatedMemory() - state.extent_record->getAllocatedDataSize();
+                        ContainerRecord container(rec_list.size() + 1, rec_total_size + extent_hdr_size + extent_size);
+                        container.addRecord(*state.extent_record, extent_size);
                         for(size_t i = 0; i < rec_list.size(); i++)
                         {
                             container.addRecord(*(rec_list[i]));
                         }
-                        reader->postRecord(container, local_stats);
+                        reader->postRecord(container, 0, local_stats);
                     }
                 }
                 catch(const RunTimeException& e)
@@ -1682,15 +1906,10 @@ uint32_t Atl03Reader::calculateSegmentId (const TrackState& state, const Atl03Da
 /*----------------------------------------------------------------------------
  * generateExtentRecord
  *----------------------------------------------------------------------------*/
-void Atl03Reader::generateExtentRecord (uint64_t extent_id, info_t* info, TrackState& state, const Atl03Data& atl03, vector<RecordObject*>& rec_list, int& total_size)
+void Atl03Reader::generateExtentRecord (uint64_t extent_id, info_t* info, TrackState& state, const Atl03Data& atl03)
 {
-    /* Calculate Extent Record Size */
-    int num_photons = state.extent_photons.length();
-    int extent_bytes = offsetof(extent_t, photons) + (sizeof(photon_t) * num_photons);
-
-    /* Allocate and Initialize Extent Record */
-    RecordObject* record            = new RecordObject(exRecType, extent_bytes);
-    extent_t* extent                = (extent_t*)record->getRecordData();
+    /* Initialize Extent Record (photons already populated) */
+    extent_t* extent                = state.extent;
     extent->valid                   = state.extent_valid;
     extent->extent_id               = extent_id;
     extent->track                   = info->track;
@@ -1703,7 +1922,6 @@ void Atl03Reader::generateExtentRecord (uint64_t extent_id, info_t* info, TrackS
     extent->extent_length           = state.extent_length;
     extent->background_rate         = calculateBackground(state, atl03);
     extent->solar_elevation         = atl03.solar_elevation[state.extent_segment];
-    extent->photon_count            = state.extent_photons.length();
 
     /* Calculate Spacecraft Velocity */
     int32_t sc_v_offset = state.extent_segment * 3;
@@ -1712,16 +1930,6 @@ void Atl03Reader::generateExtentRecord (uint64_t extent_id, info_t* info, TrackS
     double sc_v3 = atl03.velocity_sc[sc_v_offset + 2];
     double spacecraft_velocity = sqrt((sc_v1*sc_v1) + (sc_v2*sc_v2) + (sc_v3*sc_v3));
     extent->spacecraft_velocity  = (float)spacecraft_velocity;
-
-    /* Populate Photons */
-    for(int32_t p = 0; p < state.extent_photons.length(); p++)
-    {
-        extent->photons[p] = state.extent_photons[p];
-    }
-
-    /* Add Extent Record */
-    total_size += record->getAllocatedMemory();
-    rec_list.push_back(record);
 }
 
 /*----------------------------------------------------------------------------
@@ -1766,12 +1974,12 @@ void Atl03Reader::generateAncillaryRecords (uint64_t extent_id, Icesat2Parms::st
 /*----------------------------------------------------------------------------
  * postRecord
  *----------------------------------------------------------------------------*/
-void Atl03Reader::postRecord (RecordObject& record, stats_t& local_stats)
+void Atl03Reader::postRecord (RecordObject& record, int size, stats_t& local_stats)
 {
     uint8_t* rec_buf = NULL;
-    int rec_bytes = record.serialize(&rec_buf, RecordObject::REFERENCE);
+    int rec_bytes = record.serialize(&rec_buf, RecordObject::TAKE_OWNERSHIP, size);
     int post_status = MsgQ::STATE_TIMEOUT;
-    while(active && (post_status = outQ->postCopy(rec_buf, rec_bytes, SYS_TIMEOUT)) == MsgQ::STATE_TIMEOUT)
+    while(active && (post_status = outQ->postRef(rec_buf, rec_bytes, SYS_TIMEOUT)) == MsgQ::STATE_TIMEOUT)
     {
         local_stats.extents_retried++;
     }
@@ -1785,6 +1993,7 @@ void Atl03Reader::postRecord (RecordObject& record, stats_t& local_stats)
     {
         mlog(ERROR, "Atl03 reader failed to post %s to stream %s: %d", record.getRecordType(), outQ->getName(), post_status);
         local_stats.extents_dropped++;
+        delete [] rec_buf; // ownership was taken from the record
     }
 }
 
@@ -1939,6 +2148,19 @@ int Atl03Reader::luaStats (lua_State* L)
         LuaEngine::setAttrInt(L, "dropped",     lua_obj->stats.extents_dropped);
         LuaEngine::setAttrInt(L, "retried",     lua_obj->stats.extents_retried);
 
+        /* Add H5Coro I/O Cache Statistics (ATL03 and ATL08 files) */
+        H5Coro::context_t& c03 = lua_obj->context;
+        H5Coro::context_t& c08 = lua_obj->context08;
+        LuaEngine::setAttrInt(L, "cache_hit",   c03.cache_hit + c08.cache_hit);
+        LuaEngine::setAttrInt(L, "cache_miss",  c03.cache_miss + c08.cache_miss);
+        LuaEngine::setAttrInt(L, "cache_evict", c03.l1_cache_replace + c03.l2_cache_replace + c08.l1_cache_replace + c08.l2_cache_replace);
+        LuaEngine::setAttrInt(L, "cache_bytes", c03.cached() + c08.cached());
+        LuaEngine::setAttrInt(L, "bytes_read",  c03.bytes_read + c08.bytes_read);
+        LuaEngine::setAttrInt(L, "pipeline_chunks", c03.pipeline_chunks + c08.pipeline_chunks);
+        LuaEngine::setAttrInt(L, "pipeline_peak", MAX(c03.pipeline_peak.load(), c08.pipeline_peak.load()));
+        LuaEngine::setAttrInt(L, "chunk_index_hit", c03.chunk_index_hit + c08.chunk_index_hit);
+        LuaEngine::setAttrInt(L, "chunk_index_miss", c03.chunk_index_miss + c08.chunk_index_miss);
+
         /* Clear if Requested */
         if(with_clear) memset(&lua_obj->stats, 0, sizeof(lua_obj->stats));
 
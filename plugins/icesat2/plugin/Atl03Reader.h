@@ -171,18 +171,30 @@ class Atl03Reader: public LuaObject
         {
             public:
 
+                static const int    SEARCH_SAMPLES = 16; // latitudes sampled per pass of the coarse search
+                static const long   SEARCH_MIN_ROWS = 16000; // coarse search stops once the candidate rows fit
+                static const double SEARCH_MAX_LAT; // coarse search is not used when the track nears its turning point
+                static const double SEARCH_FILL_LAT; // sampled latitudes beyond this are fill values
+
+                typedef struct {
+                    long            first;
+                    long            count;
+                } rows_t;
+
                 explicit Region     (info_t* info);
                 ~Region             (void);
 
                 void cleanup        (void);
-                void polyregion     (void);
+                rows_t searchregion (info_t* info);
+                void polyregion     (info_t* info);
                 void rasterregion   (info_t* info);
 
+                rows_t              search; // candidate rows read into the segment datasets below
+                H5Array<int32_t>    segment_ph_cnt;
                 H5Array<double>     segment_lat;
                 H5Array<double>     segment_lon;
-                H5Array<int32_t>    segment_ph_cnt;
 
-                MathLib::point_t*   projected_poly;
+                MathLib::PolyIndex* poly_index;
                 MathLib::proj_t     projection;
                 int                 points_in_polygon;
 
@@ -293,13 +305,21 @@ class Atl03Reader: public LuaObject
                 double          start_seg_portion;  // portion of segment extent is starting from
                 bool            track_complete;     // flag when track processing has finished
                 int32_t         bckgrd_in;          // bckgrd index
-                List<photon_t>  extent_photons;     // list of individual photons in extent
+                RecordObject*   extent_record;      // extent record photons are written directly into
+                extent_t*       extent;             // record data of extent_record
+                int32_t         extent_capacity;    // number of photons extent_record can hold
+                int32_t         extent_expected;    // running average of photons in posted extents
                 int32_t         extent_segment;     // current segment extent is pulling photons from
                 bool            extent_valid;       // flag for validity of extent (atl06 checks)
                 double          extent_length;      // custom length of the extent (in meters)
 
                 explicit TrackState (const Atl03Data& atl03);
                 ~TrackState         (void);
+
+                void        reserveExtent   (void);
+                void        releaseExtent   (void);
+                photon_t*   addPhoton       (void);
+                int         extentSize      (void) const;
         };
 
         /*--------------------------------------------------------------------
@@ -307,6 +327,7 @@ class Atl03Reader: public LuaObject
          *--------------------------------------------------------------------*/
 
         static const double ATL03_SEGMENT_LENGTH;
+        static const int32_t INITIAL_EXTENT_CAPACITY = 256; // photons reserved in a new extent record
 
         /*--------------------------------------------------------------------
          * Data
@@ -344,9 +365,9 @@ class Atl03Reader: public LuaObject
 
         static double       calculateBackground         (TrackState& state, const Atl03Data& atl03);
         uint32_t            calculateSegmentId          (const TrackState& state, const Atl03Data& atl03);
-        void                generateExtentRecord        (uint64_t extent_id, info_t* info, TrackState& state, const Atl03Data& atl03, vector<RecordObject*>& rec_list, int& total_size);
+        void                generateExtentRecord        (uint64_t extent_id, info_t* info, TrackState& state, const Atl03Data& atl03);
         static void         generateAncillaryRecords    (uint64_t extent_id, Icesat2Parms::string_list_t* field_list, H5DArrayDictionary& field_dict, anc_type_t type,  List<int32_t>* indices, vector<RecordObject*>& rec_list, int& total_size);
-        void                postRecord                  (RecordObject& record, stats_t& local_stats);
+        void                postRecord                  (RecordObject& record, int size, stats_t& local_stats);
         static void         parseResource               (const char* resource, int32_t& rgt, int32_t& cycle, int32_t& region);
 
         static int          luaParms                    (lua_State* L);
@@ -263,7 +263,7 @@ Atl06Reader::Region::Region (info_t* info):
     inclusion_ptr   {NULL}
 {
     /* Process Area of Interest */
-    projected_poly = NULL;
+    poly_index = NULL;
     projection = MathLib::PLATE_CARREE;
     points_in_polygon = info->reader->parms->polygon.length();
     if(points_in_polygon > 0)
@@ -272,13 +272,15 @@ Atl06Reader::Region::Region (info_t* info):
         if(info->reader->parms->polygon[0].lat > 70.0) projection = MathLib::NORTH_POLAR;
         else if(info->reader->parms->polygon[0].lat < -70.0) projection = MathLib::SOUTH_POLAR;
 
-        /* Project Polygon */
+        /* Project and Index Polygon */
         List<MathLib::coord_t>::Iterator poly_iterator(info->reader->parms->polygon);
-        projected_poly = new MathLib::point_t [points_in_polygon];
+        MathLib::point_t* projected_poly = new MathLib::point_t [points_in_polygon];
         for(int i = 0; i < points_in_polygon; i++)
         {
             projected_poly[i] = MathLib::coord2point(poly_iterator[i], projection);
         }
+        poly_index = new MathLib::PolyIndex(projected_poly, points_in_polygon);
+        delete [] projected_poly;
     }
 
     try
@@ -336,10 +338,10 @@ Atl06Reader::Region::~Region (void)
  *----------------------------------------------------------------------------*/
 void Atl06Reader::Region::cleanup (void)
 {
-    if(projected_poly)
+    if(poly_index)
     {
-        delete [] projected_poly;
-        projected_poly = NULL;
+        delete poly_index;
+        poly_index = NULL;
     }
     
     if(inclusion_mask)
@@ -354,22 +356,19 @@ void Atl06Reader::Region::cleanup (void)
  *----------------------------------------------------------------------------*/
 void Atl06Reader::Region::polyregion (void)
 {
+    /* Test Inclusion of Segments */
+    MathLib::point_t* segment_points = new MathLib::point_t [latitude.size];
+    bool* segment_inclusion = new bool [latitude.size];
+    MathLib::coord2point(longitude.pointer, latitude.pointer, latitude.size, projection, segment_points);
+    MathLib::inpoly(*poly_index, segment_points, latitude.size, segment_inclusion);
+    delete [] segment_points;
+
     /* Find First Segment In Polygon */
     bool first_segment_found = false;
     int segment = 0;
     while(segment < latitude.size)
     {
-        bool inclusion = false;
-
-        /* Project Segment Coordinate */
-        MathLib::coord_t segment_coord = {longitude[segment], latitude[segment]};
-        MathLib::point_t segment_point = MathLib::coord2point(segment_coord, projection);
-
-        /* Test Inclusion */
-        if(MathLib::inpoly(projected_poly, points_in_polygon, segment_point))
-        {
-            inclusion = true;
-        }
+        bool inclusion = segment_inclusion[segment];
 
         /* Check First Segment */
         if(!first_segment_found && inclusion)
@@ -393,6 +392,9 @@ void Atl06Reader::Region::polyregion (void)
     {
         num_segments = segment - first_segment;
     }
+
+    /* Free Inclusion */
+    delete [] segment_inclusion;
 }
 
 /*----------------------------------------------------------------------------
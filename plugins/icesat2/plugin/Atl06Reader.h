@@ -177,7 +177,7 @@ class Atl06Reader: public LuaObject
                 H5Array<double>     latitude;
                 H5Array<double>     longitude;
 
-                MathLib::point_t*   projected_poly;
+                MathLib::PolyIndex* poly_index;
                 MathLib::proj_t     projection;
                 int                 points_in_polygon;
 
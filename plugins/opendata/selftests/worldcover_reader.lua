@@ -48,6 +48,29 @@ end
 runner.check(sampleCnt == #expResults, string.format("Received unexpected number of samples: %d instead of %d", sampleCnt, #expResults))
 
 
+print(string.format("\n-------------------------------------------------\nesa worldcover 10meter raster block cache\n-------------------------------------------------"))
+
+-- second sample of the same point must be served from the block cache
+local _, before = geo.rastercache()
+tbl, err = dem:sample(lon, lat, height)
+runner.check(err == 0)
+local _, after = geo.rastercache()
+print(string.format("hits: %d -> %d, misses: %d -> %d", before["cache_hit"], after["cache_hit"], before["cache_miss"], after["cache_miss"]))
+runner.check(after["cache_hit"] > before["cache_hit"], "block cache was not hit on repeated sample")
+runner.check(after["cache_miss"] == before["cache_miss"], "block cache missed on repeated sample")
+
+-- disabling the cache bypasses it without counting misses
+local cache_max = after["cache_max"]
+local _, disabled = geo.rastercache(0)
+runner.check(disabled["cache_blocks"] == 0)
+tbl, err = dem:sample(lon, lat, height)
+runner.check(err == 0)
+local _, bypassed = geo.rastercache(cache_max)
+runner.check(bypassed["cache_hit"] == disabled["cache_hit"])
+runner.check(bypassed["cache_miss"] == disabled["cache_miss"], "disabled block cache counted a miss")
+runner.check(bypassed["cache_max"] == cache_max)
+
+
 print(string.format("\n-------------------------------------------------\nesa worldcover 10meter subset AOI\n-------------------------------------------------"))
 
 expResults = {{0, 1309046418000, '/vsis3/sliderule/data/WORLDCOVER/ESA_WorldCover_10m_2021_v200_Map.vrt', 7344, 4464, 32783616,  4}}
@@ -273,13 +273,15 @@ void SwotL2Reader::Region::polyregion (SwotParms* _parms)
     if(lat[0] > 70.0) projection = MathLib::NORTH_POLAR;
     else if(lat[0] < -70.0) projection = MathLib::SOUTH_POLAR;
 
-    /* Project Polygon */
+    /* Project and Index Polygon */
     List<MathLib::coord_t>::Iterator poly_iterator(_parms->polygon);
     MathLib::point_t* projected_poly = new MathLib::point_t [points_in_polygon];
     for(int i = 0; i < points_in_polygon; i++)
     {
         projected_poly[i] = MathLib::coord2point(poly_iterator[i], projection);
     }
+    MathLib::PolyIndex poly_index(projected_poly, points_in_polygon);
+    delete [] projected_poly;
 
     /* Find First and Last Lines in Polygon */
     bool first_line_found = false;
@@ -294,7 +296,7 @@ void SwotL2Reader::Region::polyregion (SwotParms* _parms)
         MathLib::point_t line_point = MathLib::coord2point(line_coord, projection);
 
         /* Test Inclusion */
-        if(MathLib::inpoly(projected_poly, points_in_polygon, line_point))
+        if(poly_index.includes(line_point))
         {
             inclusion = true;
         }
@@ -321,9 +323,6 @@ void SwotL2Reader::Region::polyregion (SwotParms* _parms)
     {
         num_lines = (line - 1) - first_line;
     }
-
-    /* Delete Projected Polygon */
-    delete [] projected_poly;
 }
 
 /*----------------------------------------------------------------------------
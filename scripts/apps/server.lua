@@ -32,7 +32,11 @@ local register_as_service       = cfgtbl["register_as_service"] -- nil is false
 local asset_directory           = cfgtbl["asset_directory"]
 local normal_mem_thresh         = cfgtbl["normal_mem_thresh"] or 1.0
 local stream_mem_thresh         = cfgtbl["stream_mem_thresh"] or 0.75
+local max_active_requests       = cfgtbl["max_active_requests"] or 0 -- 0 is unlimited
+local max_queued_requests       = cfgtbl["max_queued_requests"] or 1024
+local stream_compression        = cfgtbl["stream_compression"] or false -- nil is false
 local msgq_depth                = cfgtbl["msgq_depth"] or 10000
+local s3_readahead              = cfgtbl["s3_readahead"] or 0 -- 0 is disabled
 local environment_version       = cfgtbl["environment_version"] or os.getenv("ENVIRONMENT_VERSION") or "unknown"
 local orchestrator_url          = cfgtbl["orchestrator"] or os.getenv("ORCHESTRATOR")
 local org_name                  = cfgtbl["cluster"] or os.getenv("CLUSTER")
@@ -59,6 +63,11 @@ dispatcher:attach(log_monitor, "eventrec")
 dispatcher:attach(metric_monitor, "eventrec")
 dispatcher:run()
 
+-- Configure S3 Readahead (only benefits sequential readers) --
+if s3_readahead > 0 then
+    aws.s3readahead(s3_readahead)
+end
+
 -- Configure Assets --
 local assets = asset.loaddir(asset_directory)
 
@@ -89,6 +98,10 @@ end
 
 -- Configure Application Endpoints --
 local source_endpoint = core.endpoint(normal_mem_thresh, stream_mem_thresh):name("SourceEndpoint")
+source_endpoint:admission(max_active_requests, max_queued_requests)
+for _,resource in ipairs({"health", "version", "definition", "time", "prometheus"}) do
+    source_endpoint:priority(resource, 1) -- health and metadata requests are not held behind processing requests
+end
 
 -- Configure Provisioning System Authentication --
 netsvc.psurl(ps_url)
@@ -100,6 +113,7 @@ end
 
 -- Run Application HTTP Server --
 local app_server = core.httpd(app_port):name("AppServer")
+app_server:compression(stream_compression)
 app_server:attach(source_endpoint, "/source")
 
 --------------------------------------------------
@@ -0,0 +1,91 @@
+local runner = require("test_executive")
+local console = require("console")
+local td = runner.rootdir(arg[0])
+
+-- Setup --
+
+local cache_root = "blockcache.test"
+runner.check(core.blockcache("file", cache_root, 0x10000, 0x400), "failed to create block cache")
+
+asset = core.asset("local", "nil", "file", td, "empty.index")
+
+-- Unit Test --
+
+local hits = {}
+
+for pass=1,2 do
+
+    print(string.format('\n------------------\nTest0%d: Read Dataset through Block Cache\n------------------', pass))
+
+    dataq = "dataq"
+    rsps = msg.subscribe(dataq)
+
+    f = h5.dataset(core.READER, asset, "h5ex_d_gzip.h5", "/DS1", 0, true, core.INTEGER, 2, 0, core.ALL_ROWS)
+    r = core.reader(f, dataq)
+
+    vals = rsps:recvstring(3000)
+    e1, e2, e3, e4 = string.unpack('iiii', vals)
+
+    runner.check(-2 == e1, "failed dataset read")
+    runner.check( 0 == e2, "failed dataset read")
+    runner.check( 2 == e3, "failed dataset read")
+    runner.check( 4 == e4, "failed dataset read")
+
+    rsps:destroy()
+    r:destroy()
+
+    hits[pass] = core.blockstats()["hit"]
+
+end
+
+print('\n------------------\nTest03: Second Read Served from Block Cache\n------------------')
+
+runner.check(hits[2] > hits[1], string.format("no block cache hits on second read: %d, %d", hits[1], hits[2]))
+
+print('\n------------------\nTest04: Changed Resource Not Served from Block Cache\n------------------')
+
+local function copyfile(src, dst)
+    local fin = assert(io.open(src, "rb"))
+    local contents = fin:read("a")
+    fin:close()
+    local fout = assert(io.open(dst, "wb"))
+    fout:write(contents)
+    fout:close()
+end
+
+changed = core.asset("changed", "nil", "file", cache_root, "empty.index")
+
+local function readchanged()
+    local changedq = "changedq"
+    local changedrsps = msg.subscribe(changedq)
+    local changedf = h5.dataset(core.READER, changed, "changed.h5", "/DS1", 0, true, core.INTEGER, 2, 0, core.ALL_ROWS)
+    local changedr = core.reader(changedf, changedq)
+    local changedvals = changedrsps:recvstring(3000)
+    runner.check(changedvals ~= nil and -2 == string.unpack('i', changedvals), "failed dataset read")
+    changedrsps:destroy()
+    changedr:destroy()
+    return core.blockstats()["miss"]
+end
+
+copyfile(td .. "h5ex_d_gzip.h5", cache_root .. "/changed.h5")
+readchanged()
+local misses_before = readchanged()
+sys.wait(1) -- modification time of the rewritten file differs
+copyfile(td .. "h5ex_d_gzip.h5", cache_root .. "/changed.h5")
+local misses_after = readchanged()
+
+runner.check(misses_after > misses_before, string.format("stale blocks served after resource changed: %d, %d", misses_before, misses_after))
+
+-- Clean Up --
+
+runner.check(core.blockuncache("file"), "failed to restore file driver")
+
+os.remove(cache_root .. "/blockcache.idx")
+os.remove(cache_root .. "/blockcache.dat")
+os.remove(cache_root .. "/changed.h5")
+os.remove(cache_root)
+
+-- Report Results --
+
+runner.report()
+
@@ -0,0 +1,73 @@
+local runner = require("test_executive")
+local console = require("console")
+
+-- console.monitor:config(core.LOG, core.DEBUG)
+-- sys.setlvl(core.LOG, core.DEBUG)
+
+-- Setup --
+
+local num_msgs = 20
+local pkts_per_msg = 10
+local batch_size = 16 -- smaller than a message so batches fill before the end of a message
+local num_pkts = num_msgs * pkts_per_msg
+
+cmd.exec("CCSDS::DEFINE_TELEMETRY ut_batch.tlm NULL 0x3F1 16 4")
+cmd.exec("ADD_FIELD ut_batch.tlm days UINT16 6 1 BE")
+cmd.exec("ADD_FIELD ut_batch.tlm ms UINT32 8 1 BE")
+cmd.exec("ADD_FIELD ut_batch.tlm counter UINT32 12 1 BE")
+
+-- every packet violates the limit, so each one dispatched produces a limit record
+local limitq = msg.subscribe("ut_batch_limitq")
+local limit = core.limit("counter", nil, nil, 0, nil, "ut_batch_limitq")
+local dispatcher = ccsds.dispatcher("ut_batch_scidataq", 1, "RECEIPT_KEY", nil, true)
+dispatcher:attach(limit, "ut_batch.tlm"):run()
+local interleaver = ccsds.interleaver({"ut_batch_pktq"}, "ut_batch_scidataq", batch_size)
+local parser = ccsds.parser(ccsds.pktmod(), ccsds.SPACE, "ut_batch_rawq", "ut_batch_pktq", nil, batch_size)
+
+-- Unit Test --
+
+print('\n------------------\nTest01: Batch Size Limits\n------------------')
+runner.check(ccsds.MAX_BATCH > batch_size)
+runner.check(ccsds.parser(ccsds.pktmod(), ccsds.SPACE, "ut_batch_badq", nil, nil, ccsds.MAX_BATCH + 1) == nil, "parser accepted oversized batch")
+runner.check(ccsds.interleaver({"ut_batch_badq"}, "ut_batch_badoutq", ccsds.MAX_BATCH + 1) == nil, "interleaver accepted oversized batch")
+
+print('\n------------------\nTest02: Round Trip\n------------------')
+
+-- a message that is not a batch is dropped by the interleaver
+local pktq = msg.publish("ut_batch_pktq")
+pktq:sendstring("BOGUS_BATCH_MESSAGE")
+
+-- post raw packets, several per message
+local rawq = msg.publish("ut_batch_rawq")
+local counter = 0
+for m=1,num_msgs do
+    local raw = ""
+    for p=1,pkts_per_msg do
+        counter = counter + 1
+        local tlm = msg.create(string.format("/ut_batch.tlm days=1 ms=%d counter=%d", counter, counter))
+        raw = raw .. tlm:serialize()
+    end
+    runner.check(rawq:sendstring(raw))
+end
+
+-- every packet is dispatched once and in order
+local received = 0
+local in_order = true
+for i=1,num_pkts do
+    local violation = limitq:recvrecord(3000)
+    if violation == nil then
+        runner.check(false, string.format("timeout after receiving %d of %d packets", received, num_pkts))
+        break
+    end
+    received = received + 1
+    if violation:getvalue("D_VAL") ~= i then
+        in_order = false
+    end
+end
+runner.check(received == num_pkts, string.format("received %d of %d packets", received, num_pkts))
+runner.check(in_order, "packets received out of order")
+
+-- Report Results --
+
+runner.report()
+
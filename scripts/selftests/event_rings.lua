@@ -0,0 +1,16 @@
+local runner = require("test_executive")
+local console = require("console")
+
+--console.monitor:config(core.LOG, core.DEBUG)
+--sys.setlvl(core.LOG, core.DEBUG)
+
+-- EventLib Unit Test --
+
+runner.command("NEW UT_EVENTLIB ut_eventlib")
+runner.command("ut_eventlib::RINGS " .. core.EVENTQ)
+runner.command("DELETE ut_eventlib")
+
+-- Report Results --
+
+runner.report()
+
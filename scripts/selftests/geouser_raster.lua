@@ -68,6 +68,23 @@ local cellsize = robj:cell()
 print(string.format("cellsize: %f", cellsize))
 runner.check(math.abs(0.000083 - cellsize) < 0.000001)
 
+print('\n------------------\nTest05: raster block cache\n------------------')
+local status, stats = geo.rastercache()
+runner.check(status)
+runner.check(stats ~= nil)
+if stats ~= nil then
+    print(string.format("hits: %d, misses: %d, blocks: %d, bytes: %d", stats["cache_hit"], stats["cache_miss"], stats["cache_blocks"], stats["cache_bytes"]))
+    runner.check(stats["cache_max"] > 0)
+    runner.check(stats["cache_bytes"] <= stats["cache_max"])
+
+    -- in memory rasters bypass the block cache (see worldcover_reader.lua for a file backed raster)
+    tbl, err = robj:sample(lon, lat, height)
+    runner.check(err == 0)
+    local _, after = geo.rastercache()
+    runner.check(after["cache_hit"] == stats["cache_hit"])
+    runner.check(after["cache_miss"] == stats["cache_miss"])
+end
+
 -- Clean Up --
 
 -- Report Results --
@@ -0,0 +1,32 @@
+local runner = require("test_executive")
+local console = require("console")
+
+-- Setup --
+
+ut_h5coro = h5.ut_h5coro()
+
+-- Unit Test --
+
+print('\n------------------\nTest01: Shuffle Implementations\n------------------')
+runner.check(ut_h5coro:shuffletest(), "Failed shuffletest")
+
+print('\n------------------\nTest02: Shuffle Benchmark\n------------------')
+for _,type_size in ipairs({2, 4, 8}) do
+    for _,chunk_size in ipairs({0x10000, 0x100000}) do
+        local results = ut_h5coro:shufflebench(type_size, chunk_size, 100)
+        runner.check(results ~= nil, "Failed shufflebench")
+        if results then
+            for impl,gbps in pairs(results) do
+                print(string.format("type size %d, chunk size %d, %s: %.2f GB/s", type_size, chunk_size, impl, gbps))
+            end
+        end
+    end
+end
+
+-- Clean Up --
+
+ut_h5coro:destroy()
+
+-- Report Results --
+
+runner.report()
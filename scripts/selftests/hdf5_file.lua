@@ -90,6 +90,26 @@ end
 f:close()
 os.remove(h5_file)
 
+print('\n------------------\nTest05: Read Dataset from Mapped File\n------------------')
+
+mmap_asset = core.asset("mapped", "nil", "mmap", td, "empty.index")
+
+rsps5 = msg.subscribe(dataq)
+
+f5 = h5.dataset(core.READER, mmap_asset, "h5ex_d_gzip.h5", "/DS1", 0, true, core.INTEGER, 2, 0, core.ALL_ROWS)
+r5 = core.reader(f5, dataq)
+
+vals = rsps5:recvstring(3000)
+e1, e2, e3, e4 = string.unpack('iiii', vals)
+
+runner.check(-2 == e1, "failed mapped dataset read")
+runner.check( 0 == e2, "failed mapped dataset read")
+runner.check( 2 == e3, "failed mapped dataset read")
+runner.check( 4 == e4, "failed mapped dataset read")
+
+rsps5:destroy()
+r5:destroy()
+
 -- Report Results --
 
 runner.report()
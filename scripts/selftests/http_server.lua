@@ -39,6 +39,32 @@ result = f:read()
 f:close()
 runner.check(result == "{ \"result\": \"Hello World\" }")
 
+print('\n------------------\nTest03: Compressed Stream\n------------------')
+local hdrfile = os.tmpname()
+local zipfile = os.tmpname()
+zserver = core.httpd(9082):attach(endpoint, "/source"):untilup()
+runner.check(zserver:compression(true))
+
+os.execute(string.format("curl -sS -X POST -d '%s' http://127.0.0.1:9082/source/example_engine_endpoint > %s", json_object, tmpfile))
+os.execute(string.format("curl -sS --compressed -H 'Accept-Encoding: gzip' -D %s -X POST -d '%s' http://127.0.0.1:9082/source/example_engine_endpoint > %s", hdrfile, json_object, zipfile))
+f = io.open(tmpfile)
+local plain = f:read("*a")
+f:close()
+f = io.open(zipfile)
+local unzipped = f:read("*a")
+f:close()
+f = io.open(hdrfile)
+local headers = string.lower(f:read("*a"))
+f:close()
+runner.check(string.len(plain) > 0, "empty uncompressed response")
+runner.check(unzipped == plain, "decompressed response does not match uncompressed response")
+runner.check(string.find(headers, "content-encoding: gzip", 1, true) ~= nil, "missing gzip content encoding: "..headers)
+runner.check(string.find(headers, "vary: accept-encoding", 1, true) ~= nil, "missing vary header: "..headers)
+
+zserver:destroy()
+os.remove(hdrfile)
+os.remove(zipfile)
+
 -- Clean Up --
 
 server:destroy()
@@ -0,0 +1,17 @@
+local runner = require("test_executive")
+local console = require("console")
+
+--console.monitor:config(core.LOG, core.DEBUG)
+--sys.setlvl(core.LOG, core.DEBUG)
+
+-- LuaEngine Unit Test --
+
+runner.command("NEW UT_LUAENGINE ut_luaengine")
+runner.command("ut_luaengine::RECYCLE /tmp/ut_luaengine_recycle.lua")
+runner.command("ut_luaengine::CHUNKCACHE /tmp/ut_luaengine_chunkcache.lua")
+runner.command("DELETE ut_luaengine")
+
+-- Report Results --
+
+runner.report()
+
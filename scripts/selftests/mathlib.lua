@@ -0,0 +1,16 @@
+local runner = require("test_executive")
+local console = require("console")
+
+--console.monitor:config(core.LOG, core.DEBUG)
+--sys.setlvl(core.LOG, core.DEBUG)
+
+-- MathLib Unit Test --
+
+runner.command("NEW UT_MATHLIB ut_mathlib")
+runner.command("ut_mathlib::INPOLY")
+runner.command("DELETE ut_mathlib")
+
+-- Report Results --
+
+runner.report()
+
@@ -0,0 +1,16 @@
+local runner = require("test_executive")
+local console = require("console")
+
+--console.monitor:config(core.LOG, core.DEBUG)
+--sys.setlvl(core.LOG, core.DEBUG)
+
+-- Record Object Unit Test --
+
+runner.command("NEW UT_RECORDOBJECT ut_record")
+runner.command("ut_record::COLUMN")
+runner.command("DELETE ut_record")
+
+-- Report Results --
+
+runner.report()
+
@@ -26,6 +26,8 @@ end
 -- Run H5 Self Tests --
 if __h5__ then
     runner.script(td .. "hdf5_file.lua")
+    runner.script(td .. "h5coro_shuffle.lua")
+    runner.script(td .. "block_cache.lua")
 end
 
 -- Run Pistache Self Tests --
@@ -43,12 +45,17 @@ end
 if __legacy__ then
     runner.script(td .. "message_queue.lua")
     runner.script(td .. "list.lua")
+    runner.script(td .. "lua_engine.lua")
+    runner.script(td .. "mathlib.lua")
     runner.script(td .. "ordering.lua")
+    runner.script(td .. "record_object.lua")
     runner.script(td .. "dictionary.lua")
+    runner.script(td .. "event_rings.lua")
     runner.script(td .. "table.lua")
     runner.script(td .. "timelib.lua")
     runner.script(td .. "ccsds_packetizer.lua")
     runner.script(td .. "cfs_interface.lua")
+    runner.script(td .. "ccsds_batch.lua")
     runner.script(td .. "record_dispatcher.lua")
     runner.script(td .. "limit_dispatch.lua")
 end